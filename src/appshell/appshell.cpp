@@ -302,11 +302,20 @@ int AppShell::processConverter(const CommandLineController::ConverterTask& task)
         ret = converter()->convertScoreParts(task.inputFile, task.outputFile, stylePath);
         break;
     case CommandLineController::ConvertType::File:
-        ret = converter()->fileConvert(task.inputFile, task.outputFile, stylePath, forceMode);
+        if (task.params.contains(CommandLineController::ParamKey::OutputFiles)) {
+            io::paths_t outputFiles;
+            for (const QString& file : task.params[CommandLineController::ParamKey::OutputFiles].toStringList()) {
+                outputFiles.push_back(file);
+            }
+            ret = converter()->fileConvert(task.inputFile, outputFiles, stylePath, forceMode);
+        } else {
+            ret = converter()->fileConvert(task.inputFile, task.outputFile, stylePath, forceMode);
+        }
         break;
     case CommandLineController::ConvertType::ExportScoreMedia: {
         io::path_t highlightConfigPath = task.params[CommandLineController::ParamKey::HighlightConfigPath].toString();
-        ret = converter()->exportScoreMedia(task.inputFile, task.outputFile, highlightConfigPath, stylePath, forceMode);
+        bool concurrentMode = task.params[CommandLineController::ParamKey::ConcurrentExport].toBool();
+        ret = converter()->exportScoreMedia(task.inputFile, task.outputFile, highlightConfigPath, stylePath, forceMode, concurrentMode);
     } break;
     case CommandLineController::ConvertType::ExportScoreMeta:
         ret = converter()->exportScoreMeta(task.inputFile, task.outputFile, stylePath, forceMode);
@@ -328,6 +337,10 @@ int AppShell::processConverter(const CommandLineController::ConverterTask& task)
         std::string scoreSource = task.params[CommandLineController::ParamKey::ScoreSource].toString().toStdString();
         ret = converter()->updateSource(task.inputFile, scoreSource, forceMode);
     } break;
+    case CommandLineController::ConvertType::ConverterServer: {
+        QVariant maxPendingJobs = task.params.value(CommandLineController::ParamKey::ServerMaxPendingJobs, 4);
+        ret = converter()->runServer(stylePath, forceMode, static_cast<size_t>(std::max(1, maxPendingJobs.toInt())));
+    } break;
     }
 
     if (!ret) {
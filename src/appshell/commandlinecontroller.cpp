@@ -45,6 +45,9 @@ void CommandLineController::parse(const QStringList& args)
                                           "margin"));
 
     m_parser.addOption(QCommandLineOption({ "b", "bitrate" }, "Use with '-o <file>.mp3', sets bitrate, in kbps", "bitrate"));
+    m_parser.addOption(QCommandLineOption("audio-stems",
+                                          "Use with '-o <file>.wav|mp3|ogg|flac', also writes every instrument into "
+                                          "'<file>-<instrument>', in the same pass as the mix"));
 
     m_parser.addOption(QCommandLineOption("template-mode", "Save template mode, no page size")); // and no platform and creationDate tags
     m_parser.addOption(QCommandLineOption({ "t", "test-mode" }, "Set test mode flag for all files")); // this includes --template-mode
@@ -53,8 +56,12 @@ void CommandLineController::parse(const QStringList& args)
 
     // Converter mode
     m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
+    m_parser.addOption(QCommandLineOption("image-export-threads",
+                                          "Set number of threads used to encode the pages of an image export, 0 means the number of cores",
+                                          "count"));
     m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
-    m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
+    m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension. "
+                                                                "Can be given several times, the audio files are rendered only once then", "file"));
     m_parser.addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
     m_parser.addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
     m_parser.addOption(QCommandLineOption({ "M", "midi-operations" }, "Specify MIDI import operations file", "file"));
@@ -65,6 +72,8 @@ void CommandLineController::parse(const QStringList& args)
     m_parser.addOption(QCommandLineOption("score-media",
                                           "Export all media (excepting mp3) for a given score in a single JSON file and print it to stdout"));
     m_parser.addOption(QCommandLineOption("highlight-config", "Set highlight to svg, generated from a given score", "highlight-config"));
+    m_parser.addOption(QCommandLineOption("concurrent-export",
+                                          "Use with '--score-media', base64 encode and write out the artifacts on a worker thread while the next ones are made, and report time per artifact"));
     m_parser.addOption(QCommandLineOption("score-meta", "Export score metadata to JSON document and print it to stdout"));
     m_parser.addOption(QCommandLineOption("score-parts", "Generate parts data for the given score and save them to separate mscz files"));
     m_parser.addOption(QCommandLineOption("score-parts-pdf",
@@ -73,6 +82,11 @@ void CommandLineController::parse(const QStringList& args)
                                           "Transpose the given score and export the data to a single JSON file, print it to stdout",
                                           "options"));
     m_parser.addOption(QCommandLineOption("source-update", "Update the source in the given score"));
+    m_parser.addOption(QCommandLineOption("converter-server",
+                                          "Keep running and process conversion jobs read from stdin as JSON lines, one result line per job"));
+    m_parser.addOption(QCommandLineOption("converter-server-queue",
+                                          "Use with '--converter-server', max number of jobs read ahead of the one being converted",
+                                          "count"));
 
     m_parser.addOption(QCommandLineOption({ "S", "style" }, "Load style file", "style"));
 
@@ -167,6 +181,10 @@ void CommandLineController::apply()
         }
     }
 
+    if (m_parser.isSet("audio-stems")) {
+        audioExportConfiguration()->setExportStems(true);
+    }
+
     notationConfiguration()->setTemplateModeEnabled(m_parser.isSet("template-mode"));
     notationConfiguration()->setTestModeEnabled(m_parser.isSet("t"));
 
@@ -185,6 +203,15 @@ void CommandLineController::apply()
         }
     }
 
+    if (m_parser.isSet("image-export-threads")) {
+        std::optional<int> val = intValue("image-export-threads");
+        if (val) {
+            imagesExportConfiguration()->setExportImageThreadCount(val);
+        } else {
+            LOGE() << "Option: --image-export-threads not recognized value: " << m_parser.value("image-export-threads");
+        }
+    }
+
     if (m_parser.isSet("o")) {
         application()->setRunMode(IApplication::RunMode::Converter);
         m_converterTask.type = ConvertType::File;
@@ -196,6 +223,11 @@ void CommandLineController::apply()
             }
             m_converterTask.inputFile = scorefiles[0];
             m_converterTask.outputFile = m_parser.value("o");
+
+            QStringList outputFiles = m_parser.values("o");
+            if (outputFiles.size() > 1) {
+                m_converterTask.params[CommandLineController::ParamKey::OutputFiles] = outputFiles;
+            }
         }
     }
 
@@ -220,6 +252,9 @@ void CommandLineController::apply()
         if (m_parser.isSet("highlight-config")) {
             m_converterTask.params[CommandLineController::ParamKey::HighlightConfigPath] = m_parser.value("highlight-config");
         }
+        if (m_parser.isSet("concurrent-export")) {
+            m_converterTask.params[CommandLineController::ParamKey::ConcurrentExport] = true;
+        }
     }
 
     if (m_parser.isSet("score-meta")) {
@@ -261,6 +296,14 @@ void CommandLineController::apply()
         }
     }
 
+    if (m_parser.isSet("converter-server")) {
+        application()->setRunMode(IApplication::RunMode::Converter);
+        m_converterTask.type = ConvertType::ConverterServer;
+        if (m_parser.isSet("converter-server-queue")) {
+            m_converterTask.params[CommandLineController::ParamKey::ServerMaxPendingJobs] = m_parser.value("converter-server-queue").toInt();
+        }
+    }
+
     // Video
 #ifdef BUILD_VIDEOEXPORT_MODULE
     if (m_parser.isSet("score-video")) {
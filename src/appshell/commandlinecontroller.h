@@ -66,7 +66,8 @@ public:
         ExportScorePartsPdf,
         ExportScoreTranspose,
         SourceUpdate,
-        ExportScoreVideo
+        ExportScoreVideo,
+        ConverterServer
     };
 
     enum class ParamKey {
@@ -75,6 +76,9 @@ public:
         ScoreSource,
         ScoreTransposeOptions,
         ForceMode,
+        ConcurrentExport,
+        ServerMaxPendingJobs,
+        OutputFiles,
 
         // Video
     };
@@ -346,6 +346,7 @@ MenuItem* AppMenuModel::makeDiagnosticMenu()
     MenuItemList systemItems {
         makeMenuItem("diagnostic-show-paths"),
         makeMenuItem("diagnostic-show-profiler"),
+        makeMenuItem("diagnostic-midi-input-latency-dump"),
     };
 
     MenuItemList accessibilityItems {
@@ -356,6 +357,7 @@ MenuItem* AppMenuModel::makeDiagnosticMenu()
 
     MenuItemList engravingItems {
         makeMenuItem("diagnostic-show-engraving-elements"),
+        makeMenuItem("diagnostic-text-layout-cache-dump"),
         makeSeparator(),
         makeMenuItem("show-skylines"),
         makeMenuItem("show-segment-shapes"),
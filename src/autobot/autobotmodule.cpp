@@ -125,6 +125,7 @@ void AutobotModule::onInit(const framework::IApplication::RunMode&)
         pr->reg("autobotDataPath", s_configuration->dataPath());
         pr->reg("autobotSavingFilesPath", s_configuration->savingFilesPath());
         pr->reg("autobotReportsPath", s_configuration->reportsPath());
+        pr->reg("autobotPerfBaselinesPath", s_configuration->perfBaselinesPath());
         pr->reg("autobotDrawDataPath", s_configuration->drawDataPath());
     }
 }
@@ -22,6 +22,7 @@
 #ifndef MU_AUTOBOT_ABTYPES_H
 #define MU_AUTOBOT_ABTYPES_H
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <QJSValue>
@@ -100,6 +101,16 @@ private:
     QJSValue val;
 };
 
+//! NOTE A test case with the `perf` property runs in the performance mode:
+//! `perf: { runs: 5, tolerance: 10, saveBaseline: false }` - number of runs, allowed slowdown against
+//! the baseline in percent, and whether to save the report as the new baseline
+struct PerfOptions
+{
+    int runs = 1;
+    double tolerancePercent = 10.0;
+    bool saveBaseline = false;
+};
+
 struct TestCase
 {
     TestCase(const QJSValue& jsval = QJSValue())
@@ -111,6 +122,21 @@ struct TestCase
     QString description() const { return val.property("description").toString(); }
     Steps steps() const { return Steps(val.property("steps")); }
 
+    bool isPerf() const { return val.hasProperty("perf"); }
+    PerfOptions perfOptions() const
+    {
+        PerfOptions opt;
+        QJSValue perf = val.property("perf");
+        if (perf.hasProperty("runs")) {
+            opt.runs = std::max(perf.property("runs").toInt(), 1);
+        }
+        if (perf.hasProperty("tolerance")) {
+            opt.tolerancePercent = perf.property("tolerance").toNumber();
+        }
+        opt.saveBaseline = perf.property("saveBaseline").toBool();
+        return opt;
+    }
+
 private:
     QJSValue val;
 };
@@ -130,12 +156,13 @@ struct StepInfo
     QString name;
     StepStatus status;
     int durationMsec = 0;
+    int64_t durationUsec = 0;
 
     StepInfo() = default;
     StepInfo(const QString& n, StepStatus s)
         : name(n), status(s) {}
-    StepInfo(const QString& n, StepStatus s, int dur)
-        : name(n), status(s), durationMsec(dur) {}
+    StepInfo(const QString& n, StepStatus s, int64_t durUsec)
+        : name(n), status(s), durationMsec(static_cast<int>(durUsec / 1000)), durationUsec(durUsec) {}
 };
 
 enum class SpeedMode {
@@ -0,0 +1,53 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+function main()
+{
+    var testCase = {
+        name: "Perf Zoom",
+        description: "Performance mode: open a score and zoom it, repeated 5 times",
+        perf: { runs: 5, tolerance: 10 },
+        steps: [
+            {name: "Open", func: function() {
+                api.autobot.openProject("simple1.mscz")
+            }},
+            {name: "Zoom", func: function() {
+                api.autobot.beginTiming("zoom in")
+                api.dispatcher.dispatch("zoom-x-percent", [200])
+                api.autobot.endTiming("zoom in")
+                api.autobot.seeChanges()
+
+                api.autobot.beginTiming("zoom out")
+                api.dispatcher.dispatch("zoom-x-percent", [50])
+                api.autobot.endTiming("zoom out")
+                api.autobot.seeChanges()
+            }},
+            {name: "Close", func: function() {
+                api.dispatcher.dispatch("file-close")
+            }}
+        ]
+    };
+
+    api.autobot.setInterval(500)
+    api.autobot.runTestCase(testCase)
+    api.log.info("----------- end script ---------------")
+}
@@ -81,6 +81,10 @@ public:
     virtual void abort() = 0;
     virtual void fatal(const QString& msg) = 0;
 
+    //! NOTE Timing scopes of the performance mode, do nothing if a test case runs in the normal mode
+    virtual void beginTiming(const QString& name) = 0;
+    virtual void endTiming(const QString& name) = 0;
+
     virtual ITestCaseContextPtr context() const = 0;
     virtual AutobotInteractivePtr autobotInteractive() const = 0;
 };
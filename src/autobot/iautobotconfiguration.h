@@ -38,6 +38,7 @@ public:
     virtual io::path_t dataPath() const = 0;
     virtual io::path_t savingFilesPath() const = 0;
     virtual io::path_t reportsPath() const = 0;
+    virtual io::path_t perfBaselinesPath() const = 0;
     virtual io::path_t drawDataPath() const = 0;
     virtual io::path_t fileDrawDataPath(const io::path_t& filePath) const = 0;
 };
@@ -29,6 +29,7 @@
 
 #include "async/async.h"
 #include "io/fileinfo.h"
+#include "autobot/internal/perfreport.h"
 
 #include "log.h"
 
@@ -137,6 +138,31 @@ void AutobotApi::saveProject(const QString& name)
     projectFilesController()->saveProject(filePath);
 }
 
+void AutobotApi::beginTiming(const QString& name)
+{
+    autobot()->beginTiming(name);
+}
+
+void AutobotApi::endTiming(const QString& name)
+{
+    autobot()->endTiming(name);
+}
+
+bool AutobotApi::comparePerfReports(const QString& reportPath, const QString& baselinePath, double tolerancePercent)
+{
+    PerfReport report;
+    RetVal<std::vector<PerfReport::MetricDiff> > diffs = report.compare(reportPath, baselinePath, tolerancePercent);
+    for (const PerfReport::MetricDiff& diff : diffs.val) {
+        LOGI() << (diff.regressed ? "regressed: " : "") << diff.metric << " " << diff.stat << ": "
+               << diff.baseline << " -> " << diff.current << " msec (" << diff.changePercent << "%)";
+    }
+
+    if (!diffs.ret) {
+        LOGE() << diffs.ret.toString();
+    }
+    return diffs.ret;
+}
+
 void AutobotApi::sleep(int msec)
 {
     if (msec < 0) {
@@ -61,6 +61,11 @@ public:
     Q_INVOKABLE bool openProject(const QString& name);
     Q_INVOKABLE void saveProject(const QString& name = QString());
 
+    // Performance
+    Q_INVOKABLE void beginTiming(const QString& name);
+    Q_INVOKABLE void endTiming(const QString& name);
+    Q_INVOKABLE bool comparePerfReports(const QString& reportPath, const QString& baselinePath, double tolerancePercent = 10.0);
+
     // Helpers
     Q_INVOKABLE void sleep(int msec = -1);
     Q_INVOKABLE void waitPopup();
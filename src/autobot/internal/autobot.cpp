@@ -37,6 +37,8 @@ void Autobot::init()
     m_runner.stepStatusChanged().onReceive(this, [this](const StepInfo& stepInfo, const Ret& ret) {
         if (stepInfo.status == StepStatus::Started) {
             m_context->addStep(stepInfo.name);
+        } else if (stepInfo.status == StepStatus::Finished && m_perf.isCollecting()) {
+            m_perf.addStepLatency(stepInfo.name, stepInfo.durationUsec);
         }
 
         m_report.onStepStatusChanged(stepInfo, m_context);
@@ -50,7 +52,10 @@ void Autobot::init()
     });
 
     m_runner.allFinished().onReceive(this, [this](bool aborted) {
-        m_report.endReport(aborted);
+        //! NOTE In the performance mode the report covers all runs
+        if (!m_perf.isCollecting()) {
+            m_report.endReport(aborted);
+        }
     });
 
     setStatus(Status::Undefined);
@@ -182,9 +187,96 @@ int Autobot::intervalMsec() const
 void Autobot::runTestCase(const TestCase& testCase)
 {
     m_report.beginReport(testCase);
+
+    if (testCase.isPerf()) {
+        runPerfTestCase(testCase);
+        return;
+    }
+
     m_runner.run(testCase);
 }
 
+void Autobot::runPerfTestCase(const TestCase& testCase)
+{
+    PerfOptions opt = testCase.perfOptions();
+
+    m_perf.begin(testCase.name());
+    for (int run = 0; run < opt.runs; ++run) {
+        LOGI() << "perf run: " << (run + 1) << "/" << opt.runs;
+        m_perf.beginRun(run);
+        m_runner.run(testCase);
+        m_perf.endRun();
+
+        //! NOTE Aborted or failed
+        if (status() != Status::Running) {
+            break;
+        }
+    }
+    m_perf.end();
+
+    bool aborted = status() != Status::Running;
+    m_report.endReport(aborted);
+    if (aborted) {
+        return;
+    }
+
+    RetVal<io::path_t> reportPath = m_perfReport.write(m_perf.data());
+    if (!reportPath.ret) {
+        LOGE() << "failed write perf report, err: " << reportPath.ret.toString();
+        return;
+    }
+
+    LOGI() << "perf report: " << reportPath.val;
+
+    if (opt.saveBaseline) {
+        io::path_t baselinesPath = configuration()->perfBaselinesPath();
+        fileSystem()->makePath(baselinesPath);
+        Ret ret = fileSystem()->copy(reportPath.val, baselinesPath + "/" + testCase.name() + ".perf.json", true);
+        if (!ret) {
+            LOGE() << "failed save perf baseline, err: " << ret.toString();
+        }
+        return;
+    }
+
+    comparePerfWithBaseline(testCase, reportPath.val);
+}
+
+void Autobot::comparePerfWithBaseline(const TestCase& testCase, const io::path_t& reportPath)
+{
+    io::path_t baselinePath = configuration()->perfBaselinesPath() + "/" + testCase.name() + ".perf.json";
+    if (!fileSystem()->exists(baselinePath)) {
+        LOGI() << "no perf baseline: " << baselinePath;
+        return;
+    }
+
+    RetVal<std::vector<PerfReport::MetricDiff> > diffs = m_perfReport.compare(reportPath, baselinePath,
+                                                                             testCase.perfOptions().tolerancePercent);
+    for (const PerfReport::MetricDiff& diff : diffs.val) {
+        if (diff.regressed) {
+            LOGE() << "regressed: " << diff.metric << " " << diff.stat << ": " << diff.baseline << " -> " << diff.current
+                   << " msec (" << diff.changePercent << "%)";
+        }
+    }
+
+    io::path_t comparisonPath = io::path_t(reportPath.toQString().replace(".perf.json", ".compare.json"));
+    m_perfReport.writeComparison(comparisonPath, diffs.val);
+
+    if (!diffs.ret) {
+        LOGE() << diffs.ret.toString();
+        setStatus(Status::Error);
+    }
+}
+
+void Autobot::beginTiming(const QString& name)
+{
+    m_perf.beginScope(name);
+}
+
+void Autobot::endTiming(const QString& name)
+{
+    m_perf.endScope(name);
+}
+
 void Autobot::abort()
 {
     fatal("abort");
@@ -39,6 +39,8 @@
 #include "testcasecontext.h"
 #include "testcaserunner.h"
 #include "testcasereport.h"
+#include "perfcollector.h"
+#include "perfreport.h"
 #include "autobotinteractive.h"
 
 namespace mu::autobot {
@@ -75,6 +77,9 @@ public:
     void abort() override;
     void fatal(const QString& msg) override;
 
+    void beginTiming(const QString& name) override;
+    void endTiming(const QString& name) override;
+
     ITestCaseContextPtr context() const override;
     AutobotInteractivePtr autobotInteractive() const override;
 
@@ -85,6 +90,9 @@ private:
 
     void setStatus(Status st);
 
+    void runPerfTestCase(const TestCase& testCase);
+    void comparePerfWithBaseline(const TestCase& testCase, const io::path_t& reportPath);
+
     Status m_status = Status::Undefined;
     async::Channel<io::path_t, Status> m_statusChanged;
     async::Channel<StepInfo, Ret> m_stepStatusChanged;
@@ -92,6 +100,8 @@ private:
     ITestCaseContextPtr m_context = nullptr;
     TestCaseRunner m_runner;
     TestCaseReport m_report;
+    PerfCollector m_perf;
+    PerfReport m_perfReport;
     AutobotInteractivePtr m_autobotInteractive = nullptr;
 
     QEventLoop m_sleepLoop;
@@ -75,6 +75,11 @@ mu::io::path_t AutobotConfiguration::reportsPath() const
     return dataPath() + "/reports";
 }
 
+mu::io::path_t AutobotConfiguration::perfBaselinesPath() const
+{
+    return dataPath() + "/perf_baselines";
+}
+
 mu::io::path_t AutobotConfiguration::drawDataPath() const
 {
     return dataPath() + "/draw_data";
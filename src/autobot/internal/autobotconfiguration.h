@@ -41,6 +41,7 @@ public:
     io::path_t dataPath() const override;
     io::path_t savingFilesPath() const override;
     io::path_t reportsPath() const override;
+    io::path_t perfBaselinesPath() const override;
     io::path_t drawDataPath() const override;
     io::path_t fileDrawDataPath(const io::path_t& filePath) const override;
 };
@@ -0,0 +1,181 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "perfcollector.h"
+
+#include <cstdio>
+
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#elif defined(Q_OS_MAC)
+#include <mach/mach.h>
+#elif defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+#include "log.h"
+
+using namespace mu::autobot;
+
+void PerfCollector::begin(const QString& testCaseName)
+{
+    m_data = PerfData();
+    m_data.testCase = testCaseName.toStdString();
+    m_scopes.clear();
+    m_collecting = true;
+
+    listenViewPainted();
+    globalContext()->currentNotationChanged().onNotify(this, [this]() {
+        listenViewPainted();
+    });
+}
+
+void PerfCollector::end()
+{
+    m_collecting = false;
+
+    globalContext()->currentNotationChanged().resetOnNotify(this);
+    if (m_notation) {
+        m_notation->painting()->viewPainted().resetOnReceive(this);
+        m_notation = nullptr;
+    }
+
+    for (auto it = m_scopes.cbegin(); it != m_scopes.cend(); ++it) {
+        LOGW() << "timing scope not ended: " << it->first;
+    }
+    m_scopes.clear();
+}
+
+bool PerfCollector::isCollecting() const
+{
+    return m_collecting;
+}
+
+void PerfCollector::listenViewPainted()
+{
+    if (m_notation) {
+        m_notation->painting()->viewPainted().resetOnReceive(this);
+    }
+
+    m_notation = globalContext()->currentNotation();
+    if (!m_notation) {
+        return;
+    }
+
+    m_notation->painting()->viewPainted().onReceive(this, [this](int64_t usec) {
+        addSample("frame", usec / 1000.0);
+    });
+}
+
+void PerfCollector::beginRun(int run)
+{
+    m_run = run;
+    m_data.runs = run + 1;
+    addMemorySnapshot("begin");
+}
+
+void PerfCollector::endRun()
+{
+    addMemorySnapshot("end");
+}
+
+void PerfCollector::addStepLatency(const QString& stepName, int64_t usec)
+{
+    addSample("step/" + stepName.toStdString(), usec / 1000.0);
+}
+
+void PerfCollector::beginScope(const QString& name)
+{
+    if (!m_collecting) {
+        return;
+    }
+
+    m_scopes[name].start();
+}
+
+void PerfCollector::endScope(const QString& name)
+{
+    if (!m_collecting) {
+        return;
+    }
+
+    auto it = m_scopes.find(name);
+    if (it == m_scopes.end()) {
+        LOGW() << "timing scope not begun: " << name;
+        return;
+    }
+
+    addSample("scope/" + name.toStdString(), it->second.nsecsElapsed() / 1000000.0);
+    m_scopes.erase(it);
+}
+
+const PerfData& PerfCollector::data() const
+{
+    return m_data;
+}
+
+void PerfCollector::addSample(const std::string& metric, double msec)
+{
+    if (!m_collecting) {
+        return;
+    }
+
+    m_data.samplesMsec[metric].push_back(msec);
+}
+
+void PerfCollector::addMemorySnapshot(const std::string& point)
+{
+    PerfMemorySnapshot snapshot;
+    snapshot.run = m_run;
+    snapshot.point = point;
+    snapshot.residentKb = residentMemoryKb();
+    m_data.memory.push_back(snapshot);
+}
+
+int64_t PerfCollector::residentMemoryKb()
+{
+#if defined(Q_OS_LINUX)
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (!file) {
+        return 0;
+    }
+
+    long size = 0;
+    long resident = 0;
+    int count = std::fscanf(file, "%ld %ld", &size, &resident);
+    std::fclose(file);
+    return count == 2 ? static_cast<int64_t>(resident) * sysconf(_SC_PAGESIZE) / 1024 : 0;
+#elif defined(Q_OS_MAC)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    kern_return_t ret = task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count);
+    return ret == KERN_SUCCESS ? static_cast<int64_t>(info.resident_size / 1024) : 0;
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return static_cast<int64_t>(counters.WorkingSetSize / 1024);
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUTOBOT_PERFCOLLECTOR_H
+#define MU_AUTOBOT_PERFCOLLECTOR_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <QElapsedTimer>
+#include <QString>
+
+#include "async/asyncable.h"
+#include "modularity/ioc.h"
+#include "context/iglobalcontext.h"
+
+namespace mu::autobot {
+struct PerfMemorySnapshot
+{
+    int run = 0;
+    std::string point;
+    int64_t residentKb = 0;
+};
+
+struct PerfData
+{
+    std::string testCase;
+    int runs = 0;
+    std::map<std::string, std::vector<double> > samplesMsec; // metric name -> samples
+    std::vector<PerfMemorySnapshot> memory;
+};
+
+//! NOTE Collects the timings of a test case run in the performance mode:
+//! the latency of the steps ("step/<name>"), of the timing scopes opened by the script ("scope/<name>")
+//! and the paint times of the notation view ("frame"), and the memory usage at the begin and the end of each run
+class PerfCollector : public async::Asyncable
+{
+    INJECT(autobot, context::IGlobalContext, globalContext)
+
+public:
+    PerfCollector() = default;
+
+    void begin(const QString& testCaseName);
+    void end();
+    bool isCollecting() const;
+
+    void beginRun(int run);
+    void endRun();
+
+    void addStepLatency(const QString& stepName, int64_t usec);
+
+    void beginScope(const QString& name);
+    void endScope(const QString& name);
+
+    const PerfData& data() const;
+
+    //! NOTE Returns 0 if not available on the platform
+    static int64_t residentMemoryKb();
+
+private:
+    void listenViewPainted();
+    void addSample(const std::string& metric, double msec);
+    void addMemorySnapshot(const std::string& point);
+
+    bool m_collecting = false;
+    int m_run = 0;
+    PerfData m_data;
+    std::map<QString, QElapsedTimer> m_scopes;
+    notation::INotationPtr m_notation;
+};
+}
+
+#endif // MU_AUTOBOT_PERFCOLLECTOR_H
@@ -0,0 +1,206 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "perfreport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include <QDateTime>
+
+#include "serialization/json.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::autobot;
+
+static const std::vector<std::string> COMPARED_STATS = { "p50", "p95" };
+
+//! NOTE Differences smaller than this are timer noise, whatever the percent is
+static constexpr double MIN_REGRESSION_MSEC = 1.0;
+
+//! NOTE Nearest-rank percentile of sorted samples
+static double percentile(const std::vector<double>& sorted, double p)
+{
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+    return sorted.at(std::clamp(rank, size_t(1), sorted.size()) - 1);
+}
+
+PerfReport::Stats PerfReport::stats(std::vector<double> samples)
+{
+    Stats s;
+    if (samples.empty()) {
+        return s;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    s.count = samples.size();
+    s.min = samples.front();
+    s.max = samples.back();
+    s.mean = std::accumulate(samples.cbegin(), samples.cend(), 0.0) / samples.size();
+    s.p50 = percentile(samples, 50);
+    s.p90 = percentile(samples, 90);
+    s.p95 = percentile(samples, 95);
+    s.p99 = percentile(samples, 99);
+    return s;
+}
+
+static JsonObject toObj(const PerfReport::Stats& s)
+{
+    JsonObject obj;
+    obj["count"] = static_cast<int>(s.count);
+    obj["min"] = s.min;
+    obj["mean"] = s.mean;
+    obj["p50"] = s.p50;
+    obj["p90"] = s.p90;
+    obj["p95"] = s.p95;
+    obj["p99"] = s.p99;
+    obj["max"] = s.max;
+    return obj;
+}
+
+RetVal<io::path_t> PerfReport::write(const PerfData& data)
+{
+    RetVal<io::path_t> result;
+
+    io::path_t reportsPath = configuration()->reportsPath();
+    result.ret = fileSystem()->makePath(reportsPath);
+    if (!result.ret) {
+        return result;
+    }
+
+    QDateTime now = QDateTime::currentDateTime();
+
+    JsonObject metrics;
+    for (auto it = data.samplesMsec.cbegin(); it != data.samplesMsec.cend(); ++it) {
+        metrics[it->first] = toObj(stats(it->second));
+    }
+
+    JsonArray memory;
+    for (const PerfMemorySnapshot& snapshot : data.memory) {
+        JsonObject obj;
+        obj["run"] = snapshot.run;
+        obj["point"] = snapshot.point;
+        obj["residentKb"] = static_cast<int>(snapshot.residentKb);
+        memory << obj;
+    }
+
+    JsonObject root;
+    root["testCase"] = data.testCase;
+    root["date"] = now.toString(Qt::ISODate).toStdString();
+    root["runs"] = data.runs;
+    root["unit"] = "msec";
+    root["metrics"] = metrics;
+    root["memory"] = memory;
+
+    QString fileName = QString::fromStdString(data.testCase) + "_" + now.toString("yyMMddhhmmss") + ".perf.json";
+    result.val = reportsPath + "/" + fileName;
+    result.ret = fileSystem()->writeFile(result.val, JsonDocument(root).toJson());
+    return result;
+}
+
+static RetVal<JsonObject> readMetrics(io::IFileSystem* fileSystem, const io::path_t& path)
+{
+    RetVal<JsonObject> result;
+
+    RetVal<ByteArray> data = fileSystem->readFile(path);
+    if (!data.ret) {
+        result.ret = data.ret;
+        return result;
+    }
+
+    std::string err;
+    JsonDocument doc = JsonDocument::fromJson(data.val, &err);
+    if (!err.empty() || !doc.isObject()) {
+        result.ret = make_ret(Ret::Code::UnknownError, "failed parse " + path.toStdString() + ", err: " + err);
+        return result;
+    }
+
+    result.ret = make_ok();
+    result.val = doc.rootObject().value("metrics").toObject();
+    return result;
+}
+
+RetVal<std::vector<PerfReport::MetricDiff> > PerfReport::compare(const io::path_t& reportPath, const io::path_t& baselinePath,
+                                                                 double tolerancePercent) const
+{
+    RetVal<std::vector<MetricDiff> > result;
+
+    RetVal<JsonObject> current = readMetrics(fileSystem().get(), reportPath);
+    if (!current.ret) {
+        result.ret = current.ret;
+        return result;
+    }
+
+    RetVal<JsonObject> baseline = readMetrics(fileSystem().get(), baselinePath);
+    if (!baseline.ret) {
+        result.ret = baseline.ret;
+        return result;
+    }
+
+    bool regressed = false;
+    for (const std::string& metric : current.val.keys()) {
+        if (!baseline.val.contains(metric)) {
+            continue;
+        }
+
+        JsonObject cur = current.val.value(metric).toObject();
+        JsonObject base = baseline.val.value(metric).toObject();
+        for (const std::string& stat : COMPARED_STATS) {
+            MetricDiff diff;
+            diff.metric = metric;
+            diff.stat = stat;
+            diff.current = cur.value(stat).toDouble();
+            diff.baseline = base.value(stat).toDouble();
+            diff.changePercent = diff.baseline > 0.0 ? (diff.current - diff.baseline) / diff.baseline * 100.0 : 0.0;
+            diff.regressed = diff.changePercent > tolerancePercent && (diff.current - diff.baseline) > MIN_REGRESSION_MSEC;
+
+            regressed |= diff.regressed;
+            result.val.push_back(diff);
+        }
+    }
+
+    result.ret = regressed ? make_ret(Ret::Code::UnknownError, "performance regressed against the baseline") : make_ok();
+    return result;
+}
+
+Ret PerfReport::writeComparison(const io::path_t& path, const std::vector<MetricDiff>& diffs) const
+{
+    JsonArray arr;
+    for (const MetricDiff& diff : diffs) {
+        JsonObject obj;
+        obj["metric"] = diff.metric;
+        obj["stat"] = diff.stat;
+        obj["baseline"] = diff.baseline;
+        obj["current"] = diff.current;
+        obj["changePercent"] = diff.changePercent;
+        obj["regressed"] = diff.regressed;
+        arr << obj;
+    }
+
+    JsonObject root;
+    root["comparison"] = arr;
+
+    return fileSystem()->writeFile(path, JsonDocument(root).toJson());
+}
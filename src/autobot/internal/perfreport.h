@@ -0,0 +1,81 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUTOBOT_PERFREPORT_H
+#define MU_AUTOBOT_PERFREPORT_H
+
+#include <string>
+#include <vector>
+
+#include "modularity/ioc.h"
+#include "../iautobotconfiguration.h"
+#include "io/ifilesystem.h"
+#include "types/retval.h"
+
+#include "perfcollector.h"
+
+namespace mu::autobot {
+//! NOTE Writes the collected timings as json: percentiles of every metric and the memory snapshots,
+//! and compares a report with a baseline (a previous report of the same test case)
+class PerfReport
+{
+    INJECT(autobot, IAutobotConfiguration, configuration)
+    INJECT(autobot, io::IFileSystem, fileSystem)
+
+public:
+    PerfReport() = default;
+
+    struct Stats
+    {
+        size_t count = 0;
+        double min = 0.0;
+        double mean = 0.0;
+        double p50 = 0.0;
+        double p90 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    struct MetricDiff
+    {
+        std::string metric;
+        std::string stat;
+        double baseline = 0.0;
+        double current = 0.0;
+        double changePercent = 0.0;
+        bool regressed = false;
+    };
+
+    static Stats stats(std::vector<double> samples);
+
+    RetVal<io::path_t> write(const PerfData& data);
+
+    //! NOTE Compares p50 and p95 of the metrics present in both reports,
+    //! a metric is regressed if it is slower than the baseline by more than the tolerance
+    RetVal<std::vector<MetricDiff> > compare(const io::path_t& reportPath, const io::path_t& baselinePath,
+                                             double tolerancePercent) const;
+
+    Ret writeComparison(const io::path_t& path, const std::vector<MetricDiff>& diffs) const;
+};
+}
+
+#endif // MU_AUTOBOT_PERFREPORT_H
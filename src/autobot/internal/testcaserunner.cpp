@@ -163,7 +163,7 @@ void TestCaseRunner::nextStep(bool byInterval)
             }
 
             LOGD() << "step: " << name << " Finished";
-            m_stepStatusChanged.send(StepInfo(step.name(), StepStatus::Finished, m_elapsed.elapsed()), make_ok());
+            m_stepStatusChanged.send(StepInfo(step.name(), StepStatus::Finished, m_elapsed.nsecsElapsed() / 1000), make_ok());
         }
 
         bool withInterval = step.skip() ? false : true;
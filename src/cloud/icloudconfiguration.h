@@ -37,6 +37,7 @@ public:
     virtual network::RequestHeaders headers() const = 0;
     virtual QByteArray clientId() const = 0;
     virtual QByteArray uploadingLicense() const = 0;
+    virtual bool chunkedUploadEnabled() const = 0;
 
     virtual QUrl authorizationUrl() const = 0;
     virtual QUrl signUpUrl() const = 0;
@@ -46,6 +47,7 @@ public:
     virtual QUrl logoutApiUrl() const = 0;
     virtual QUrl scoreInfoApiUrl() const = 0;
     virtual QUrl uploadingApiUrl() const = 0;
+    virtual QUrl chunkedUploadingApiUrl() const = 0;
     virtual io::path_t tokensFilePath() const = 0;
 };
 }
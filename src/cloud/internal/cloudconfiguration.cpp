@@ -32,6 +32,7 @@ using namespace mu::framework;
 
 static const std::string module_name("cloud");
 static const Settings::Key CLIENT_ID_KEY(module_name, "cloud/clientId");
+static const Settings::Key CHUNKED_UPLOAD_ENABLED_KEY(module_name, "cloud/chunkedUploadEnabled");
 
 static QByteArray generateClientId()
 {
@@ -74,6 +75,9 @@ void CloudConfiguration::init()
     if (settings()->value(CLIENT_ID_KEY).isNull()) {
         settings()->setSharedValue(CLIENT_ID_KEY, Val(generateClientId().toStdString()));
     }
+
+    //! NOTE Off until the server supports the upload sessions of network::ChunkedUpload
+    settings()->setDefaultValue(CHUNKED_UPLOAD_ENABLED_KEY, Val(false));
 }
 
 RequestHeaders CloudConfiguration::headers() const
@@ -96,6 +100,11 @@ QByteArray CloudConfiguration::uploadingLicense() const
     return "all-rights-reserved";
 }
 
+bool CloudConfiguration::chunkedUploadEnabled() const
+{
+    return settings()->value(CHUNKED_UPLOAD_ENABLED_KEY).toBool();
+}
+
 QUrl CloudConfiguration::authorizationUrl() const
 {
     return QUrl("https://musescore.com/oauth/authorize");
@@ -136,6 +145,11 @@ QUrl CloudConfiguration::uploadingApiUrl() const
     return apiRootUrl() + "/score/upload";
 }
 
+QUrl CloudConfiguration::chunkedUploadingApiUrl() const
+{
+    return apiRootUrl() + "/score/upload/chunked";
+}
+
 mu::io::path_t CloudConfiguration::tokensFilePath() const
 {
     return globalConfiguration()->userAppDataPath() + "/cred.dat";
@@ -38,6 +38,7 @@ public:
     network::RequestHeaders headers() const override;
     QByteArray clientId() const override;
     QByteArray uploadingLicense() const override;
+    bool chunkedUploadEnabled() const override;
 
     QUrl authorizationUrl() const override;
     QUrl signUpUrl() const override;
@@ -47,6 +48,7 @@ public:
     QUrl logoutApiUrl() const override;
     QUrl scoreInfoApiUrl() const override;
     QUrl uploadingApiUrl() const override;
+    QUrl chunkedUploadingApiUrl() const override;
 
     io::path_t tokensFilePath() const override;
 
@@ -33,6 +33,7 @@
 #include <QRandomGenerator>
 
 #include "network/networkerrors.h"
+#include "network/chunkedupload.h"
 #include "multiinstances/resourcelockguard.h"
 #include "global/async/async.h"
 
@@ -56,6 +57,7 @@ static const std::string CLOUD_ACCESS_TOKEN_RESOURCE_NAME("CLOUD_ACCESS_TOKEN");
 
 constexpr int USER_UNAUTHORIZED_ERR_CODE = 401;
 constexpr int INVALID_SCORE_ID = 0;
+constexpr qint64 CHUNKED_UPLOAD_MIN_SIZE = 4 * 1024 * 1024;
 
 static int scoreIdFromSourceUrl(const QUrl& sourceUrl)
 {
@@ -416,7 +418,7 @@ ProgressPtr CloudService::uploadScore(QIODevice& scoreSourceDevice, const QStrin
             progress->progressChanged.send(current, total, message);
         });
 
-        RetVal<QUrl> newSourceUrl = doUploadScore(manager, scoreSourceDevice, title, sourceUrl);
+        RetVal<QUrl> newSourceUrl = doUploadScore(manager, progress, scoreSourceDevice, title, sourceUrl);
 
         ProgressResult result;
         result.ret = newSourceUrl.ret;
@@ -438,8 +440,8 @@ ProgressPtr CloudService::uploadScore(QIODevice& scoreSourceDevice, const QStrin
     return progress;
 }
 
-mu::RetVal<QUrl> CloudService::doUploadScore(INetworkManagerPtr uploadManager, QIODevice& scoreSourceDevice, const QString& title,
-                                             const QUrl& sourceUrl)
+mu::RetVal<QUrl> CloudService::doUploadScore(INetworkManagerPtr uploadManager, ProgressPtr progress, QIODevice& scoreSourceDevice,
+                                             const QString& title, const QUrl& sourceUrl)
 {
     TRACEFUNC;
 
@@ -472,6 +474,13 @@ mu::RetVal<QUrl> CloudService::doUploadScore(INetworkManagerPtr uploadManager, Q
         }
     }
 
+    //! NOTE Large projects (with embedded audio, for example) can be uploaded in chunks,
+    //! an upload failed on a flaky connection is resumed on the next try instead of starting from zero.
+    //! Off by default, see ICloudConfiguration::chunkedUploadEnabled()
+    if (configuration()->chunkedUploadEnabled() && scoreSourceDevice.size() >= CHUNKED_UPLOAD_MIN_SIZE) {
+        return doUploadScoreChunked(uploadManager, progress, scoreSourceDevice, title, isScoreAlreadyUploaded ? scoreId : INVALID_SCORE_ID);
+    }
+
     QHttpMultiPart multiPart(QHttpMultiPart::FormDataType);
 
     QHttpPart filePart;
@@ -510,6 +519,55 @@ mu::RetVal<QUrl> CloudService::doUploadScore(INetworkManagerPtr uploadManager, Q
         ret = uploadManager->post(uploadUrl.val, &device, &receivedData, headers());
     }
 
+    return scoreUrlFromUploadReply(ret, receivedData.data());
+}
+
+mu::RetVal<QUrl> CloudService::doUploadScoreChunked(INetworkManagerPtr uploadManager, ProgressPtr progress, QIODevice& scoreSourceDevice,
+                                                    const QString& title, int scoreId)
+{
+    TRACEFUNC;
+
+    RetVal<QUrl> uploadUrl = prepareUrlForRequest(configuration()->chunkedUploadingApiUrl());
+    if (!uploadUrl.ret) {
+        return uploadUrl.ret;
+    }
+
+    //! NOTE The same content uploaded again after a failure resumes the previous upload session,
+    //! ChunkedUpload starts a new one when the content differs
+    if (!m_chunkedUpload) {
+        m_chunkedUpload = std::make_shared<ChunkedUpload>();
+    }
+
+    //! NOTE The url has the current access token, it may be refreshed since the previous try
+    m_chunkedUpload->setUrl(uploadUrl.val);
+    m_chunkedUpload->setHeaders(headers());
+
+    //! NOTE The progress of the whole upload, not of the single requests
+    uploadManager->progress().progressChanged.resetOnReceive(this);
+
+    m_chunkedUpload->progress().progressChanged.resetOnReceive(this);
+    m_chunkedUpload->progress().progressChanged.onReceive(this, [progress](int64_t current, int64_t total, const std::string& message) {
+        progress->progressChanged.send(current, total, message);
+    });
+
+    QJsonObject scoreInfo;
+    if (scoreId != INVALID_SCORE_ID) {
+        scoreInfo[SCORE_ID_KEY] = scoreId;
+    }
+    scoreInfo["title"] = title;
+    scoreInfo["license"] = QString::fromUtf8(configuration()->uploadingLicense());
+
+    QByteArray completeData = QJsonDocument(scoreInfo).toJson(QJsonDocument::Compact);
+    QBuffer receivedData;
+    Ret ret = m_chunkedUpload->upload(uploadManager, &scoreSourceDevice, completeData, &receivedData);
+
+    return scoreUrlFromUploadReply(ret, receivedData.data());
+}
+
+mu::RetVal<QUrl> CloudService::scoreUrlFromUploadReply(const Ret& ret, const QByteArray& receivedData)
+{
+    RetVal<QUrl> result = RetVal<QUrl>::make_ok(QUrl());
+
     if (ret.code() == USER_UNAUTHORIZED_ERR_CODE) {
         return make_ret(cloud::Err::UserIsNotAuthorized);
     }
@@ -519,7 +577,7 @@ mu::RetVal<QUrl> CloudService::doUploadScore(INetworkManagerPtr uploadManager, Q
         return result;
     }
 
-    QJsonObject scoreInfo = QJsonDocument::fromJson(receivedData.data()).object();
+    QJsonObject scoreInfo = QJsonDocument::fromJson(receivedData).object();
     QUrl newSourceUrl = QUrl(scoreInfo.value("permalink").toString());
     QUrl editUrl = QUrl(scoreInfo.value("edit_url").toString());
 
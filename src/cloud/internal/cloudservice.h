@@ -36,6 +36,7 @@ class QOAuthHttpServerReplyHandler;
 #include "icloudconfiguration.h"
 #include "io/ifilesystem.h"
 #include "network/inetworkmanagercreator.h"
+#include "network/chunkedupload.h"
 #include "multiinstances/imultiinstancesprovider.h"
 #include "iinteractive.h"
 
@@ -88,8 +89,11 @@ private:
     Ret downloadUserInfo();
     RetVal<ScoreInfo> downloadScoreInfo(int scoreId);
 
-    RetVal<QUrl> doUploadScore(network::INetworkManagerPtr uploadManager, QIODevice& scoreSourceDevice, const QString& title,
-                               const QUrl& sourceUrl = QUrl());
+    RetVal<QUrl> doUploadScore(network::INetworkManagerPtr uploadManager, framework::ProgressPtr progress, QIODevice& scoreSourceDevice,
+                               const QString& title, const QUrl& sourceUrl = QUrl());
+    RetVal<QUrl> doUploadScoreChunked(network::INetworkManagerPtr uploadManager, framework::ProgressPtr progress,
+                                      QIODevice& scoreSourceDevice, const QString& title, int scoreId);
+    RetVal<QUrl> scoreUrlFromUploadReply(const Ret& ret, const QByteArray& receivedData);
 
     using RequestCallback = std::function<Ret()>;
     void executeRequest(const RequestCallback& requestCallback);
@@ -104,6 +108,8 @@ private:
     QString m_refreshToken;
 
     OnUserAuthorizedCallback m_onUserAuthorizedCallback;
+
+    std::shared_ptr<network::ChunkedUpload> m_chunkedUpload;
 };
 }
 
@@ -35,13 +35,17 @@ public:
 
     virtual Ret fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                             bool forceMode = false) = 0;
+    //! NOTE Loads the score once for all the outputs, the audio outputs share one rendering of the playback
+    virtual Ret fileConvert(const io::path_t& in, const io::paths_t& outs, const io::path_t& stylePath = io::path_t(),
+                            bool forceMode = false) = 0;
     virtual Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false) = 0;
     virtual Ret convertScoreParts(const io::path_t& in, const io::path_t& out,
                                   const io::path_t& stylePath = io::path_t(), bool forceMode = false) = 0;
 
     virtual Ret exportScoreMedia(const io::path_t& in, const io::path_t& out,
                                  const io::path_t& highlightConfigPath = io::path_t(),
-                                 const io::path_t& stylePath = io::path_t(), bool forceMode = false) = 0;
+                                 const io::path_t& stylePath = io::path_t(), bool forceMode = false,
+                                 bool concurrentMode = false) = 0;
     virtual Ret exportScoreMeta(const io::path_t& in, const io::path_t& out,
                                 const io::path_t& stylePath = io::path_t(), bool forceMode = false) = 0;
     virtual Ret exportScoreParts(const io::path_t& in, const io::path_t& out,
@@ -54,6 +58,9 @@ public:
     virtual Ret exportScoreVideo(const io::path_t& in, const io::path_t& out) = 0;
 
     virtual Ret updateSource(const io::path_t& in, const std::string& newSource, bool forceMode = false) = 0;
+
+    //! NOTE Reads jobs as JSON lines from stdin until EOF, writes one JSON result line per job to stdout
+    virtual Ret runServer(const io::path_t& stylePath = io::path_t(), bool forceMode = false, size_t maxPendingJobs = 4) = 0;
 };
 }
 
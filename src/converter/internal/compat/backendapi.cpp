@@ -23,6 +23,11 @@
 
 #include <stdio.h>
 
+#if defined(Q_OS_LINUX) || defined(Q_OS_MAC)
+#include <sys/resource.h>
+#endif
+
+#include <QElapsedTimer>
 #include <QString>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -35,8 +40,11 @@
 #include "engraving/compat/scoreaccess.h"
 #include "engraving/infrastructure/mscwriter.h"
 #include "engraving/libmscore/excerpt.h"
+#include "engraving/libmscore/masterscore.h"
+#include "engraving/libmscore/repeatlist.h"
 
 #include "backendjsonwriter.h"
+#include "jsonencodingqueue.h"
 #include "notationmeta.h"
 
 #include "log.h"
@@ -48,6 +56,9 @@ using namespace mu::notation;
 using namespace mu::engraving;
 using namespace mu::io;
 
+static const std::string PNGS_JSON_NAME = "pngs";
+static const std::string SVGS_JSON_NAME = "svgs";
+
 static const std::string PNG_WRITER_NAME = "png";
 static const std::string SVG_WRITER_NAME = "svg";
 static const std::string SEGMENTS_POSITIONS_WRITER_NAME = "sposXML";
@@ -61,9 +72,23 @@ static const std::string META_DATA_NAME = "metadata";
 static constexpr bool ADD_SEPARATOR = true;
 static constexpr auto NO_STYLE = "";
 
+//! NOTE Returns 0 if not available on the platform
+static long peakMemoryUsageKb()
+{
+#if defined(Q_OS_LINUX)
+    rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? usage.ru_maxrss : 0;
+#elif defined(Q_OS_MAC)
+    rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? usage.ru_maxrss / 1024 : 0;
+#else
+    return 0;
+#endif
+}
+
 Ret BackendApi::exportScoreMedia(const io::path_t& in, const io::path_t& out, const io::path_t& highlightConfigPath,
                                  const io::path_t& stylePath,
-                                 bool forceMode)
+                                 bool forceMode, bool concurrentMode)
 {
     TRACEFUNC
 
@@ -81,6 +106,12 @@ Ret BackendApi::exportScoreMedia(const io::path_t& in, const io::path_t& out, co
 
     BackendJsonWriter jsonWriter(&outputFile);
 
+    if (concurrentMode) {
+        Ret ret = exportScoreMediaConcurrently(notation, highlightConfigPath, jsonWriter);
+        LOGI() << "peak memory usage: " << peakMemoryUsageKb() << " KB";
+        return ret;
+    }
+
     result &= exportScorePngs(notation, jsonWriter, ADD_SEPARATOR);
     result &= exportScoreSvgs(notation, highlightConfigPath, jsonWriter, ADD_SEPARATOR);
     result &= exportScoreElementsPositions(SEGMENTS_POSITIONS_WRITER_NAME, notation, jsonWriter, ADD_SEPARATOR);
@@ -277,30 +308,25 @@ Ret BackendApi::exportScorePngs(const INotationPtr notation, BackendJsonWriter&
         return make_ret(Ret::Code::InternalError);
     }
 
-    jsonWriter.addKey("pngs");
+    jsonWriter.addKey(PNGS_JSON_NAME.c_str());
     jsonWriter.openArray();
 
     PageList notationPages = pages(notation);
 
-    bool result = true;
-    for (size_t i = 0; i < notationPages.size(); ++i) {
-        QByteArray pngData;
-        QBuffer pngDevice(&pngData);
-        pngDevice.open(QIODevice::ReadWrite);
-
-        INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-            { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) }
-        };
-
-        Ret writeRet = pngWriter->write(notation, pngDevice, options);
-        if (!writeRet) {
-            LOGW() << writeRet.toString();
-            result = false;
-        }
+    INotationWriter::Options options {
+        { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) }
+    };
+
+    Ret writeRet = pngWriter->writePages(notation, [&](size_t pageIndex, const QByteArray& pngData) {
+        bool lastArrayValue = ((notationPages.size() - 1) == pageIndex);
+        jsonWriter.addBase64Value(pngData, !lastArrayValue);
+        return make_ok();
+    }, options);
 
-        bool lastArrayValue = ((notationPages.size() - 1) == i);
-        jsonWriter.addValue(pngData.toBase64(), !lastArrayValue);
+    bool result = true;
+    if (!writeRet) {
+        LOGW() << writeRet.toString();
+        result = false;
     }
 
     jsonWriter.closeArray(addSeparator);
@@ -319,32 +345,27 @@ Ret BackendApi::exportScoreSvgs(const INotationPtr notation, const io::path_t& h
         return make_ret(Ret::Code::InternalError);
     }
 
-    jsonWriter.addKey("svgs");
+    jsonWriter.addKey(SVGS_JSON_NAME.c_str());
     jsonWriter.openArray();
 
     PageList notationPages = pages(notation);
     QVariantMap beatsColors = readBeatsColors(highlightConfigPath);
 
-    bool result = true;
-    for (size_t i = 0; i < notationPages.size(); ++i) {
-        QByteArray svgData;
-        QBuffer svgDevice(&svgData);
-        svgDevice.open(QIODevice::ReadWrite);
-
-        INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-            { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) },
-            { INotationWriter::OptionKey::BEATS_COLORS, Val::fromQVariant(beatsColors) }
-        };
-
-        Ret writeRet = svgWriter->write(notation, svgDevice, options);
-        if (!writeRet) {
-            LOGW() << writeRet.toString();
-            result = false;
-        }
+    INotationWriter::Options options {
+        { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) },
+        { INotationWriter::OptionKey::BEATS_COLORS, Val::fromQVariant(beatsColors) }
+    };
+
+    Ret writeRet = svgWriter->writePages(notation, [&](size_t pageIndex, const QByteArray& svgData) {
+        bool lastArrayValue = ((notationPages.size() - 1) == pageIndex);
+        jsonWriter.addBase64Value(svgData, !lastArrayValue);
+        return make_ok();
+    }, options);
 
-        bool lastArrayValue = ((notationPages.size() - 1) == i);
-        jsonWriter.addValue(svgData.toBase64(), !lastArrayValue);
+    bool result = true;
+    if (!writeRet) {
+        LOGW() << writeRet.toString();
+        result = false;
     }
 
     jsonWriter.closeArray(addSeparator);
@@ -444,7 +465,133 @@ Ret BackendApi::exportScoreMetaData(const INotationPtr notation, BackendJsonWrit
     return make_ret(Ret::Code::Ok);
 }
 
-mu::RetVal<QByteArray> BackendApi::processWriter(const std::string& writerName, const INotationPtr notation)
+Ret BackendApi::exportScoreMediaConcurrently(const INotationPtr notation, const io::path_t& highlightConfigPath,
+                                             BackendJsonWriter& jsonWriter)
+{
+    TRACEFUNC
+
+    //! NOTE The writers lay out, paint and change the score, so all of them run in order on this thread.
+    //! Only base64 encoding and writing to the output run concurrently, on the encoding thread.
+    //! Every page and every artifact is handed over as soon as it is ready and released once it is written
+    JsonEncodingQueue queue(jsonWriter);
+
+    INotationWriter::Options svgOptions {
+        { INotationWriter::OptionKey::BEATS_COLORS, Val::fromQVariant(readBeatsColors(highlightConfigPath)) }
+    };
+
+    bool result = true;
+    result &= streamScorePages(PNGS_JSON_NAME, PNG_WRITER_NAME, notation, {}, queue, ADD_SEPARATOR);
+    result &= streamScorePages(SVGS_JSON_NAME, SVG_WRITER_NAME, notation, svgOptions, queue, ADD_SEPARATOR);
+    result &= streamWriterResult(SEGMENTS_POSITIONS_WRITER_NAME, SEGMENTS_POSITIONS_WRITER_NAME, notation, queue, ADD_SEPARATOR);
+    result &= streamWriterResult(MEASURES_POSITIONS_WRITER_NAME, MEASURES_POSITIONS_WRITER_NAME, notation, queue, ADD_SEPARATOR);
+    result &= streamWriterResult(PDF_WRITER_NAME, PDF_WRITER_NAME, notation, queue, ADD_SEPARATOR);
+    result &= streamWriterResult(MIDI_WRITER_NAME, MIDI_WRITER_NAME, notation, queue, ADD_SEPARATOR);
+    result &= streamWriterResult(MUSICXML_JSON_NAME, MUSICXML_WRITER_NAME, notation, queue, ADD_SEPARATOR);
+    result &= streamScoreMetaData(notation, queue);
+
+    queue.finish();
+
+    return result ? make_ret(Ret::Code::Ok) : make_ret(Ret::Code::InternalError);
+}
+
+Ret BackendApi::streamScorePages(const std::string& key, const std::string& writerName, const INotationPtr notation,
+                                 const INotationWriter::Options& options, JsonEncodingQueue& queue, bool addSeparator)
+{
+    TRACEFUNC
+
+    QElapsedTimer timer;
+    timer.start();
+
+    auto writer = writers()->writer(writerName);
+    if (!writer) {
+        LOGW() << "Not found writer " << writerName;
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    queue.push([key](BackendJsonWriter& jsonWriter) {
+        jsonWriter.addKey(key.c_str());
+        jsonWriter.openArray();
+    });
+
+    size_t pagesCount = pages(notation).size();
+
+    INotationWriter::Options pagesOptions = options;
+    pagesOptions[INotationWriter::OptionKey::TRANSPARENT_BACKGROUND] = Val(false);
+
+    Ret writeRet = writer->writePages(notation, [&queue, pagesCount](size_t pageIndex, const QByteArray& pageData) {
+        bool lastArrayValue = ((pagesCount - 1) == pageIndex);
+        queue.push([pageData, lastArrayValue](BackendJsonWriter& jsonWriter) {
+            jsonWriter.addBase64Value(pageData, !lastArrayValue);
+        });
+        return make_ok();
+    }, pagesOptions);
+
+    bool result = true;
+    if (!writeRet) {
+        LOGW() << writeRet.toString();
+        result = false;
+    }
+
+    queue.push([addSeparator](BackendJsonWriter& jsonWriter) {
+        jsonWriter.closeArray(addSeparator);
+    });
+
+    LOGI() << key << ": " << timer.elapsed() << " ms";
+
+    return result ? make_ret(Ret::Code::Ok) : make_ret(Ret::Code::InternalError);
+}
+
+Ret BackendApi::streamWriterResult(const std::string& key, const std::string& writerName, const INotationPtr notation,
+                                   JsonEncodingQueue& queue, bool addSeparator)
+{
+    TRACEFUNC
+
+    QElapsedTimer timer;
+    timer.start();
+
+    RetVal<QByteArray> data = processWriterRaw(writerName, notation);
+
+    LOGI() << key << ": " << timer.elapsed() << " ms";
+
+    //! NOTE Like in the sequential mode, the failed writers are skipped
+    if (!data.ret) {
+        return data.ret;
+    }
+
+    queue.push([key, rawData = std::move(data.val), addSeparator](BackendJsonWriter& jsonWriter) {
+        jsonWriter.addKey(key.c_str());
+        jsonWriter.addBase64Value(rawData, addSeparator);
+    });
+
+    return make_ret(Ret::Code::Ok);
+}
+
+Ret BackendApi::streamScoreMetaData(const INotationPtr notation, JsonEncodingQueue& queue, bool addSeparator)
+{
+    TRACEFUNC
+
+    QElapsedTimer timer;
+    timer.start();
+
+    RetVal<std::string> meta = NotationMeta::metaJson(notation);
+
+    LOGI() << META_DATA_NAME << ": " << timer.elapsed() << " ms";
+
+    if (!meta.ret) {
+        LOGW() << meta.ret.toString();
+        return meta.ret;
+    }
+
+    queue.push([data = QString::fromStdString(meta.val).toUtf8(), addSeparator](BackendJsonWriter& jsonWriter) {
+        jsonWriter.addKey(META_DATA_NAME.c_str());
+        jsonWriter.addValue(data, addSeparator, true);
+    });
+
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::RetVal<QByteArray> BackendApi::processWriterRaw(const std::string& writerName, const INotationPtr notation,
+                                                    const INotationWriter::Options& options)
 {
     auto writer = writers()->writer(writerName);
     if (!writer) {
@@ -456,18 +603,24 @@ mu::RetVal<QByteArray> BackendApi::processWriter(const std::string& writerName,
     QBuffer device(&data);
     device.open(QIODevice::ReadWrite);
 
-    Ret writeRet = writer->write(notation, device);
+    Ret writeRet = writer->write(notation, device, options);
     if (!writeRet) {
         LOGW() << writeRet.toString();
         return writeRet;
     }
 
-    RetVal<QByteArray> result;
-    result.ret = make_ret(Ret::Code::Ok);
-    result.val = data.toBase64();
-
     device.close();
 
+    return RetVal<QByteArray>::make_ok(data);
+}
+
+mu::RetVal<QByteArray> BackendApi::processWriter(const std::string& writerName, const INotationPtr notation)
+{
+    RetVal<QByteArray> result = processWriterRaw(writerName, notation);
+    if (result.ret) {
+        result.val = result.val.toBase64();
+    }
+
     return result;
 }
 
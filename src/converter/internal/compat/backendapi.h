@@ -22,6 +22,9 @@
 #ifndef MU_CONVERTER_BACKENDAPI_H
 #define MU_CONVERTER_BACKENDAPI_H
 
+#include <string>
+#include <vector>
+
 #include "types/retval.h"
 
 #include "io/path.h"
@@ -37,6 +40,7 @@ class Score;
 
 namespace mu::converter {
 class BackendJsonWriter;
+class JsonEncodingQueue;
 class BackendApi
 {
     INJECT_STATIC(converter, io::IFileSystem, fileSystem)
@@ -45,7 +49,7 @@ class BackendApi
 
 public:
     static Ret exportScoreMedia(const io::path_t& in, const io::path_t& out, const io::path_t& highlightConfigPath,
-                                const io::path_t& stylePath = "", bool forceMode = false);
+                                const io::path_t& stylePath = "", bool forceMode = false, bool concurrentMode = false);
     static Ret exportScoreMeta(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath, bool forceMode = false);
     static Ret exportScoreParts(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath, bool forceMode = false);
     static Ret exportScorePartsPdfs(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath, bool forceMode = false);
@@ -75,6 +79,16 @@ private:
     static Ret exportScoreMusicXML(const notation::INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator = false);
     static Ret exportScoreMetaData(const notation::INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator = false);
 
+    static Ret exportScoreMediaConcurrently(const notation::INotationPtr notation, const io::path_t& highlightConfigPath,
+                                            BackendJsonWriter& jsonWriter);
+    static Ret streamScorePages(const std::string& key, const std::string& writerName, const notation::INotationPtr notation,
+                                const project::INotationWriter::Options& options, JsonEncodingQueue& queue, bool addSeparator = false);
+    static Ret streamWriterResult(const std::string& key, const std::string& writerName, const notation::INotationPtr notation,
+                                  JsonEncodingQueue& queue, bool addSeparator = false);
+    static Ret streamScoreMetaData(const notation::INotationPtr notation, JsonEncodingQueue& queue, bool addSeparator = false);
+
+    static mu::RetVal<QByteArray> processWriterRaw(const std::string& writerName, const notation::INotationPtr notation,
+                                                   const project::INotationWriter::Options& options = {});
     static mu::RetVal<QByteArray> processWriter(const std::string& writerName, const notation::INotationPtr notation);
     static mu::RetVal<QByteArray> processWriter(const std::string& writerName, const notation::INotationPtrList notations,
                                                 const project::INotationWriter::Options& options);
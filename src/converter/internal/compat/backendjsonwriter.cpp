@@ -21,6 +21,8 @@
  */
 #include "backendjsonwriter.h"
 
+#include <algorithm>
+
 using namespace mu::converter;
 using namespace mu::io;
 
@@ -58,6 +60,25 @@ void BackendJsonWriter::addValue(const QByteArray& data, bool addSeparator, bool
     }
 }
 
+void BackendJsonWriter::addBase64Value(const QByteArray& rawData, bool addSeparator)
+{
+    //! NOTE Encode by chunks straight into the destination device,
+    //! so that the encoded copy of the whole data never exists in memory.
+    //! The chunk size is a multiple of 3, so no padding appears in between chunks
+    static constexpr qsizetype CHUNK_SIZE = 3 * 16 * 1024;
+
+    m_destinationDevice->write("\"");
+    for (qsizetype pos = 0; pos < rawData.size(); pos += CHUNK_SIZE) {
+        qsizetype len = std::min(CHUNK_SIZE, rawData.size() - pos);
+        m_destinationDevice->write(QByteArray::fromRawData(rawData.constData() + pos, len).toBase64());
+    }
+    m_destinationDevice->write("\"");
+
+    if (addSeparator) {
+        m_destinationDevice->write(",\n");
+    }
+}
+
 void BackendJsonWriter::openArray()
 {
     m_destinationDevice->write(" [");
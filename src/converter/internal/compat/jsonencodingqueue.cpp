@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "jsonencodingqueue.h"
+
+#include "backendjsonwriter.h"
+
+using namespace mu::converter;
+
+JsonEncodingQueue::JsonEncodingQueue(BackendJsonWriter& jsonWriter, size_t maxPendingJobs)
+    : m_jsonWriter(jsonWriter), m_maxPendingJobs(maxPendingJobs)
+{
+    m_thread = std::thread([this]() { run(); });
+}
+
+JsonEncodingQueue::~JsonEncodingQueue()
+{
+    finish();
+}
+
+void JsonEncodingQueue::push(Job job)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_queueChanged.wait(lock, [this]() { return m_jobs.size() < m_maxPendingJobs; });
+    m_jobs.push(std::move(job));
+    m_queueChanged.notify_all();
+}
+
+void JsonEncodingQueue::finish()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_finished = true;
+        m_queueChanged.notify_all();
+    }
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void JsonEncodingQueue::run()
+{
+    for (;;) {
+        Job job;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_queueChanged.wait(lock, [this]() { return !m_jobs.empty() || m_finished; });
+            if (m_jobs.empty()) {
+                return;
+            }
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop();
+            m_queueChanged.notify_all();
+        }
+
+        job(m_jsonWriter);
+    }
+}
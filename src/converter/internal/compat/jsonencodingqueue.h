@@ -0,0 +1,63 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_CONVERTER_JSONENCODINGQUEUE_H
+#define MU_CONVERTER_JSONENCODINGQUEUE_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace mu::converter {
+class BackendJsonWriter;
+
+//! NOTE Runs the pushed jobs in order on its own thread, against the given json writer.
+//! The queue is bounded: push() waits while it's full, so the producer can't get ahead of the output
+class JsonEncodingQueue
+{
+public:
+    using Job = std::function<void (BackendJsonWriter&)>;
+
+    explicit JsonEncodingQueue(BackendJsonWriter& jsonWriter, size_t maxPendingJobs = 4);
+    ~JsonEncodingQueue();
+
+    void push(Job job);
+
+    //! NOTE Waits until all the pushed jobs are done
+    void finish();
+
+private:
+    void run();
+
+    BackendJsonWriter& m_jsonWriter;
+    const size_t m_maxPendingJobs = 0;
+
+    std::queue<Job> m_jobs;
+    bool m_finished = false;
+    std::mutex m_mutex;
+    std::condition_variable m_queueChanged;
+    std::thread m_thread;
+};
+}
+
+#endif // MU_CONVERTER_JSONENCODINGQUEUE_H
@@ -21,6 +21,13 @@
  */
 #include "convertercontroller.h"
 
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include <QElapsedTimer>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -30,6 +37,7 @@
 #include "convertercodes.h"
 #include "stringutils.h"
 #include "compat/backendapi.h"
+#include "global/allocator.h"
 
 #include "log.h"
 
@@ -40,6 +48,23 @@ using namespace mu::notation;
 static const std::string PDF_SUFFIX = "pdf";
 static const std::string PNG_SUFFIX = "png";
 
+//! NOTE "out" of a job is a path or an array of paths
+static mu::io::paths_t parseOutPaths(const QJsonValue& out)
+{
+    mu::io::paths_t paths;
+    if (out.isArray()) {
+        for (const QJsonValue path : out.toArray()) {
+            if (!path.toString().isEmpty()) {
+                paths.push_back(path.toString());
+            }
+        }
+    } else if (!out.toString().isEmpty()) {
+        paths.push_back(out.toString());
+    }
+
+    return paths;
+}
+
 mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath, bool forceMode)
 {
     TRACEFUNC;
@@ -54,7 +79,7 @@ mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const
     for (const Job& job : batchJob.val) {
         ret = fileConvert(job.in, job.out, stylePath, forceMode);
         if (!ret) {
-            LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << job.out;
+            LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << io::pathsToString(job.out);
             break;
         }
     }
@@ -63,19 +88,37 @@ mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const
 }
 
 mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath, bool forceMode)
+{
+    return fileConvert(in, io::paths_t { out }, stylePath, forceMode);
+}
+
+mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::paths_t& outs, const io::path_t& stylePath, bool forceMode)
 {
     TRACEFUNC;
 
-    LOGI() << "in: " << in << ", out: " << out;
+    LOGI() << "in: " << in << ", out: " << io::pathsToString(outs);
     auto notationProject = notationCreator()->newProject();
     IF_ASSERT_FAILED(notationProject) {
         return make_ret(Err::UnknownError);
     }
 
-    std::string suffix = io::suffix(out);
-    auto writer = writers()->writer(suffix);
-    if (!writer) {
-        return make_ret(Err::ConvertTypeUnknown);
+    //! NOTE The audio files are written together, so the playback is synthesized only once
+    io::paths_t soundTracks;
+    std::vector<std::pair<io::path_t, INotationWriterPtr> > files;
+
+    for (const io::path_t& out : outs) {
+        std::string suffix = io::suffix(out);
+        if (audioExportService() && audioExportService()->isAudioSuffix(suffix)) {
+            soundTracks.push_back(out);
+            continue;
+        }
+
+        auto writer = writers()->writer(suffix);
+        if (!writer) {
+            return make_ret(Err::ConvertTypeUnknown);
+        }
+
+        files.push_back({ out, writer });
     }
 
     Ret ret = notationProject->load(in, stylePath, forceMode);
@@ -86,10 +129,24 @@ mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::path_t&
 
     globalContext()->setCurrentProject(notationProject);
 
-    if (isConvertPageByPage(suffix)) {
-        ret = convertPageByPage(writer, notationProject->masterNotation()->notation(), out);
-    } else {
-        ret = convertFullNotation(writer, notationProject->masterNotation()->notation(), out);
+    for (const auto& [out, writer] : files) {
+        if (isConvertPageByPage(io::suffix(out))) {
+            ret = convertPageByPage(writer, notationProject->masterNotation()->notation(), out);
+        } else {
+            ret = convertFullNotation(writer, notationProject->masterNotation()->notation(), out);
+        }
+
+        if (!ret) {
+            return ret;
+        }
+    }
+
+    if (!soundTracks.empty()) {
+        ret = audioExportService()->exportSoundTracks(soundTracks);
+        if (!ret) {
+            LOGE() << "failed write, err: " << ret.toString() << ", path: " << io::pathsToString(soundTracks);
+            return make_ret(Err::OutFileFailedWrite);
+        }
     }
 
     return make_ret(Ret::Code::Ok);
@@ -154,7 +211,7 @@ mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(con
 
         Job job;
         job.in = obj["in"].toString();
-        job.out = obj["out"].toString();
+        job.out = parseOutPaths(obj["out"]);
 
         if (!job.in.empty() && !job.out.empty()) {
             rv.val.push_back(std::move(job));
@@ -178,27 +235,28 @@ mu::Ret ConverterController::convertPageByPage(INotationWriterPtr writer, INotat
 {
     TRACEFUNC;
 
-    for (size_t i = 0; i < notation->elements()->pages().size(); i++) {
-        const QString filePath = io::path_t(io::dirpath(out) + "/" + io::basename(out) + "-%1." + io::suffix(out)).toQString().arg(i + 1);
+    auto writePage = [&out](size_t pageIndex, const QByteArray& pageData) -> Ret {
+        const QString filePath = io::path_t(io::dirpath(out) + "/" + io::basename(out) + "-%1." + io::suffix(out)).toQString().arg(pageIndex + 1);
 
         QFile file(filePath);
         if (!file.open(QFile::WriteOnly)) {
             return make_ret(Err::OutFileFailedOpen);
         }
 
-        INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-        };
-
-        file.setProperty("path", out.toQString());
-
-        Ret ret = writer->write(notation, file, options);
-        if (!ret) {
-            LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
+        if (file.write(pageData) != pageData.size()) {
+            LOGE() << "failed write, path: " << filePath;
             return make_ret(Err::OutFileFailedWrite);
         }
 
         file.close();
+
+        return make_ret(Ret::Code::Ok);
+    };
+
+    Ret ret = writer->writePages(notation, writePage);
+    if (!ret) {
+        LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
+        return ret.code() == static_cast<int>(Err::OutFileFailedOpen) ? ret : make_ret(Err::OutFileFailedWrite);
     }
 
     return make_ret(Ret::Code::Ok);
@@ -284,11 +342,11 @@ mu::Ret ConverterController::convertScorePartsToPngs(INotationWriterPtr writer,
 
 mu::Ret ConverterController::exportScoreMedia(const mu::io::path_t& in, const mu::io::path_t& out,
                                               const mu::io::path_t& highlightConfigPath,
-                                              const io::path_t& stylePath, bool forceMode)
+                                              const io::path_t& stylePath, bool forceMode, bool concurrentMode)
 {
     TRACEFUNC;
 
-    return BackendApi::exportScoreMedia(in, out, highlightConfigPath, stylePath, forceMode);
+    return BackendApi::exportScoreMedia(in, out, highlightConfigPath, stylePath, forceMode, concurrentMode);
 }
 
 mu::Ret ConverterController::exportScoreMeta(const mu::io::path_t& in, const mu::io::path_t& out, const io::path_t& stylePath,
@@ -359,3 +417,186 @@ mu::Ret ConverterController::updateSource(const io::path_t& in, const std::strin
 
     return BackendApi::updateSource(in, newSource, forceMode);
 }
+
+mu::Ret ConverterController::runServer(const io::path_t& stylePath, bool forceMode, size_t maxPendingJobs)
+{
+    TRACEFUNC;
+
+    //! NOTE Project loading, layout and the object allocators are not thread safe,
+    //! so jobs are converted one by one on this thread. The reader thread parses
+    //! up to `maxPendingJobs` lines ahead, so the next job is ready as soon as
+    //! the previous one is done, and blocks (back pressure) when the queue is full.
+    std::mutex mutex;
+    std::condition_variable queueChanged;
+    std::deque<std::string> lines;
+
+    //! NOTE stdout carries only the job results, the console log (and anything else written to std::cout)
+    //! goes to stderr while the server runs, so the client can parse every stdout line as a result
+    std::ostream results(std::cout.rdbuf());
+    std::streambuf* coutBuf = std::cout.rdbuf(std::cerr.rdbuf());
+    bool inputFinished = false;
+
+    std::thread reader([&]() {
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            if (line.empty()) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            queueChanged.wait(lock, [&]() { return lines.size() < maxPendingJobs; });
+            lines.push_back(std::move(line));
+            queueChanged.notify_all();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        inputFinished = true;
+        queueChanged.notify_all();
+    });
+
+    LOGI() << "converter server started, max pending jobs: " << maxPendingJobs;
+
+    size_t processed = 0;
+    size_t failed = 0;
+
+    while (true) {
+        std::string line;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            queueChanged.wait(lock, [&]() { return !lines.empty() || inputFinished; });
+            if (lines.empty()) {
+                break;
+            }
+
+            line = std::move(lines.front());
+            lines.pop_front();
+            queueChanged.notify_all();
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+
+        QJsonObject result;
+        RetVal<ServerJob> job = parseServerJob(line);
+        Ret ret = job.ret;
+        if (ret) {
+            if (job.val.stylePath.empty()) {
+                job.val.stylePath = stylePath;
+            }
+            job.val.forceMode = job.val.forceMode || forceMode;
+
+            result["id"] = QString::fromStdString(job.val.id);
+            ret = processServerJob(job.val);
+        }
+
+        cleanupAfterServerJob();
+
+        ++processed;
+        if (!ret) {
+            ++failed;
+            LOGE() << "failed job: " << line << ", err: " << ret.toString();
+        }
+
+        result["ok"] = ret.success();
+        result["code"] = ret.code();
+        if (!ret.text().empty()) {
+            result["error"] = QString::fromStdString(ret.text());
+        }
+        result["elapsedMs"] = static_cast<qint64>(timer.elapsed());
+
+        results << QJsonDocument(result).toJson(QJsonDocument::Compact).toStdString() << std::endl;
+    }
+
+    reader.join();
+
+    LOGI() << "converter server finished, processed jobs: " << processed << ", failed: " << failed;
+
+    std::cout.rdbuf(coutBuf);
+
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::RetVal<ConverterController::ServerJob> ConverterController::parseServerJob(const std::string& line) const
+{
+    RetVal<ServerJob> rv;
+
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(QByteArray::fromStdString(line), &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+        rv.ret = make_ret(Err::BatchJobFileFailedParse, err.errorString().toStdString());
+        return rv;
+    }
+
+    QJsonObject obj = doc.object();
+
+    ServerJob& job = rv.val;
+    job.id = obj["id"].toVariant().toString().toStdString();
+    job.type = obj["type"].toString("convert").toStdString();
+    job.in = obj["in"].toString();
+    job.out = parseOutPaths(obj["out"]);
+    job.stylePath = obj["style"].toString();
+    job.forceMode = obj["force"].toBool(false);
+
+    QJsonValue options = obj["options"];
+    if (options.isObject()) {
+        job.options = QJsonDocument(options.toObject()).toJson(QJsonDocument::Compact).toStdString();
+    } else {
+        job.options = options.toString().toStdString();
+    }
+
+    //! NOTE stdout is reserved for job results, so every job must write to a file
+    if (job.in.empty() || job.out.empty()) {
+        rv.ret = make_ret(Err::BatchJobFileFailedParse, "job must have both \"in\" and \"out\"");
+        return rv;
+    }
+
+    //! NOTE Only a plain conversion writes several files, like the batch job
+    if (job.type != "convert" && job.out.size() > 1) {
+        rv.ret = make_ret(Err::BatchJobFileFailedParse, "job of type \"" + job.type + "\" must have a single \"out\"");
+        return rv;
+    }
+
+    rv.ret = make_ret(Ret::Code::Ok);
+    return rv;
+}
+
+mu::Ret ConverterController::processServerJob(const ServerJob& job)
+{
+    TRACEFUNC;
+
+    if (job.type == "convert") {
+        return fileConvert(job.in, job.out, job.stylePath, job.forceMode);
+    } else if (job.type == "convert-parts") {
+        return convertScoreParts(job.in, job.out.front(), job.stylePath, job.forceMode);
+    } else if (job.type == "score-media") {
+        return exportScoreMedia(job.in, job.out.front(), io::path_t(), job.stylePath, job.forceMode);
+    } else if (job.type == "score-meta") {
+        return exportScoreMeta(job.in, job.out.front(), job.stylePath, job.forceMode);
+    } else if (job.type == "score-parts") {
+        return exportScoreParts(job.in, job.out.front(), job.stylePath, job.forceMode);
+    } else if (job.type == "score-parts-pdf") {
+        return exportScorePartsPdfs(job.in, job.out.front(), job.stylePath, job.forceMode);
+    } else if (job.type == "score-transpose") {
+        return exportScoreTranspose(job.in, job.out.front(), job.options, job.stylePath, job.forceMode);
+    }
+
+    return make_ret(Err::ConvertTypeUnknown, job.type);
+}
+
+void ConverterController::cleanupAfterServerJob()
+{
+    //! NOTE fileConvert makes the loaded project current, release it so the score is destroyed now
+    globalContext()->setCurrentProject(nullptr);
+
+    //! NOTE Reclaim the objects leaked by the job. Only when no engraving project is alive,
+    //! otherwise the allocator would destroy objects that are still in use
+    if (ObjectAllocator::used > 0) {
+        return;
+    }
+
+    //! NOTE The allocator stays enabled while the leaked objects are destroyed,
+    //! so the objects deleted by their destructors go back to it and not to the heap
+    ObjectAllocator::used++;
+    AllocatorsRegister::instance()->cleanupAll("engraving");
+    ObjectAllocator::used--;
+}
@@ -31,6 +31,7 @@
 #include "project/inotationwritersregister.h"
 #include "project/iprojectrwregister.h"
 #include "context/iglobalcontext.h"
+#include "importexport/audioexport/iaudioexportservice.h"
 
 #include "types/retval.h"
 
@@ -41,19 +42,22 @@ class ConverterController : public IConverterController
     INJECT(converter, project::INotationWritersRegister, writers)
     INJECT(converter, project::IProjectRWRegister, projectRW)
     INJECT(converter, context::IGlobalContext, globalContext)
+    INJECT(converter, iex::audioexport::IAudioExportService, audioExportService)
 
 public:
     ConverterController() = default;
 
     Ret fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                     bool forceMode = false) override;
+    Ret fileConvert(const io::path_t& in, const io::paths_t& outs, const io::path_t& stylePath = io::path_t(),
+                    bool forceMode = false) override;
     Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false) override;
     Ret convertScoreParts(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                           bool forceMode = false) override;
 
     Ret exportScoreMedia(const io::path_t& in, const io::path_t& out,
                          const io::path_t& highlightConfigPath = io::path_t(), const io::path_t& stylePath = io::path_t(),
-                         bool forceMode = false) override;
+                         bool forceMode = false, bool concurrentMode = false) override;
     Ret exportScoreMeta(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                         bool forceMode = false) override;
     Ret exportScoreParts(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
@@ -67,17 +71,33 @@ public:
 
     Ret updateSource(const io::path_t& in, const std::string& newSource, bool forceMode = false) override;
 
+    Ret runServer(const io::path_t& stylePath = io::path_t(), bool forceMode = false, size_t maxPendingJobs = 4) override;
+
 private:
 
     struct Job {
         io::path_t in;
-        io::path_t out;
+        io::paths_t out;
     };
 
     using BatchJob = std::list<Job>;
 
     RetVal<BatchJob> parseBatchJob(const io::path_t& batchJobFile) const;
 
+    struct ServerJob {
+        std::string id;
+        std::string type;
+        io::path_t in;
+        io::paths_t out;
+        std::string options;
+        io::path_t stylePath;
+        bool forceMode = false;
+    };
+
+    RetVal<ServerJob> parseServerJob(const std::string& line) const;
+    Ret processServerJob(const ServerJob& job);
+    void cleanupAfterServerJob();
+
     bool isConvertPageByPage(const std::string& suffix) const;
     Ret convertPageByPage(project::INotationWriterPtr writer, notation::INotationPtr notation, const io::path_t& out) const;
     Ret convertFullNotation(project::INotationWriterPtr writer, notation::INotationPtr notation, const io::path_t& out) const;
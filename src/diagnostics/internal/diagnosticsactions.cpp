@@ -58,6 +58,16 @@ const UiActionList DiagnosticsActions::m_actions = {
              mu::context::UiCtxAny,
              mu::context::CTX_ANY,
              TranslatableString("action", "Engraving &elements")
+             ),
+    UiAction("diagnostic-text-layout-cache-dump",
+             mu::context::UiCtxAny,
+             mu::context::CTX_ANY,
+             TranslatableString("action", "Text layout cache &stats")
+             ),
+    UiAction("diagnostic-midi-input-latency-dump",
+             mu::context::UiCtxAny,
+             mu::context::CTX_ANY,
+             TranslatableString("action", "MIDI input &latency")
              )
 };
 
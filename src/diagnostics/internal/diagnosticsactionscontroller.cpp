@@ -25,6 +25,11 @@
 
 #include "view/diagnosticaccessiblemodel.h"
 
+#include "engraving/libmscore/textlayoutcache.h"
+#include "midi/midiinputlatency.h"
+
+#include "log.h"
+
 using namespace mu::diagnostics;
 using namespace mu::accessibility;
 
@@ -42,6 +47,33 @@ void DiagnosticsActionsController::init()
     dispatcher()->reg(this, "diagnostic-show-accessible-tree", [this]() { openUri(ACCESSIBLE_TREE_URI); });
     dispatcher()->reg(this, "diagnostic-accessible-tree-dump", []() { DiagnosticAccessibleModel::dumpTree(); });
     dispatcher()->reg(this, "diagnostic-show-engraving-elements", [this]() { openUri(ENGRAVING_ELEMENTS_URI, false); });
+    dispatcher()->reg(this, "diagnostic-text-layout-cache-dump", []() { dumpTextLayoutCacheStats(); });
+    dispatcher()->reg(this, "diagnostic-midi-input-latency-dump", []() { dumpMidiInputLatency(); });
+}
+
+void DiagnosticsActionsController::dumpTextLayoutCacheStats()
+{
+    engraving::TextLayoutCache::Stats stats = engraving::TextLayoutCache::instance()->stats();
+    LOGI() << "text layout cache: size: " << stats.size
+           << ", hits: " << stats.hits
+           << ", misses: " << stats.misses
+           << ", hit rate: " << stats.hitRate();
+}
+
+void DiagnosticsActionsController::dumpMidiInputLatency()
+{
+    using Latency = midi::MidiInputLatency;
+
+    auto dump = [](const char* name, Latency::Stage stage) {
+        Latency::Stats stats = Latency::instance()->stats(stage);
+        LOGI() << "midi input latency, " << name << ": count: " << stats.count
+               << ", mean: " << stats.meanMs << " ms"
+               << ", max: " << stats.maxMs << " ms";
+    };
+
+    dump("delivered", Latency::Stage::Delivered);
+    dump("previewed", Latency::Stage::Previewed);
+    dump("inserted", Latency::Stage::Inserted);
 }
 
 void DiagnosticsActionsController::openUri(const mu::UriQuery& uri, bool isSingle)
@@ -41,6 +41,8 @@ public:
 
 private:
     void openUri(const mu::UriQuery& uri, bool isSingle = true);
+    static void dumpTextLayoutCacheStats();
+    static void dumpMidiInputLatency();
 };
 }
 
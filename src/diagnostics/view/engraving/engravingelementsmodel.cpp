@@ -21,11 +21,13 @@
  */
 #include "engravingelementsmodel.h"
 
+#include <QSet>
 #include <QTextStream>
 
 #include "engraving/libmscore/engravingobject.h"
 #include "engraving/libmscore/score.h"
 #include "engraving/libmscore/masterscore.h"
+#include "engraving/libmscore/undo.h"
 #include "dataformatter.h"
 
 #include "log.h"
@@ -338,8 +340,13 @@ void EngravingElementsModel::updateInfo()
 {
     const EngravingObjectList& elements = elementsProvider()->elements();
     QHash<QString, int> els;
+    QSet<const mu::engraving::MasterScore*> masterScores;
     for (const mu::engraving::EngravingObject* el : elements) {
         els[el->typeName()] += 1;
+
+        if (const mu::engraving::MasterScore* masterScore = el->masterScore()) {
+            masterScores.insert(masterScore);
+        }
     }
 
     {
@@ -354,6 +361,13 @@ void EngravingElementsModel::updateInfo()
         m_summary.clear();
         QTextStream stream(&m_summary);
         stream << "Total: " << elements.size();
+
+        for (const mu::engraving::MasterScore* masterScore : masterScores) {
+            const mu::engraving::UndoStack* undoStack = masterScore->undoStack();
+            stream << "\nUndo stack: " << undoStack->macroCount() << " steps"
+                   << ", ~" << (undoStack->memoryUsage() / 1024) << " KB"
+                   << ", evicted: " << undoStack->evictedMacroCount();
+        }
     }
 
     emit infoChanged();
@@ -87,6 +87,10 @@ public:
     virtual async::Notification debuggingOptionsChanged() const = 0;
 
     virtual bool isAccessibleEnabled() const = 0;
+
+    //! NOTE in bytes, 0 means unlimited
+    virtual size_t undoHistoryMemoryLimit() const = 0;
+    virtual async::Notification undoHistoryMemoryLimitChanged() const = 0;
 };
 }
 
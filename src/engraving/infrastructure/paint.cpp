@@ -23,8 +23,12 @@
 
 #include "draw/painter.h"
 #include "libmscore/engravingitem.h"
+#include "libmscore/page.h"
+#include "libmscore/score.h"
+#include "libmscore/system.h"
 
 #include "debugpaint.h"
+#include "systemdisplaylist.h"
 
 #include "log.h"
 #include "config.h"
@@ -66,3 +70,31 @@ void Paint::paintElements(mu::draw::Painter& painter, const std::vector<Engravin
     UNUSED(isPrinting);
 #endif
 }
+
+void Paint::paintPage(mu::draw::Painter& painter, const Page* page, const RectF& rect, bool isPrinting)
+{
+    //! NOTE The page itself draws the header and the footer
+    if (page->isInteractionAvailable() && page->pageBoundingRect().intersects(rect)) {
+        paintElement(painter, page);
+    }
+
+    //! NOTE The refreshed areas are recorded again before the first page is painted
+    page->score()->applyDisplayListRefresh();
+
+    //! NOTE The items of all the systems are painted together, in the z order of the page
+    std::vector<std::shared_ptr<SystemDisplayList> > lists;
+    for (const System* system : page->systems()) {
+        lists.push_back(system->displayList());
+    }
+    SystemDisplayList::paint(painter, lists, rect);
+
+#ifdef ENGRAVING_PAINT_DEBUGGER_ENABLED
+    if (!isPrinting) {
+        std::vector<EngravingItem*> elements = const_cast<Page*>(page)->items(rect);
+        std::sort(elements.begin(), elements.end(), mu::engraving::elementLessThan);
+        DebugPaint::paintElementsDebug(painter, elements);
+    }
+#else
+    UNUSED(isPrinting);
+#endif
+}
@@ -27,12 +27,17 @@
 
 namespace mu::engraving {
 class EngravingItem;
+class Page;
 
 class Paint
 {
 public:
     static void paintElement(mu::draw::Painter& painter, const EngravingItem* element);
     static void paintElements(mu::draw::Painter& painter, const std::vector<EngravingItem*>& elements, bool isPrinting);
+
+    //! NOTE Paints the page items in the rect (page coordinates),
+    //! the items of the systems are painted from the display lists of the systems
+    static void paintPage(mu::draw::Painter& painter, const Page* page, const RectF& rect, bool isPrinting);
 };
 }
 
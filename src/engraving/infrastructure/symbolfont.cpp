@@ -28,6 +28,7 @@
 #include "types/symnames.h"
 
 #include "libmscore/mscore.h"
+#include "libmscore/textlayoutcache.h"
 
 #include "symbolfonts.h"
 #include "smufl.h"
@@ -100,6 +101,9 @@ void SymbolFont::load()
         return;
     }
 
+    //! NOTE Texts measured with a fallback for this font must be measured again
+    TextLayoutCache::instance()->clear();
+
     m_font.setWeight(mu::draw::Font::Normal);
     m_font.setItalic(false);
     m_font.setFamily(m_family);
@@ -0,0 +1,296 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "systemdisplaylist.h"
+
+#include <algorithm>
+
+#include "draw/bufferedpaintprovider.h"
+#include "draw/painter.h"
+#include "draw/utils/drawdatapaint.h"
+
+#include "libmscore/engravingitem.h"
+#include "libmscore/measurebase.h"
+#include "libmscore/mscore.h"
+#include "libmscore/score.h"
+#include "libmscore/system.h"
+
+#include "paint.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::draw;
+using namespace mu::engraving;
+
+//---------------------------------------------------------
+//   Key
+//---------------------------------------------------------
+
+SystemDisplayList::Key SystemDisplayList::Key::current(const Score* score)
+{
+    Key k;
+    k.printing = score->printing();
+    k.showInvisible = score->showInvisible();
+    k.showUnprintable = score->showUnprintable();
+    k.showFrames = score->showFrames();
+    k.pdfPrinting = MScore::pdfPrinting;
+    k.svgPrinting = MScore::svgPrinting;
+    k.pixelRatio = MScore::pixelRatio;
+
+    const std::shared_ptr<IEngravingConfiguration>& conf = EngravingItem::engravingConfiguration();
+    k.scoreInversion = conf->scoreInversionEnabled();
+    k.defaultColor = conf->defaultColor();
+    k.scoreInversionColor = conf->scoreInversionColor();
+    k.invisibleColor = conf->invisibleColor();
+    for (voice_idx_t voice = 0; voice < VOICES; ++voice) {
+        k.selectionColors[voice] = conf->selectionColor(voice, true);
+        k.invisibleSelectionColors[voice] = conf->selectionColor(voice, false);
+        k.highlightSelectionColors[voice] = conf->highlightSelectionColor(voice);
+    }
+
+    return k;
+}
+
+bool SystemDisplayList::Key::operator==(const Key& k) const
+{
+    return printing == k.printing
+           && showInvisible == k.showInvisible
+           && showUnprintable == k.showUnprintable
+           && showFrames == k.showFrames
+           && pdfPrinting == k.pdfPrinting
+           && svgPrinting == k.svgPrinting
+           && pixelRatio == k.pixelRatio
+           && scoreInversion == k.scoreInversion
+           && defaultColor == k.defaultColor
+           && scoreInversionColor == k.scoreInversionColor
+           && invisibleColor == k.invisibleColor
+           && selectionColors == k.selectionColors
+           && invisibleSelectionColors == k.invisibleSelectionColors
+           && highlightSelectionColors == k.highlightSelectionColors;
+}
+
+//---------------------------------------------------------
+//   SystemDisplayList
+//    collects the items the same way as the page does
+//    for its bsp tree, in the paint order
+//---------------------------------------------------------
+
+SystemDisplayList::SystemDisplayList(const System* system, const Key& key)
+    : m_key(key)
+{
+    TRACEFUNC;
+
+    std::vector<EngravingItem*> elements;
+    System* s = const_cast<System*>(system);
+    for (MeasureBase* mb : s->measures()) {
+        mb->scanElements(&elements, collectElements, false);
+    }
+    s->scanElements(&elements, collectElements, false);
+
+    //! NOTE Some items are reported more than once (the bsp tree skips them by EngravingItem::itemDiscovered)
+    std::sort(elements.begin(), elements.end());
+    elements.erase(std::unique(elements.begin(), elements.end()), elements.end());
+    std::sort(elements.begin(), elements.end(), elementLessThan);
+
+    m_items.reserve(elements.size());
+    for (const EngravingItem* e : elements) {
+        if (!e->isInteractionAvailable()) {
+            continue;
+        }
+
+        Item item;
+        item.item = e;
+        item.bbox = e->pageBoundingRect();
+        m_bbox.unite(item.bbox);
+        m_items.push_back(std::move(item));
+    }
+}
+
+//---------------------------------------------------------
+//   paint
+//---------------------------------------------------------
+
+void SystemDisplayList::paint(Painter& painter, const RectF& rect, const ItemFilter& filter)
+{
+    paintItems(painter, { this }, &rect, filter);
+}
+
+void SystemDisplayList::paint(Painter& painter, const ItemFilter& filter)
+{
+    paintItems(painter, { this }, nullptr, filter);
+}
+
+void SystemDisplayList::paint(Painter& painter, const std::vector<std::shared_ptr<SystemDisplayList> >& lists, const RectF& rect,
+                              const ItemFilter& filter)
+{
+    std::vector<SystemDisplayList*> rawLists;
+    for (const std::shared_ptr<SystemDisplayList>& list : lists) {
+        rawLists.push_back(list.get());
+    }
+
+    paintItems(painter, rawLists, &rect, filter);
+}
+
+void SystemDisplayList::paint(Painter& painter, const std::vector<std::shared_ptr<SystemDisplayList> >& lists, const ItemFilter& filter)
+{
+    std::vector<SystemDisplayList*> rawLists;
+    for (const std::shared_ptr<SystemDisplayList>& list : lists) {
+        rawLists.push_back(list.get());
+    }
+
+    paintItems(painter, rawLists, nullptr, filter);
+}
+
+void SystemDisplayList::paintItems(Painter& painter, const std::vector<SystemDisplayList*>& lists, const RectF* rect,
+                                   const ItemFilter& filter)
+{
+    //! NOTE The lists are always locked in the given (page) order
+    std::vector<std::unique_lock<std::mutex> > locks;
+    locks.reserve(lists.size());
+
+    std::vector<Item*> visibleItems;
+    for (SystemDisplayList* list : lists) {
+        locks.emplace_back(list->m_mutex);
+
+        std::vector<Item*> notRecorded;
+        for (Item& item : list->m_items) {
+            if (rect && !item.bbox.intersects(*rect)) {
+                continue;
+            }
+
+            visibleItems.push_back(&item);
+            if (!item.recorded && !isPaintedDirectly(item.item, painter)) {
+                notRecorded.push_back(&item);
+            }
+        }
+
+        //! NOTE The extended provider (debugging, automated testing) expects the items to be drawn
+        if (!Painter::extended && !notRecorded.empty()) {
+            list->record(notRecorded);
+        }
+    }
+
+    //! NOTE The items of a list are in z order already, the items of several lists
+    //! are merged into the z order of the page (a system may overlap the next one)
+    if (lists.size() > 1) {
+        std::stable_sort(visibleItems.begin(), visibleItems.end(), [](const Item* item1, const Item* item2) {
+            return elementLessThan(item1->item, item2->item);
+        });
+    }
+
+    for (const Item* item : visibleItems) {
+        if (filter && !filter(item->item)) {
+            continue;
+        }
+
+        if (Painter::extended || isPaintedDirectly(item->item, painter)) {
+            Paint::paintElement(painter, item->item);
+            continue;
+        }
+
+        for (const DrawData::Object& obj : item->objects) {
+            DrawDataPaint::paint(painter, obj);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   isPaintedDirectly
+//    the records are made with the identity transform;
+//    the image is scaled to the device pixels and the bold
+//    text is drawn by the workaround when zoomed out
+//    (see Image::draw, TextBase::drawTextWorkaround)
+//---------------------------------------------------------
+
+bool SystemDisplayList::isPaintedDirectly(const EngravingItem* item, const Painter& painter)
+{
+    if (item->isImage()) {
+        return true;
+    }
+
+#ifndef Q_OS_MACOS
+    if (item->isTextBase() && !MScore::pdfPrinting && painter.worldTransform().m11() < 1.0) {
+        return true;
+    }
+#else
+    UNUSED(painter);
+#endif
+
+    return false;
+}
+
+//---------------------------------------------------------
+//   record
+//---------------------------------------------------------
+
+void SystemDisplayList::record(const std::vector<Item*>& items)
+{
+    TRACEFUNC;
+
+    std::shared_ptr<BufferedPaintProvider> buf = std::make_shared<BufferedPaintProvider>();
+    Painter painter(buf, "systemdisplaylist");
+
+    for (Item* item : items) {
+        size_t firstObject = buf->drawData().objects.size();
+
+        painter.beginObject(item->item->typeName(), item->item->pagePos());
+        //! NOTE All the notation painters paint with antialiasing
+        painter.setAntialiasing(true);
+        Paint::paintElement(painter, item->item);
+        painter.endObject();
+
+        const std::vector<DrawData::Object>& objects = buf->drawData().objects;
+        item->objects.assign(objects.begin() + firstObject, objects.end());
+        item->recorded = true;
+    }
+
+    painter.endDraw();
+}
+
+//---------------------------------------------------------
+//   invalidate
+//---------------------------------------------------------
+
+void SystemDisplayList::invalidate(const RectF& rect)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_bbox.intersects(rect)) {
+        return;
+    }
+
+    for (Item& item : m_items) {
+        if (item.recorded && item.bbox.intersects(rect)) {
+            item.recorded = false;
+            item.objects.clear();
+        }
+    }
+}
+
+size_t SystemDisplayList::recordedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return std::count_if(m_items.begin(), m_items.end(), [](const Item& item) {
+        return item.recorded;
+    });
+}
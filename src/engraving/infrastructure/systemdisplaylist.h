@@ -0,0 +1,134 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_SYSTEMDISPLAYLIST_H
+#define MU_ENGRAVING_SYSTEMDISPLAYLIST_H
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "draw/buffereddrawtypes.h"
+#include "draw/types/color.h"
+#include "draw/types/geometry.h"
+
+#include "libmscore/mscore.h"
+
+namespace mu::draw {
+class Painter;
+}
+
+namespace mu::engraving {
+class EngravingItem;
+class Score;
+class System;
+
+//---------------------------------------------------------
+//   SystemDisplayList
+//    recorded painting of the items of a system;
+//    an item is recorded when it is painted the first time,
+//    later paints (other zoom, other device, other export
+//    format) replay the record instead of drawing the item
+//
+//    the records refer to the items of the system, so the
+//    list must not be painted while the score is laid out
+//    or edited (same as for painting the items directly);
+//    the list itself is guarded, it may be invalidated
+//    from another thread than it is painted from
+//---------------------------------------------------------
+
+class SystemDisplayList
+{
+public:
+    //! NOTE The global paint state the drawing of the items depends on,
+    //! the records are only valid for the state they were made with
+    struct Key {
+        bool printing = false;
+        bool showInvisible = false;
+        bool showUnprintable = false;
+        bool showFrames = false;
+        bool pdfPrinting = false;
+        bool svgPrinting = false;
+        double pixelRatio = 1.0;
+
+        //! NOTE The colors of EngravingItem::curColor()
+        bool scoreInversion = false;
+        mu::draw::Color defaultColor;
+        mu::draw::Color scoreInversionColor;
+        mu::draw::Color invisibleColor;
+        std::array<mu::draw::Color, VOICES> selectionColors;
+        std::array<mu::draw::Color, VOICES> invisibleSelectionColors;
+        std::array<mu::draw::Color, VOICES> highlightSelectionColors;
+
+        static Key current(const Score* score);
+
+        bool operator==(const Key& k) const;
+        bool operator!=(const Key& k) const { return !this->operator==(k); }
+    };
+
+    //! NOTE Return false to skip the item, is called before the item is painted
+    using ItemFilter = std::function<bool (const EngravingItem* item)>;
+
+    SystemDisplayList(const System* system, const Key& key);
+
+    const Key& key() const { return m_key; }
+
+    //! NOTE Paints the items intersecting the rect, the rect is in page coordinates
+    void paint(mu::draw::Painter& painter, const RectF& rect, const ItemFilter& filter = nullptr);
+    void paint(mu::draw::Painter& painter, const ItemFilter& filter = nullptr);
+
+    //! NOTE Paints the items of the lists (the systems of a page) together, in the z order of the page
+    static void paint(mu::draw::Painter& painter, const std::vector<std::shared_ptr<SystemDisplayList> >& lists, const RectF& rect,
+                      const ItemFilter& filter = nullptr);
+    static void paint(mu::draw::Painter& painter, const std::vector<std::shared_ptr<SystemDisplayList> >& lists,
+                      const ItemFilter& filter = nullptr);
+
+    //! NOTE The items intersecting the rect (page coordinates) will be recorded again
+    void invalidate(const RectF& rect);
+
+    size_t recordedCount() const;
+
+    //! NOTE The drawing of these items depends on the world transform of the painter,
+    //! they are painted directly instead of being replayed
+    static bool isPaintedDirectly(const EngravingItem* item, const mu::draw::Painter& painter);
+
+private:
+    struct Item {
+        const EngravingItem* item = nullptr;
+        RectF bbox;
+        bool recorded = false;
+        std::vector<mu::draw::DrawData::Object> objects;
+    };
+
+    static void paintItems(mu::draw::Painter& painter, const std::vector<SystemDisplayList*>& lists, const RectF* rect,
+                           const ItemFilter& filter);
+    void record(const std::vector<Item*>& items);
+
+    Key m_key;
+    RectF m_bbox; // of all the items, page coordinates
+    std::vector<Item> m_items;
+    mutable std::mutex m_mutex;
+};
+}
+
+#endif // MU_ENGRAVING_SYSTEMDISPLAYLIST_H
@@ -36,6 +36,8 @@ static const Settings::Key PART_STYLE_FILE_PATH("engraving", "engraving/style/pa
 
 static const Settings::Key INVERT_SCORE_COLOR("engraving", "engraving/scoreColorInversion");
 
+static const Settings::Key UNDO_HISTORY_MEMORY_LIMIT_MB("engraving", "engraving/undoHistoryMemoryLimitMb");
+
 struct VoiceColorKey {
     Settings::Key key;
     Color color;
@@ -53,6 +55,11 @@ void EngravingConfiguration::init()
     };
 
     settings()->setDefaultValue(INVERT_SCORE_COLOR, Val(false));
+    settings()->setDefaultValue(UNDO_HISTORY_MEMORY_LIMIT_MB, Val(512));
+    settings()->setCanBeManuallyEdited(UNDO_HISTORY_MEMORY_LIMIT_MB, true);
+    settings()->valueChanged(UNDO_HISTORY_MEMORY_LIMIT_MB).onReceive(this, [this](const Val&) {
+        m_undoHistoryMemoryLimitChanged.notify();
+    });
     settings()->valueChanged(INVERT_SCORE_COLOR).onReceive(nullptr, [this](const Val&) {
         m_scoreInversionChanged.notify();
     });
@@ -230,3 +237,14 @@ bool EngravingConfiguration::isAccessibleEnabled() const
 {
     return accessibilityConfiguration() ? accessibilityConfiguration()->enabled() : false;
 }
+
+size_t EngravingConfiguration::undoHistoryMemoryLimit() const
+{
+    int limitMb = settings()->value(UNDO_HISTORY_MEMORY_LIMIT_MB).toInt();
+    return limitMb > 0 ? static_cast<size_t>(limitMb) * 1024 * 1024 : 0;
+}
+
+mu::async::Notification EngravingConfiguration::undoHistoryMemoryLimitChanged() const
+{
+    return m_undoHistoryMemoryLimitChanged;
+}
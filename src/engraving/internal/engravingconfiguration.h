@@ -84,9 +84,13 @@ public:
 
     bool isAccessibleEnabled() const override;
 
+    size_t undoHistoryMemoryLimit() const override;
+    async::Notification undoHistoryMemoryLimitChanged() const override;
+
 private:
     async::Channel<voice_idx_t, draw::Color> m_voiceColorChanged;
     async::Notification m_scoreInversionChanged;
+    async::Notification m_undoHistoryMemoryLimitChanged;
 
     ValNt<DebuggingOptions> m_debuggingOptions;
 };
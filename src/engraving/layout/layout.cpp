@@ -71,7 +71,7 @@ Layout::Layout(Score* score)
 {
 }
 
-void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, const Fraction& et)
+Layout::Range Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, const Fraction& et)
 {
     CmdStateLocker cmdStateLocker(m_score);
     LayoutContext ctx(m_score);
@@ -87,7 +87,7 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
         DeleteAll(m_score->pages());
         m_score->pages().clear();
         LayoutPage::getNextPage(options, ctx);
-        return;
+        return { Fraction(0, 1), Fraction(-1, 1) };
     }
 
     bool layoutAll = stick <= Fraction(0, 1) && (etick < Fraction(0, 1) || etick >= m_score->masterScore()->last()->endTick());
@@ -141,9 +141,11 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
         ctx.nextMeasure = m;         //_showVBox ? first() : firstMeasure();
         ctx.startTick   = m->tick();
         layoutLinear(layoutAll, options, ctx);
-        return;
+        return { Fraction(0, 1), Fraction(-1, 1) };
     }
 
+    Range range { Fraction(0, 1), Fraction(-1, 1) };
+
     if (!layoutAll && m->system()) {
         System* system = m->system();
         system_idx_t systemIndex = mu::indexOf(m_score->_systems, system);
@@ -155,6 +157,11 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
         ctx.curSystem   = system;
         ctx.systemList  = mu::mid(m_score->_systems, systemIndex);
 
+        //! NOTE The systems above on the same page are placed again too
+        if (!ctx.page->systems().empty()) {
+            range.startTick = ctx.page->systems().front()->measures().front()->tick();
+        }
+
         if (systemIndex == 0) {
             ctx.nextMeasure = options.showVBox ? m_score->first() : m_score->firstMeasure();
         } else {
@@ -217,6 +224,13 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
     ctx.curSystem = LayoutSystem::collectSystem(options, ctx, m_score);
 
     doLayout(options, ctx);
+
+    //! NOTE The layout stopped at a page ending like before, the next pages are unchanged
+    if (ctx.curSystem && ctx.page && !ctx.page->systems().empty()) {
+        range.endTick = ctx.page->systems().back()->endTick();
+    }
+
+    return range;
 }
 
 void Layout::doLayout(const LayoutOptions& options, LayoutContext& lc)
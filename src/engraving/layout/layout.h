@@ -33,7 +33,14 @@ class Layout
 public:
     Layout(Score* score);
 
-    void doLayoutRange(const LayoutOptions& options, const Fraction&, const Fraction&);
+    //! NOTE The ticks of the pages laid out again, the systems outside of them did not change.
+    //! The endTick is -1 when the layout went on to the end of the score
+    struct Range {
+        Fraction startTick;
+        Fraction endTick;
+    };
+
+    Range doLayoutRange(const LayoutOptions& options, const Fraction&, const Fraction&);
 
 private:
 
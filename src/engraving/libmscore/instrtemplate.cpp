@@ -22,6 +22,8 @@
 
 #include "instrtemplate.h"
 
+#include <unordered_map>
+
 #include "io/file.h"
 
 #include "containers.h"
@@ -51,6 +53,15 @@ std::vector<InstrumentGenre*> instrumentGenres;
 std::vector<InstrumentFamily*> instrumentFamilies;
 std::vector<ScoreOrder> instrumentOrders;
 
+//! NOTE id -> first template with this id, in the order of instrumentGroups;
+//! kept in sync with the groups while the templates are being read
+static std::unordered_map<String, InstrumentTemplate*> instrumentTemplatesById;
+
+//! NOTE id -> position of the first template with this id in instrumentGroups;
+//! built once all the templates are read
+static std::unordered_map<String, InstrumentIndex> instrumentIndexesById;
+static int instrumentTemplatesCount = 0;
+
 //---------------------------------------------------------
 //   InstrumentIndex
 //---------------------------------------------------------
@@ -170,6 +181,7 @@ void InstrumentGroup::read(XmlReader& e)
                 instrumentTemplates.push_back(t);
             }
             t->read(e);
+            instrumentTemplatesById.emplace(t->id, t);
         } else if (tag == "ref") {
             InstrumentTemplate* ttt = searchTemplate(e.readText());
             if (ttt) {
@@ -645,6 +657,9 @@ void clearInstrumentTemplates()
     }
     DeleteAll(instrumentGroups);
     instrumentGroups.clear();
+    instrumentTemplatesById.clear();
+    instrumentIndexesById.clear();
+    instrumentTemplatesCount = 0;
     DeleteAll(instrumentGenres);
     instrumentGenres.clear();
     DeleteAll(instrumentFamilies);
@@ -653,8 +668,32 @@ void clearInstrumentTemplates()
     instrumentOrders.clear();
 }
 
+//---------------------------------------------------------
+//   updateInstrumentIndexes
+//---------------------------------------------------------
+
+static void updateInstrumentIndexes()
+{
+    instrumentIndexesById.clear();
+
+    int instIndex = 0;
+    int grpIndex = 0;
+    for (InstrumentGroup* g : instrumentGroups) {
+        for (InstrumentTemplate* it : g->instrumentTemplates) {
+            instrumentIndexesById.emplace(it->id, InstrumentIndex(grpIndex, instIndex, it));
+            ++instIndex;
+        }
+        ++grpIndex;
+    }
+
+    instrumentTemplatesCount = instIndex;
+}
+
 //---------------------------------------------------------
 //   loadInstrumentTemplates
+//      The templates are parsed from the XML on every load,
+//      there is no precompiled template database. The lookups
+//      by id, while reading and after, use the indexes above.
 //---------------------------------------------------------
 
 bool loadInstrumentTemplates(const io::path_t& instrTemplatesPath)
@@ -711,6 +750,8 @@ bool loadInstrumentTemplates(const io::path_t& instrTemplatesPath)
         }
     }
 
+    updateInstrumentIndexes();
+
     return true;
 }
 
@@ -720,14 +761,8 @@ bool loadInstrumentTemplates(const io::path_t& instrTemplatesPath)
 
 InstrumentTemplate* searchTemplate(const String& name)
 {
-    for (InstrumentGroup* g : instrumentGroups) {
-        for (InstrumentTemplate* it : g->instrumentTemplates) {
-            if (it->id == name) {
-                return it;
-            }
-        }
-    }
-    return 0;
+    auto it = instrumentTemplatesById.find(name);
+    return it != instrumentTemplatesById.end() ? it->second : nullptr;
 }
 
 //---------------------------------------------------------
@@ -834,18 +869,12 @@ InstrumentIndex searchTemplateIndexForTrackName(const String& trackName)
 
 InstrumentIndex searchTemplateIndexForId(const String& id)
 {
-    int instIndex = 0;
-    int grpIndex = 0;
-    for (InstrumentGroup* g : instrumentGroups) {
-        for (InstrumentTemplate* it : g->instrumentTemplates) {
-            if (it->id == id) {
-                return InstrumentIndex(grpIndex, instIndex, it);
-            }
-            ++instIndex;
-        }
-        ++grpIndex;
+    auto it = instrumentIndexesById.find(id);
+    if (it != instrumentIndexesById.end()) {
+        return it->second;
     }
-    return InstrumentIndex(-1, instIndex, nullptr);
+
+    return InstrumentIndex(-1, instrumentTemplatesCount, nullptr);
 }
 
 //---------------------------------------------------------
@@ -214,12 +214,16 @@ set(LIBMSCORE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/pitch.h
     ${CMAKE_CURRENT_LIST_DIR}/pitchspelling.cpp
     ${CMAKE_CURRENT_LIST_DIR}/pitchspelling.h
+    ${CMAKE_CURRENT_LIST_DIR}/playbacktimeline.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/playbacktimeline.h
     ${CMAKE_CURRENT_LIST_DIR}/playtechannotation.cpp
     ${CMAKE_CURRENT_LIST_DIR}/playtechannotation.h
     ${CMAKE_CURRENT_LIST_DIR}/pos.cpp
     ${CMAKE_CURRENT_LIST_DIR}/pos.h
     ${CMAKE_CURRENT_LIST_DIR}/property.cpp
     ${CMAKE_CURRENT_LIST_DIR}/property.h
+    ${CMAKE_CURRENT_LIST_DIR}/propertysummary.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/propertysummary.h
     ${CMAKE_CURRENT_LIST_DIR}/range.cpp
     ${CMAKE_CURRENT_LIST_DIR}/range.h
     ${CMAKE_CURRENT_LIST_DIR}/rasgueado.cpp
@@ -317,6 +321,8 @@ set(LIBMSCORE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/textedit.h
     ${CMAKE_CURRENT_LIST_DIR}/textframe.cpp
     ${CMAKE_CURRENT_LIST_DIR}/textframe.h
+    ${CMAKE_CURRENT_LIST_DIR}/textlayoutcache.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/textlayoutcache.h
     ${CMAKE_CURRENT_LIST_DIR}/textline.cpp
     ${CMAKE_CURRENT_LIST_DIR}/textline.h
     ${CMAKE_CURRENT_LIST_DIR}/textlinebase.cpp
@@ -38,6 +38,7 @@
 #include "part.h"
 #include "repeatlist.h"
 #include "sig.h"
+#include "system.h"
 #include "tempo.h"
 #include "undo.h"
 
@@ -56,6 +57,9 @@ MasterScore::MasterScore(std::weak_ptr<engraving::EngravingProject> project)
 {
     m_project = project;
     _undoStack   = new UndoStack();
+    if (configuration()) {
+        _undoStack->setMemoryLimit(configuration()->undoHistoryMemoryLimit());
+    }
     _tempomap    = new TempoMap;
     _sigmap      = new TimeSigMap();
     _repeatList  = new RepeatList(this);
@@ -167,6 +171,11 @@ void MasterScore::setPlaylistDirty()
     _playlistDirty = true;
     _repeatList->setScoreChanged();
     _repeatList2->setScoreChanged();
+
+    //! NOTE The repeats only change the times, the positions are kept
+    for (Score* score : scoreList()) {
+        score->invalidatePlaybackTimeline();
+    }
 }
 
 //---------------------------------------------------------
@@ -490,6 +499,12 @@ void MasterScore::setSoloMute()
 void MasterScore::setUpdateAll()
 {
     _cmdState.setUpdateMode(UpdateMode::UpdateAll);
+
+    for (Score* score : scoreList()) {
+        for (System* system : score->systems()) {
+            system->invalidateDisplayList();
+        }
+    }
 }
 
 //---------------------------------------------------------
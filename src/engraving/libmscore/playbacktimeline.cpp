@@ -0,0 +1,363 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "playbacktimeline.h"
+
+#include <algorithm>
+
+#include "measure.h"
+#include "mscore.h"
+#include "page.h"
+#include "repeatlist.h"
+#include "score.h"
+#include "segment.h"
+#include "staff.h"
+#include "system.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+//---------------------------------------------------------
+//   PlaybackTimeline
+//---------------------------------------------------------
+
+PlaybackTimeline::PlaybackTimeline(const Score* score)
+{
+    TRACEFUNC;
+
+    m_spatium = score->spatium();
+
+    buildTimes(score);
+    buildPositions(score, score->firstMeasureMM(), -1);
+}
+
+PlaybackTimeline::PlaybackTimeline(const Score* score, const PlaybackTimeline& previous, int startTick, int endTick)
+{
+    TRACEFUNC;
+
+    m_spatium = score->spatium();
+
+    buildTimes(score);
+
+    auto byTick = [](const SegmentEntry& e, int tick) {
+        return e.tick < tick;
+    };
+
+    auto first = std::lower_bound(previous.m_segments.cbegin(), previous.m_segments.cend(), startTick, byTick);
+    auto last = endTick < 0 ? previous.m_segments.cend()
+                : std::lower_bound(first, previous.m_segments.cend(), endTick, byTick);
+
+    m_segments.reserve(previous.m_segments.size());
+    m_segments.insert(m_segments.end(), previous.m_segments.cbegin(), first);
+
+    if (endTick < 0 || startTick < endTick) {
+        buildPositions(score, score->tick2measureMM(Fraction::fromTicks(startTick)), endTick);
+    }
+
+    m_segments.insert(m_segments.end(), last, previous.m_segments.cend());
+}
+
+//---------------------------------------------------------
+//   buildTimes
+//    same as RepeatList::updateTempo, but on a copy of the
+//    tempo map, so the times do not change with the score
+//---------------------------------------------------------
+
+void PlaybackTimeline::buildTimes(const Score* score)
+{
+    const RepeatList& repeatList = score->repeatList();
+    const TempoMap* tempomap = score->tempomap();
+
+    m_playRepeats = MScore::playRepeats;
+    m_tempoSN = tempomap->tempoSN();
+    m_endTick = score->endTick().ticks();
+    m_tempomap = *tempomap;
+
+    int utick = 0;
+    double utime = 0.0;
+
+    m_repeats.reserve(repeatList.size());
+    for (const RepeatSegment* rs : repeatList) {
+        RepeatEntry e;
+        e.utick = utick;
+        e.tick = rs->tick;
+        e.len = rs->len();
+        e.utime = utime;
+
+        double ct = m_tempomap.tick2time(e.tick);
+        e.timeOffset = utime - ct;
+        utick += e.len;
+        utime += m_tempomap.tick2time(e.tick + e.len) - ct;
+
+        m_repeats.push_back(e);
+    }
+
+    m_ticks = utick;
+    m_duration = utick2utime(m_ticks);
+
+    //! NOTE Split the ticks at the borders of the repeat segments,
+    //! every range is played first by the first repeat segment containing it
+    std::vector<int> borders;
+    borders.reserve(m_repeats.size() * 2);
+    for (const RepeatEntry& e : m_repeats) {
+        borders.push_back(e.tick);
+        borders.push_back(e.tick + e.len);
+    }
+
+    std::sort(borders.begin(), borders.end());
+    borders.erase(std::unique(borders.begin(), borders.end()), borders.end());
+
+    for (size_t i = 0; i + 1 < borders.size(); ++i) {
+        int tick = borders[i];
+        auto e = std::find_if(m_repeats.cbegin(), m_repeats.cend(), [tick](const RepeatEntry& e) {
+            return tick >= e.tick && tick < e.tick + e.len;
+        });
+
+        if (e == m_repeats.cend()) {
+            continue;
+        }
+
+        int utickOffset = e->utick - e->tick;
+        if (!m_tickRanges.empty() && m_tickRanges.back().endTick == tick && m_tickRanges.back().utickOffset == utickOffset) {
+            m_tickRanges.back().endTick = borders[i + 1];
+        } else {
+            m_tickRanges.push_back({ tick, borders[i + 1], utickOffset });
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   buildPositions
+//    same as the playback cursor did for every move:
+//    chord/rest segments, skipping the invisible ones,
+//    of the measures from first up to endTick
+//---------------------------------------------------------
+
+void PlaybackTimeline::buildPositions(const Score* score, const Measure* first, int endTick)
+{
+    const System* currentSystem = nullptr;
+    double systemY = 0.0;
+    double systemHeight = 0.0;
+
+    for (const Measure* measure = first; measure; measure = measure->nextMeasureMM()) {
+        if (endTick >= 0 && measure->tick().ticks() >= endTick) {
+            break;
+        }
+
+        const System* system = measure->system();
+        if (!system || !system->page() || system->staves().empty()) {
+            continue;
+        }
+
+        if (system != currentSystem) {
+            systemY = system->staffYpage(0) + system->page()->pos().y();
+            systemHeight = 0.0;
+
+            for (size_t i = 0; i < score->nstaves(); ++i) {
+                const SysStaff* ss = system->staff(i);
+                if (!ss->show() || !score->staff(i)->show()) {
+                    continue;
+                }
+                systemHeight = ss->bbox().bottom();
+            }
+
+            currentSystem = system;
+        }
+
+        for (const Segment* s = measure->first(SegmentType::ChordRest); s;) {
+            const Segment* ns = s->next(SegmentType::ChordRest);
+            while (ns && !ns->visible()) {
+                ns = ns->next(SegmentType::ChordRest);
+            }
+
+            SegmentEntry e;
+            e.tick = s->tick().ticks();
+            e.x1 = s->canvasPos().x();
+            e.systemY = systemY;
+            e.systemHeight = systemHeight;
+            e.segment = s;
+
+            if (ns) {
+                e.endTick = ns->tick().ticks();
+                e.x2 = ns->canvasPos().x();
+            } else {
+                e.endTick = measure->endTick().ticks();
+                // measure->width is not good enough because of courtesy keysig, timesig
+                const Segment* seg = measure->findSegment(SegmentType::EndBarLine, measure->tick() + measure->ticks());
+                if (seg) {
+                    e.x2 = seg->canvasPos().x();
+                } else {
+                    e.x2 = measure->canvasPos().x() + measure->width(); // safety, should not happen
+                }
+            }
+
+            if (e.endTick > e.tick) {
+                m_segments.push_back(e);
+            }
+
+            s = ns;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   repeatEntryByUtick
+//    the last repeat segment starting at or before utick
+//---------------------------------------------------------
+
+std::vector<PlaybackTimeline::RepeatEntry>::const_iterator PlaybackTimeline::repeatEntryByUtick(int utick) const
+{
+    auto it = std::upper_bound(m_repeats.cbegin(), m_repeats.cend(), utick, [](int t, const RepeatEntry& e) {
+        return t < e.utick;
+    });
+
+    if (it == m_repeats.cbegin()) {
+        return m_repeats.cend();
+    }
+
+    return --it;
+}
+
+//---------------------------------------------------------
+//   utick2tick
+//---------------------------------------------------------
+
+int PlaybackTimeline::utick2tick(int utick) const
+{
+    if (m_repeats.empty()) {
+        return utick;
+    }
+
+    if (utick < 0) {
+        return 0;
+    }
+
+    auto e = repeatEntryByUtick(utick);
+    return utick - (e->utick - e->tick);
+}
+
+//---------------------------------------------------------
+//   tick2utick
+//---------------------------------------------------------
+
+int PlaybackTimeline::tick2utick(int tick) const
+{
+    if (m_repeats.empty()) {
+        return 0;
+    }
+
+    auto it = std::upper_bound(m_tickRanges.cbegin(), m_tickRanges.cend(), tick, [](int t, const TickRange& r) {
+        return t < r.tick;
+    });
+
+    if (it != m_tickRanges.cbegin()) {
+        --it;
+        if (tick < it->endTick) {
+            return tick + it->utickOffset;
+        }
+    }
+
+    const RepeatEntry& last = m_repeats.back();
+    return last.utick + (tick - last.tick);
+}
+
+//---------------------------------------------------------
+//   utick2utime
+//---------------------------------------------------------
+
+double PlaybackTimeline::utick2utime(int utick) const
+{
+    auto e = repeatEntryByUtick(utick);
+    if (e == m_repeats.cend()) {
+        return 0.0;
+    }
+
+    return m_tempomap.tick2time(utick - (e->utick - e->tick)) + e->timeOffset;
+}
+
+//---------------------------------------------------------
+//   utime2utick
+//---------------------------------------------------------
+
+int PlaybackTimeline::utime2utick(double utime) const
+{
+    auto e = std::upper_bound(m_repeats.cbegin(), m_repeats.cend(), utime, [](double t, const RepeatEntry& entry) {
+        return t < entry.utime;
+    });
+
+    if (e == m_repeats.cbegin()) {
+        return 0;
+    }
+
+    --e;
+    return m_tempomap.time2tick(utime - e->timeOffset) + (e->utick - e->tick);
+}
+
+//---------------------------------------------------------
+//   position
+//---------------------------------------------------------
+
+PlaybackTimeline::Position PlaybackTimeline::position(int tick) const
+{
+    auto it = std::upper_bound(m_segments.cbegin(), m_segments.cend(), tick, [](int t, const SegmentEntry& e) {
+        return t < e.tick;
+    });
+
+    if (it == m_segments.cbegin()) {
+        return Position();
+    }
+
+    --it;
+    if (tick >= it->endTick) {
+        return Position();
+    }
+
+    Position p;
+    p.x = it->x1 + (it->x2 - it->x1) * (tick - it->tick) / (it->endTick - it->tick);
+    p.y = it->systemY;
+    p.systemHeight = it->systemHeight;
+    p.segment = it->segment;
+
+    return p;
+}
+
+//---------------------------------------------------------
+//   cursorRect
+//    the playback cursor over the whole system
+//---------------------------------------------------------
+
+RectF PlaybackTimeline::cursorRect(int tick) const
+{
+    Position p = position(tick);
+    if (!p.isValid()) {
+        return RectF();
+    }
+
+    double w = 8;
+    double h = 6 * m_spatium + p.systemHeight;
+    double x = p.x - m_spatium;
+    double y = p.y - 3 * m_spatium;
+
+    return RectF(x, y, w, h);
+}
@@ -0,0 +1,131 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PLAYBACKTIMELINE_H__
+#define __PLAYBACKTIMELINE_H__
+
+#include <memory>
+#include <vector>
+
+#include "draw/types/geometry.h"
+
+#include "tempo.h"
+
+namespace mu::engraving {
+class Measure;
+class Score;
+class Segment;
+
+//---------------------------------------------------------
+//   PlaybackTimeline
+//    immutable snapshot of the repeat list, the tempo map
+//    and the horizontal positions of the chord/rest segments,
+//    built by the score after layout;
+//    all lookups are binary searches, so the snapshot can
+//    be read from any thread while the score goes on
+//---------------------------------------------------------
+
+class PlaybackTimeline
+{
+public:
+    //! NOTE The horizontal position of a tick in its system
+    struct Position {
+        double x = 0.0;               // canvas x
+        double y = 0.0;               // canvas y of the first staff of the system
+        double systemHeight = 0.0;    // bottom of the last visible staff, relative to the first one
+        const Segment* segment = nullptr;
+
+        bool isValid() const { return segment != nullptr; }
+    };
+
+    explicit PlaybackTimeline(const Score* score);
+
+    //! NOTE Takes the positions outside of [startTick, endTick) from the previous timeline, endTick -1 is the end of the score.
+    //! The range must start and end at system borders, the times are always built again
+    PlaybackTimeline(const Score* score, const PlaybackTimeline& previous, int startTick, int endTick);
+
+    //! NOTE The state of the score the timeline was built for
+    bool playRepeats() const { return m_playRepeats; }
+    int tempoSN() const { return m_tempoSN; }
+    int endTick() const { return m_endTick; }
+    double spatium() const { return m_spatium; }
+
+    int utick2tick(int utick) const;
+    int tick2utick(int tick) const;
+    double utick2utime(int utick) const;
+    int utime2utick(double utime) const;
+
+    int ticks() const { return m_ticks; }
+    double duration() const { return m_duration; }
+
+    Position position(int tick) const;
+    RectF cursorRect(int tick) const;
+
+private:
+    struct RepeatEntry {
+        int utick = 0;
+        int tick = 0;
+        int len = 0;
+        double utime = 0.0;
+        double timeOffset = 0.0;
+    };
+
+    //! NOTE The first played repeat segment for a range of ticks
+    struct TickRange {
+        int tick = 0;
+        int endTick = 0;
+        int utickOffset = 0;
+    };
+
+    //! NOTE The system is kept with every segment, so the entries of a range can be replaced alone
+    struct SegmentEntry {
+        int tick = 0;
+        int endTick = 0;
+        double x1 = 0.0;
+        double x2 = 0.0;
+        double systemY = 0.0;
+        double systemHeight = 0.0;
+        const Segment* segment = nullptr;
+    };
+
+    void buildTimes(const Score* score);
+    void buildPositions(const Score* score, const Measure* first, int endTick);
+
+    std::vector<RepeatEntry>::const_iterator repeatEntryByUtick(int utick) const;
+
+    bool m_playRepeats = false;
+    int m_tempoSN = 0;
+    int m_endTick = 0;
+    int m_ticks = 0;
+    double m_duration = 0.0;
+    double m_spatium = 0.0;
+
+    std::vector<RepeatEntry> m_repeats;
+    std::vector<TickRange> m_tickRanges;
+    TempoMap m_tempomap; // a copy, its lookups use the index of the tempo map
+    std::vector<SegmentEntry> m_segments;
+};
+
+using PlaybackTimelinePtr = std::shared_ptr<const PlaybackTimeline>;
+} // namespace mu::engraving
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "propertysummary.h"
+
+#include "engravingitem.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+//---------------------------------------------------------
+//   PropertySummaryBuilder
+//---------------------------------------------------------
+
+PropertySummaryBuilder::PropertySummaryBuilder(const std::vector<EngravingItem*>& elements, const std::vector<Pid>& pids,
+                                               ValuesEqual valuesEqual)
+    : m_elements(elements), m_valuesEqual(std::move(valuesEqual))
+{
+    if (!m_valuesEqual) {
+        m_valuesEqual = [](Pid, const PropertyValue& value1, const EngravingItem*, const PropertyValue& value2, const EngravingItem*) {
+            return value1.type() == value2.type() && value1 == value2;
+        };
+    }
+
+    m_summaries.reserve(pids.size());
+    m_pending.reserve(pids.size());
+
+    for (Pid pid : pids) {
+        auto it = m_summaries.emplace(pid, PropertySummary());
+        if (it.second) {
+            Pending p;
+            p.pid = pid;
+            p.summary = &it.first->second;
+            m_pending.push_back(p);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   process
+//---------------------------------------------------------
+
+bool PropertySummaryBuilder::process(size_t maxElements)
+{
+    if (m_canceled) {
+        return false;
+    }
+
+    size_t count = std::min(maxElements, m_elements.size() - m_nextElement);
+    for (size_t i = 0; i < count && !m_pending.empty(); ++i) {
+        const EngravingItem* element = m_elements[m_nextElement++];
+
+        IF_ASSERT_FAILED(element) {
+            continue;
+        }
+
+        processElement(element);
+    }
+
+    //! NOTE The rest of the elements can't change the summaries anymore
+    if (m_pending.empty()) {
+        m_nextElement = m_elements.size();
+    }
+
+    return isFinished();
+}
+
+//---------------------------------------------------------
+//   processElement
+//---------------------------------------------------------
+
+void PropertySummaryBuilder::processElement(const EngravingItem* element)
+{
+    for (size_t i = 0; i < m_pending.size();) {
+        Pending& p = m_pending[i];
+        PropertySummary& summary = *p.summary;
+
+        if (!p.styleResolved) {
+            summary.styleId = element->getPropertyStyle(p.pid);
+            p.styleResolved = summary.styleId != Sid::NOSTYLE;
+        }
+
+        if (!summary.isMixed) {
+            PropertyValue value = element->getProperty(p.pid);
+            if (value.isValid()) {
+                if (!summary.element) {
+                    summary.value = value;
+                    summary.defaultValue = element->propertyDefault(p.pid);
+                    summary.element = element;
+                } else if (!m_valuesEqual(p.pid, summary.value, summary.element, value, element)) {
+                    summary.isMixed = true;
+                }
+            }
+        }
+
+        if (summary.isMixed && p.styleResolved) {
+            m_pending[i] = m_pending.back();
+            m_pending.pop_back();
+        } else {
+            ++i;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   cancel
+//---------------------------------------------------------
+
+void PropertySummaryBuilder::cancel()
+{
+    m_canceled = true;
+    m_pending.clear();
+}
+
+bool PropertySummaryBuilder::isFinished() const
+{
+    return !m_canceled && m_nextElement >= m_elements.size();
+}
+
+bool PropertySummaryBuilder::isCanceled() const
+{
+    return m_canceled;
+}
+
+//---------------------------------------------------------
+//   summary
+//---------------------------------------------------------
+
+const PropertySummary* PropertySummaryBuilder::summary(Pid pid) const
+{
+    if (!isFinished()) {
+        return nullptr;
+    }
+
+    auto it = m_summaries.find(pid);
+    return it != m_summaries.cend() ? &it->second : nullptr;
+}
@@ -0,0 +1,107 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PROPERTYSUMMARY_H__
+#define __PROPERTYSUMMARY_H__
+
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "style/styledef.h"
+#include "types/propertyvalue.h"
+
+#include "property.h"
+
+namespace mu::engraving {
+class EngravingItem;
+
+//---------------------------------------------------------
+//   PropertySummary
+//    one property over a list of elements: the value and
+//    default of the first element that has the property,
+//    whether another element has a different value, and
+//    the style of the first styled element
+//---------------------------------------------------------
+
+struct PropertySummary {
+    PropertyValue value;
+    PropertyValue defaultValue;
+    const EngravingItem* element = nullptr;   // the element of value and defaultValue
+    Sid styleId = Sid::NOSTYLE;
+    bool isMixed = false;
+};
+
+//---------------------------------------------------------
+//   PropertySummaryBuilder
+//    computes the summaries of many properties in one pass
+//    over the elements; a property leaves the pass once it
+//    is mixed and its style is known
+//
+//    the pass can be done in steps and canceled between
+//    them; it reads the elements, so they must not be
+//    changed or deleted while the pass is not finished
+//---------------------------------------------------------
+
+class PropertySummaryBuilder
+{
+public:
+    //! NOTE Tells whether the values of two elements are shown as the same value.
+    //! By default the values are equal when they are of the same type and equal
+    using ValuesEqual = std::function<bool (Pid pid, const PropertyValue& value1, const EngravingItem* element1,
+                                            const PropertyValue& value2, const EngravingItem* element2)>;
+
+    PropertySummaryBuilder(const std::vector<EngravingItem*>& elements, const std::vector<Pid>& pids,
+                           ValuesEqual valuesEqual = nullptr);
+
+    //! NOTE Goes on with the pass for at most maxElements elements, returns true when the pass is finished
+    bool process(size_t maxElements = std::numeric_limits<size_t>::max());
+    void cancel();
+
+    bool isFinished() const;
+    bool isCanceled() const;
+
+    //! NOTE nullptr until the pass is finished
+    const PropertySummary* summary(Pid pid) const;
+
+private:
+    struct Pending {
+        Pid pid = Pid::END;
+        PropertySummary* summary = nullptr;
+        bool styleResolved = false;
+    };
+
+    void processElement(const EngravingItem* element);
+
+    std::vector<EngravingItem*> m_elements;
+    size_t m_nextElement = 0;
+
+    std::unordered_map<Pid, PropertySummary> m_summaries;
+    std::vector<Pending> m_pending;
+
+    ValuesEqual m_valuesEqual;
+    bool m_canceled = false;
+};
+}
+
+#endif // __PROPERTYSUMMARY_H__
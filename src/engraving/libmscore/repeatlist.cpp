@@ -119,8 +119,6 @@ const std::vector<const Measure*>& RepeatSegment::measureList() const
 RepeatList::RepeatList(Score* s)
 {
     _score = s;
-    idx1  = 0;
-    idx2  = 0;
 }
 
 //---------------------------------------------------------
@@ -185,6 +183,24 @@ void RepeatList::updateTempo()
     }
 }
 
+//---------------------------------------------------------
+//   repeatSegmentByUtick
+//    the last repeat segment starting at or before utick
+//---------------------------------------------------------
+
+std::vector<RepeatSegment*>::const_iterator RepeatList::repeatSegmentByUtick(int utick) const
+{
+    auto it = std::upper_bound(cbegin(), cend(), utick, [](int t, const RepeatSegment* rs) {
+        return t < rs->utick;
+    });
+
+    if (it == cbegin()) {
+        return cend();
+    }
+
+    return --it;
+}
+
 //---------------------------------------------------------
 //   utick2tick
 //---------------------------------------------------------
@@ -198,12 +214,10 @@ int RepeatList::utick2tick(int tick) const
     if (tick < 0) {
         return 0;
     }
-    unsigned ii = (idx1 < n) && (tick >= at(idx1)->utick) ? idx1 : 0;
-    for (unsigned i = ii; i < n; ++i) {
-        if ((tick >= at(i)->utick) && ((i + 1 == n) || (tick < at(i + 1)->utick))) {
-            idx1 = i;
-            return tick - (at(i)->utick - at(i)->tick);
-        }
+
+    auto it = repeatSegmentByUtick(tick);
+    if (it != cend()) {
+        return tick - ((*it)->utick - (*it)->tick);
     }
 
     ASSERT_X(String(u"tick %1 not found in RepeatList").arg(tick));
@@ -233,16 +247,13 @@ int RepeatList::tick2utick(int tick) const
 
 double RepeatList::utick2utime(int tick) const
 {
-    size_t n = size();
-    unsigned ii = (idx1 < n) && (tick >= at(idx1)->utick) ? idx1 : 0;
-    for (unsigned i = ii; i < n; ++i) {
-        if ((tick >= at(i)->utick) && ((i + 1 == n) || (tick < at(i + 1)->utick))) {
-            int t     = tick - (at(i)->utick - at(i)->tick);
-            double tt = _score->tempomap()->tick2time(t) + at(i)->timeOffset;
-            return tt;
-        }
+    auto it = repeatSegmentByUtick(tick);
+    if (it == cend()) {
+        return 0.0;
     }
-    return 0.0;
+
+    int t = tick - ((*it)->utick - (*it)->tick);
+    return _score->tempomap()->tick2time(t) + (*it)->timeOffset;
 }
 
 //---------------------------------------------------------
@@ -251,13 +262,13 @@ double RepeatList::utick2utime(int tick) const
 
 int RepeatList::utime2utick(double secs) const
 {
-    size_t repeatSegmentsCount = size();
-    unsigned ii = (idx2 < repeatSegmentsCount) && (secs >= at(idx2)->utime) ? idx2 : 0;
-    for (unsigned i = ii; i < repeatSegmentsCount; ++i) {
-        if ((secs >= at(i)->utime) && ((i + 1 == repeatSegmentsCount) || (secs < at(i + 1)->utime))) {
-            idx2 = i;
-            return _score->tempomap()->time2tick(secs - at(i)->timeOffset) + (at(i)->utick - at(i)->tick);
-        }
+    auto it = std::upper_bound(cbegin(), cend(), secs, [](double t, const RepeatSegment* rs) {
+        return t < rs->utime;
+    });
+
+    if (it != cbegin()) {
+        --it;
+        return _score->tempomap()->time2tick(secs - (*it)->timeOffset) + ((*it)->utick - (*it)->tick);
     }
 
     ASSERT_X(String(u"time %1 not found in RepeatList").arg(secs));
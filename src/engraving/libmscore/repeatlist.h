@@ -80,7 +80,6 @@ class RepeatList : public std::vector<RepeatSegment*>
     OBJECT_ALLOCATOR(engraving, RepeatList)
 
     Score* _score = nullptr;
-    mutable unsigned idx1, idx2;     // cached values
 
     bool _expanded = false;
     bool _scoreChanged = true;
@@ -99,6 +98,8 @@ class RepeatList : public std::vector<RepeatSegment*>
     void unwind();
     void flatten();
 
+    std::vector<RepeatSegment*>::const_iterator repeatSegmentByUtick(int utick) const;
+
 public:
     RepeatList(Score* s);
     RepeatList(const RepeatList&) = delete;
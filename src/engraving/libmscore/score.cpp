@@ -31,6 +31,7 @@
 #include <map>
 
 #include "containers.h"
+#include "realfn.h"
 
 #include "style/style.h"
 #include "style/defaultstyle.h"
@@ -86,6 +87,7 @@
 #include "tempo.h"
 #include "tempotext.h"
 #include "text.h"
+#include "textlayoutcache.h"
 #include "tie.h"
 #include "tiemap.h"
 #include "timesig.h"
@@ -1480,6 +1482,8 @@ void Score::styleChanged()
         }
     }
     createPaddingTable();
+    //! NOTE The text fonts may have changed
+    TextLayoutCache::instance()->clear();
     setLayoutAll();
 }
 
@@ -2010,6 +2014,76 @@ int Score::utime2utick(double utime) const
     return repeatList().utime2utick(utime);
 }
 
+//---------------------------------------------------------
+//   playbackTimeline
+//---------------------------------------------------------
+
+PlaybackTimelinePtr Score::playbackTimeline() const
+{
+    std::lock_guard<std::mutex> lock(m_playbackTimelineMutex);
+
+    //! NOTE The kept positions are only valid while the ticks of the measures and the spatium stay
+    if (!m_playbackTimeline
+        || m_playbackTimeline->endTick() != endTick().ticks()
+        || !RealIsEqual(m_playbackTimeline->spatium(), spatium())) {
+        m_playbackTimeline = std::make_shared<PlaybackTimeline>(this);
+    } else if (m_playbackTimelineChanged
+               || m_playbackTimeline->playRepeats() != MScore::playRepeats
+               || m_playbackTimeline->tempoSN() != tempomap()->tempoSN()) {
+        m_playbackTimeline = std::make_shared<PlaybackTimeline>(this, *m_playbackTimeline,
+                                                                m_playbackTimelineStartTick.ticks(),
+                                                                m_playbackTimelineEndTick.ticks());
+    }
+
+    m_playbackTimelineChanged = false;
+
+    return m_playbackTimeline;
+}
+
+//---------------------------------------------------------
+//   resetPlaybackTimeline
+//---------------------------------------------------------
+
+void Score::resetPlaybackTimeline()
+{
+    std::lock_guard<std::mutex> lock(m_playbackTimelineMutex);
+    m_playbackTimeline = nullptr;
+    m_playbackTimelineChanged = false;
+}
+
+//---------------------------------------------------------
+//   invalidatePlaybackTimeline
+//---------------------------------------------------------
+
+void Score::invalidatePlaybackTimeline(const Fraction& startTick, const Fraction& endTick)
+{
+    std::lock_guard<std::mutex> lock(m_playbackTimelineMutex);
+
+    if (!m_playbackTimeline) {
+        return;
+    }
+
+    if (startTick <= Fraction(0, 1) && endTick < Fraction(0, 1)) {
+        m_playbackTimeline = nullptr;
+        m_playbackTimelineChanged = false;
+        return;
+    }
+
+    bool isEmpty = startTick == endTick;
+    if (!m_playbackTimelineChanged || m_playbackTimelineStartTick == m_playbackTimelineEndTick) {
+        m_playbackTimelineStartTick = startTick;
+        m_playbackTimelineEndTick = endTick;
+    } else if (!isEmpty) {
+        //! NOTE Both ranges start and end at system borders, so does the range covering them
+        m_playbackTimelineStartTick = std::min(m_playbackTimelineStartTick, startTick);
+        if (m_playbackTimelineEndTick >= Fraction(0, 1)) {
+            m_playbackTimelineEndTick = endTick < Fraction(0, 1) ? endTick : std::max(m_playbackTimelineEndTick, endTick);
+        }
+    }
+
+    m_playbackTimelineChanged = true;
+}
+
 //---------------------------------------------------------
 //   inputPos
 //---------------------------------------------------------
@@ -3319,7 +3393,8 @@ void Score::deselect(EngravingItem* el)
     addRefresh(el->abbox());
     _selection.remove(el);
     setSelectionChanged(true);
-    _selection.update();
+    // the other elements keep their selected flag, no need to walk the whole list
+    _selection.updateState();
 }
 
 //---------------------------------------------------------
@@ -3430,7 +3505,7 @@ void Score::selectAdd(EngravingItem* e)
             selState = SelState::RANGE;
             _selection.updateSelectedElements();
         }
-    } else if (!mu::contains(_selection.elements(), e)) {
+    } else if (!_selection.contains(e)) {
         addRefresh(e->abbox());
         selState = SelState::LIST;
         _selection.add(e);
@@ -5281,9 +5356,39 @@ String Score::name() const
 void Score::addRefresh(const mu::RectF& r)
 {
     _updateState.refresh.unite(r);
+    _updateState.displayListRefresh.unite(r);
     cmdState().setUpdateMode(UpdateMode::Update);
 }
 
+//---------------------------------------------------------
+//   applyDisplayListRefresh
+//    the items painted in the refreshed area (selection,
+//    drop target, edited text...) are recorded again;
+//    is done once before painting, not on every addRefresh
+//---------------------------------------------------------
+
+void Score::applyDisplayListRefresh()
+{
+    if (_updateState.displayListRefresh.isNull()) {
+        return;
+    }
+
+    const RectF r = _updateState.displayListRefresh;
+    _updateState.displayListRefresh = RectF();
+
+    for (Page* page : pages()) {
+        if (!page->canvasBoundingRect().intersects(r)) {
+            continue;
+        }
+
+        //! NOTE Each list skips the refresh if it does not intersect its items
+        const RectF pageRect = r.translated(-page->pos());
+        for (System* system : page->systems()) {
+            system->invalidateDisplayList(pageRect);
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   staffIdx
 //
@@ -5501,7 +5606,8 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
     _noteHeadWidth = m_symbolFont->width(SymId::noteheadBlack, spatium() / SPATIUM20);
 
     m_layoutOptions.updateFromStyle(style());
-    m_layout.doLayoutRange(m_layoutOptions, st, et);
+    Layout::Range range = m_layout.doLayoutRange(m_layoutOptions, st, et);
+    invalidatePlaybackTimeline(range.startTick, range.endTick);
     if (_resetAutoplace) {
         _resetAutoplace = false;
         resetAutoplace();
@@ -28,6 +28,7 @@
  Definition of Score class.
 */
 
+#include <mutex>
 #include <set>
 
 #include "async/channel.h"
@@ -44,6 +45,7 @@
 #include "chordlist.h"
 #include "input.h"
 #include "mscore.h"
+#include "playbacktimeline.h"
 #include "property.h"
 #include "scoreorder.h"
 #include "select.h"
@@ -309,6 +311,7 @@ class UpdateState
 {
 public:
     mu::RectF refresh;                 ///< area to update, canvas coordinates
+    mu::RectF displayListRefresh;      ///< area to record again, canvas coordinates, see Score::applyDisplayListRefresh()
     bool _playNote   { false };     ///< play selected note after command
     bool _playChord  { false };     ///< play whole chord for the selected note
     bool _selectionChanged { false };
@@ -443,6 +446,11 @@ private:
     RootItem* m_rootItem = nullptr;
     Layout m_layout;
     LayoutOptions m_layoutOptions;
+    mutable PlaybackTimelinePtr m_playbackTimeline;
+    mutable bool m_playbackTimelineChanged = false;
+    mutable Fraction m_playbackTimelineStartTick;   // the positions to build again
+    mutable Fraction m_playbackTimelineEndTick;     // -1 is the end of the score
+    mutable std::mutex m_playbackTimelineMutex;
 
     mu::async::Channel<EngravingItem*> m_elementDestroyed;
 
@@ -771,6 +779,7 @@ public:
     virtual void addLayoutFlags(LayoutFlags);
     virtual void setInstrumentsChanged(bool);
     void addRefresh(const mu::RectF&);
+    void applyDisplayListRefresh();
 
     void cmdToggleAutoplace(bool all);
 
@@ -993,6 +1002,15 @@ public:
     double utick2utime(int tick) const;
     int utime2utick(double utime) const;
 
+    //! NOTE Built on first use after a layout, tempo or repeat change, under a lock.
+    //! Building reads the score, so call it on the thread that changes the score;
+    //! the returned snapshot does not change, so it can be kept and read from other threads
+    PlaybackTimelinePtr playbackTimeline() const;
+    void resetPlaybackTimeline();
+    //! NOTE The times and the positions in the range are built again, the other positions are kept.
+    //! The range must start and end at system borders, an empty range keeps all the positions
+    void invalidatePlaybackTimeline(const Fraction& startTick = Fraction(0, 1), const Fraction& endTick = Fraction(0, 1));
+
     void nextInputPos(ChordRest* cr, bool);
     void cmdMirrorNoteHead();
 
@@ -248,7 +248,7 @@ bool Selection::isEndActive() const
 
 EngravingItem* Selection::element() const
 {
-    return ((state() != SelState::RANGE) && (_el.size() == 1)) ? _el[0] : 0;
+    return ((state() != SelState::RANGE) && (_elSet.size() == 1)) ? *_elSet.cbegin() : 0;
 }
 
 ChordRest* Selection::cr() const
@@ -320,8 +320,8 @@ Segment* Selection::firstChordRestSegment() const
 
 ChordRest* Selection::firstChordRest(track_idx_t track) const
 {
-    if (_el.size() == 1) {
-        EngravingItem* el = _el[0];
+    if (_elSet.size() == 1) {
+        EngravingItem* el = *_elSet.cbegin();
         if (el->isNote()) {
             return toChordRest(el->explicitParent());
         } else if (el->isChordRest()) {
@@ -330,7 +330,7 @@ ChordRest* Selection::firstChordRest(track_idx_t track) const
         return 0;
     }
     ChordRest* cr = 0;
-    for (EngravingItem* el : _el) {
+    for (EngravingItem* el : elements()) {
         if (el->isNote()) {
             el = el->parentItem();
         }
@@ -352,8 +352,8 @@ ChordRest* Selection::firstChordRest(track_idx_t track) const
 
 ChordRest* Selection::lastChordRest(track_idx_t track) const
 {
-    if (_el.size() == 1) {
-        EngravingItem* el = _el[0];
+    if (_elSet.size() == 1) {
+        EngravingItem* el = *_elSet.cbegin();
         if (el) {
             if (el->isNote()) {
                 return toChordRest(el->explicitParent());
@@ -364,7 +364,7 @@ ChordRest* Selection::lastChordRest(track_idx_t track) const
         return nullptr;
     }
     ChordRest* cr = nullptr;
-    for (auto el : _el) {
+    for (auto el : elements()) {
         if (el->isNote()) {
             el = toNote(el)->chord();
         }
@@ -387,8 +387,8 @@ ChordRest* Selection::lastChordRest(track_idx_t track) const
 Measure* Selection::findMeasure() const
 {
     Measure* m = 0;
-    if (_el.size() > 0) {
-        EngravingItem* el = _el[0];
+    if (!_elSet.empty()) {
+        EngravingItem* el = elements().front();
         m = toMeasure(el->findMeasure());
     }
     return m;
@@ -418,7 +418,7 @@ void Selection::clear()
         return;
     }
 
-    for (EngravingItem* e : _el) {
+    for (EngravingItem* e : elements()) {
         if (e->isSpanner()) {       // TODO: only visible elements should be selectable?
             Spanner* sp = toSpanner(e);
             for (auto s : sp->spannerSegments()) {
@@ -428,7 +428,7 @@ void Selection::clear()
             e->score()->addRefresh(changeSelection(e, false));
         }
     }
-    _el.clear();
+    clearElements();
     _startSegment  = 0;
     _endSegment    = 0;
     _activeSegment = 0;
@@ -438,11 +438,19 @@ void Selection::clear()
     setState(SelState::NONE);
 }
 
+//---------------------------------------------------------
+//   remove
+//    The element is only dropped from the membership set
+//    here, the ordered list is compacted on next access so
+//    that deselecting many elements stays linear.
+//---------------------------------------------------------
+
 void Selection::remove(EngravingItem* el)
 {
-    const bool removed = mu::remove(_el, el);
+    const bool removed = _elSet.erase(el) > 0;
     el->setSelected(false);
     if (removed) {
+        _elNeedsCompact = true;
         updateState();
     }
 }
@@ -453,10 +461,40 @@ void Selection::add(EngravingItem* el)
         LOGE() << "selection locked, reason: " << lockReason();
         return;
     }
-    _el.push_back(el);
+    appendElement(el);
     update();
 }
 
+bool Selection::appendElement(EngravingItem* e)
+{
+    // drop stale entries first: a previously removed entry of e may still be in the list,
+    // and it would be kept (and duplicated) once e is back in the set
+    compactElements();
+    if (!_elSet.insert(e).second) {
+        return false;
+    }
+    _el.push_back(e);
+    return true;
+}
+
+void Selection::clearElements()
+{
+    _el.clear();
+    _elSet.clear();
+    _elNeedsCompact = false;
+}
+
+void Selection::compactElements() const
+{
+    if (!_elNeedsCompact) {
+        return;
+    }
+    _el.erase(std::remove_if(_el.begin(), _el.end(), [this](EngravingItem* e) {
+        return _elSet.find(e) == _elSet.cend();
+    }), _el.end());
+    _elNeedsCompact = false;
+}
+
 void Selection::appendFiltered(EngravingItem* e)
 {
     IF_ASSERT_FAILED(!isLocked()) {
@@ -464,7 +502,7 @@ void Selection::appendFiltered(EngravingItem* e)
         return;
     }
     if (selectionFilter().canSelect(e)) {
-        _el.push_back(e);
+        appendElement(e);
     }
 }
 
@@ -474,34 +512,34 @@ void Selection::appendChord(Chord* chord)
         LOGE() << "selection locked, reason: " << lockReason();
         return;
     }
-    if (chord->beam() && !mu::contains(_el, static_cast<EngravingItem*>(chord->beam()))) {
-        _el.push_back(chord->beam());
+    if (chord->beam()) {
+        appendElement(chord->beam());
     }
     if (chord->stem()) {
-        _el.push_back(chord->stem());
+        appendElement(chord->stem());
     }
     if (chord->hook()) {
-        _el.push_back(chord->hook());
+        appendElement(chord->hook());
     }
     if (chord->arpeggio()) {
         appendFiltered(chord->arpeggio());
     }
     if (chord->stemSlash()) {
-        _el.push_back(chord->stemSlash());
+        appendElement(chord->stemSlash());
     }
     if (chord->tremolo()) {
         appendFiltered(chord->tremolo());
     }
     for (Note* note : chord->notes()) {
-        _el.push_back(note);
+        appendElement(note);
         if (note->accidental()) {
-            _el.push_back(note->accidental());
+            appendElement(note->accidental());
         }
         for (EngravingItem* el : note->el()) {
             appendFiltered(el);
         }
         for (NoteDot* dot : note->dots()) {
-            _el.push_back(dot);
+            appendElement(dot);
         }
 
         if (note->tieFor() && (note->tieFor()->endElement() != 0)) {
@@ -509,7 +547,7 @@ void Selection::appendChord(Chord* chord)
                 Note* endNote = toNote(note->tieFor()->endElement());
                 Segment* s = endNote->chord()->segment();
                 if (s->tick() < tickEnd()) {
-                    _el.push_back(note->tieFor());
+                    appendElement(note->tieFor());
                 }
             }
         }
@@ -518,7 +556,7 @@ void Selection::appendChord(Chord* chord)
                 Note* endNote = toNote(sp->endElement());
                 Segment* s = endNote->chord()->segment();
                 if (s->tick() < tickEnd()) {
-                    _el.push_back(sp);
+                    appendElement(sp);
                 }
             }
         }
@@ -560,10 +598,10 @@ void Selection::updateSelectedElements()
         _plannedTick2 = Fraction(-1, 1);
     }
 
-    for (EngravingItem* e : _el) {
+    for (EngravingItem* e : elements()) {
         e->setSelected(false);
     }
-    _el.clear();
+    clearElements();
 
     // assert:
     size_t staves = _score->nstaves();
@@ -576,20 +614,25 @@ void Selection::updateSelectedElements()
     track_idx_t startTrack = _staffStart * VOICES;
     track_idx_t endTrack   = _staffEnd * VOICES;
 
+    std::vector<track_idx_t> tracks;
     for (track_idx_t st = startTrack; st < endTrack; ++st) {
-        if (!canSelectVoice(st)) {
+        if (canSelectVoice(st)) {
+            tracks.push_back(st);
+        }
+    }
+
+    // segment-major: each segment of the range is visited once
+    for (Segment* s = _startSegment; s && (s != _endSegment) && !tracks.empty(); s = s->next1MM()) {
+        if (!s->enabled() || s->isEndBarLineType()) {      // do not select end bar line
             continue;
         }
-        for (Segment* s = _startSegment; s && (s != _endSegment); s = s->next1MM()) {
-            if (!s->enabled() || s->isEndBarLineType()) {      // do not select end bar line
+        for (EngravingItem* e : s->annotations()) {
+            if (e->track() < startTrack || e->track() >= endTrack || !canSelectVoice(e->track())) {
                 continue;
             }
-            for (EngravingItem* e : s->annotations()) {
-                if (e->track() != st) {
-                    continue;
-                }
-                appendFiltered(e);
-            }
+            appendFiltered(e);
+        }
+        for (track_idx_t st : tracks) {
             EngravingItem* e = s->element(st);
             if (!e || e->generated() || e->isTimeSig() || e->isKeySig()) {
                 continue;
@@ -627,8 +670,10 @@ void Selection::updateSelectedElements()
     Fraction stick = startSegment()->tick();
     Fraction etick = tickEnd();
 
-    for (auto i = _score->spanner().begin(); i != _score->spanner().end(); ++i) {
-        Spanner* sp = (*i).second;
+    // only spanners overlapping the range can start or end in it
+    auto spanners = _score->spannerMap().findOverlapping(stick.ticks(), etick.ticks());
+    for (auto& interval : spanners) {
+        Spanner* sp = interval.value;
         // ignore spanners belonging to other tracks
         if (sp->track() < startTrack || sp->track() >= endTrack) {
             continue;
@@ -698,7 +743,7 @@ void Selection::setRangeTicks(const Fraction& tick1, const Fraction& tick2, staf
 
 void Selection::update()
 {
-    for (EngravingItem* e : _el) {
+    for (EngravingItem* e : elements()) {
         e->setSelected(true);
     }
     updateState();
@@ -715,7 +760,7 @@ void Selection::dump()
     case SelState::LIST:   LOGD("LIST");
         break;
     }
-    for (const EngravingItem* e : _el) {
+    for (const EngravingItem* e : elements()) {
         LOGD("  %p %s", e, e->typeName());
     }
 }
@@ -727,7 +772,7 @@ void Selection::dump()
 
 void Selection::updateState()
 {
-    size_t n = _el.size();
+    size_t n = _elSet.size();
     EngravingItem* e = element();
     if (n == 0) {
         setState(SelState::NONE);
@@ -894,7 +939,7 @@ ByteArray Selection::symbolListMimeData() const
     std::multimap<int64_t, MapData> map;
 
     // scan selection element list, inserting relevant elements in a tick-sorted map
-    for (EngravingItem* e : _el) {
+    for (EngravingItem* e : elements()) {
         switch (e->type()) {
         /* All these element types are ignored:
 
@@ -1113,7 +1158,7 @@ std::vector<EngravingItem*> Selection::elements(ElementType type) const
 {
     std::vector<EngravingItem*> result;
 
-    for (EngravingItem* element : _el) {
+    for (EngravingItem* element : elements()) {
         if (element->type() == type) {
             result.push_back(element);
         }
@@ -1127,7 +1172,7 @@ std::vector<Note*> Selection::noteList(track_idx_t selTrack) const
     std::vector<Note*> nl;
 
     if (_state == SelState::LIST) {
-        for (EngravingItem* e : _el) {
+        for (EngravingItem* e : elements()) {
             if (e->isNote()) {
                 nl.push_back(toNote(e));
             }
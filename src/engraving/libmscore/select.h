@@ -23,6 +23,8 @@
 #ifndef __SELECT_H__
 #define __SELECT_H__
 
+#include <unordered_set>
+
 #include "durationtype.h"
 #include "mscore.h"
 #include "pitchspelling.h"
@@ -154,7 +156,9 @@ class Selection
 {
     Score* _score;
     SelState _state;
-    std::vector<EngravingItem*> _el;            // valid in mode SelState::LIST
+    mutable std::vector<EngravingItem*> _el;    // valid in mode SelState::LIST, may still hold removed elements until compactElements()
+    std::unordered_set<EngravingItem*> _elSet;  // selected elements, the authority for membership and count
+    mutable bool _elNeedsCompact = false;
 
     staff_idx_t _staffStart = 0;            // valid if selState is SelState::RANGE
     staff_idx_t _staffEnd = 0;
@@ -179,6 +183,9 @@ class Selection
     SelectionFilter selectionFilter() const;
     bool canSelect(EngravingItem* e) const { return selectionFilter().canSelect(e); }
     bool canSelectVoice(track_idx_t track) const { return selectionFilter().canSelectVoice(track); }
+    bool appendElement(EngravingItem* e);
+    void clearElements();
+    void compactElements() const;
     void appendFiltered(EngravingItem* e);
     void appendChord(Chord* chord);
 
@@ -198,14 +205,16 @@ public:
     bool isLocked() const { return !_lockReason.isEmpty(); }
     const String& lockReason() const { return _lockReason; }
 
-    const std::vector<EngravingItem*>& elements() const { return _el; }
+    const std::vector<EngravingItem*>& elements() const { compactElements(); return _el; }
     std::vector<EngravingItem*> elements(ElementType type) const;
     std::vector<Note*> noteList(track_idx_t track = mu::nidx) const;
 
     const std::list<EngravingItem*> uniqueElements() const;
     std::list<Note*> uniqueNotes(track_idx_t track = mu::nidx) const;
 
-    bool isSingle() const { return (_state == SelState::LIST) && (_el.size() == 1); }
+    bool isSingle() const { return (_state == SelState::LIST) && (_elSet.size() == 1); }
+    bool contains(EngravingItem* e) const { return _elSet.find(e) != _elSet.cend(); }
+    size_t elementsCount() const { return _elSet.size(); }
 
     void add(EngravingItem*);
     void deselectAll();
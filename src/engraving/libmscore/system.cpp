@@ -56,6 +56,8 @@
 #include "systemdivider.h"
 #include "textframe.h"
 
+#include "infrastructure/systemdisplaylist.h"
+
 #ifndef ENGRAVING_NO_ACCESSIBILITY
 #include "accessibility/accessibleitem.h"
 #endif
@@ -113,6 +115,11 @@ System::System(Page* parent)
 {
 }
 
+System* System::clone() const
+{
+    return new System(*this);
+}
+
 //---------------------------------------------------------
 //   ~System
 //---------------------------------------------------------
@@ -155,6 +162,7 @@ void System::moveToPage(Page* parent)
 
 void System::clear()
 {
+    invalidateDisplayList();
     for (MeasureBase* mb : measures()) {
         if (mb->system() == this) {
             mb->resetExplicitParent();
@@ -365,6 +373,8 @@ double System::totalBracketOffset(const LayoutContext& ctx)
 
 void System::layoutSystem(const LayoutContext& ctx, double xo1, const bool isFirstSystem, bool firstSystemIndent)
 {
+    invalidateDisplayList();
+
     if (_staves.empty()) {                 // ignore vbox
         return;
     }
@@ -782,6 +792,8 @@ staff_idx_t System::firstVisibleStaff() const
 
 void System::layout2(const LayoutContext& ctx)
 {
+    invalidateDisplayList();
+
     Box* vb = vbox();
     if (vb) {
         vb->layout();
@@ -946,6 +958,8 @@ void System::layout2(const LayoutContext& ctx)
 
 void System::restoreLayout2()
 {
+    invalidateDisplayList();
+
     if (vbox()) {
         return;
     }
@@ -958,6 +972,55 @@ void System::restoreLayout2()
     setMeasureHeight(_systemHeight);
 }
 
+//---------------------------------------------------------
+//   displayList
+//    a list is kept for the screen and one for
+//    printing/exports, so switching between them does
+//    not record the system again
+//---------------------------------------------------------
+
+static constexpr size_t MAX_DISPLAY_LISTS = 2;
+
+std::shared_ptr<SystemDisplayList> System::displayList() const
+{
+    const SystemDisplayList::Key key = SystemDisplayList::Key::current(score());
+
+    std::lock_guard<std::mutex> lock(m_displayLists.mutex);
+    std::vector<std::shared_ptr<SystemDisplayList> >& lists = m_displayLists.lists;
+    for (size_t i = 0; i < lists.size(); ++i) {
+        if (lists.at(i)->key() == key) {
+            //! NOTE Keep the most recently used list first
+            std::rotate(lists.begin(), lists.begin() + i, lists.begin() + i + 1);
+            return lists.front();
+        }
+    }
+
+    if (lists.size() >= MAX_DISPLAY_LISTS) {
+        lists.pop_back();
+    }
+
+    lists.insert(lists.begin(), std::make_shared<SystemDisplayList>(this, key));
+    return lists.front();
+}
+
+//---------------------------------------------------------
+//   invalidateDisplayList
+//---------------------------------------------------------
+
+void System::invalidateDisplayList()
+{
+    std::lock_guard<std::mutex> lock(m_displayLists.mutex);
+    m_displayLists.lists.clear();
+}
+
+void System::invalidateDisplayList(const RectF& pageRect)
+{
+    std::lock_guard<std::mutex> lock(m_displayLists.mutex);
+    for (std::shared_ptr<SystemDisplayList>& list : m_displayLists.lists) {
+        list->invalidate(pageRect);
+    }
+}
+
 //---------------------------------------------------------
 //   setInstrumentNames
 //---------------------------------------------------------
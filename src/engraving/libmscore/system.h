@@ -28,6 +28,8 @@
  Definition of classes SysStaff and System
 */
 
+#include <mutex>
+
 #include "engravingitem.h"
 
 #include "skyline.h"
@@ -39,6 +41,7 @@ class InstrumentName;
 class MeasureBase;
 class Page;
 class SpannerSegment;
+class SystemDisplayList;
 
 class LayoutContext;
 
@@ -108,6 +111,18 @@ class System final : public EngravingItem
     double _distance                { 0.0 };     /// temp. variable used during layout
     double _systemHeight            { 0.0 };
 
+    //! NOTE The records refer to the items of this system, a copy of the system starts without them
+    struct DisplayLists {
+        std::vector<std::shared_ptr<SystemDisplayList> > lists;
+        std::mutex mutex;
+
+        DisplayLists() = default;
+        DisplayLists(const DisplayLists&) {}
+        DisplayLists& operator=(const DisplayLists&) { return *this; }
+    };
+
+    mutable DisplayLists m_displayLists;     ///< recorded painting, see displayList()
+
     friend class Factory;
     System(Page* parent);
 
@@ -134,7 +149,7 @@ public:
     EngravingObject* scanParent() const override;
     EngravingObjectList scanChildren() const override;
 
-    System* clone() const override { return new System(*this); }
+    System* clone() const override;
 
     void add(EngravingItem*) override;
     void remove(EngravingItem*) override;
@@ -162,6 +177,14 @@ public:
     void restoreLayout2();
     void clear(); ///< Clear measure list.
 
+    //! NOTE Recorded painting of the system items for the current paint state (screen, printing...),
+    //! is dropped when layout touches the system. The lists are guarded and a list being painted
+    //! is kept alive by the returned pointer, but the items are not: layout and edits
+    //! must not run while the system is painted
+    std::shared_ptr<SystemDisplayList> displayList() const;
+    void invalidateDisplayList();
+    void invalidateDisplayList(const mu::RectF& pageRect);
+
     mu::RectF bboxStaff(int staff) const { return _staves[staff]->bbox(); }
     std::vector<SysStaff*>& staves() { return _staves; }
     const std::vector<SysStaff*>& staves() const { return _staves; }
@@ -22,7 +22,9 @@
 
 #include "tempo.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "rw/xml.h"
 
@@ -131,6 +133,20 @@ void TempoMap::normalize()
         tempo = e->second.tempo.val;
     }
     ++_tempoSN;
+    rebuildIndex();
+}
+
+//---------------------------------------------------------
+//   rebuildIndex
+//---------------------------------------------------------
+
+void TempoMap::rebuildIndex()
+{
+    _index.clear();
+    _index.reserve(size());
+    for (auto e = begin(); e != end(); ++e) {
+        _index.push_back({ e->first, e->second.time, e->second.pause, e->second.tempo });
+    }
 }
 
 //---------------------------------------------------------
@@ -154,6 +170,7 @@ void TempoMap::clear()
 {
     std::map<int, TEvent>::clear();
     ++_tempoSN;
+    _index.clear();
 }
 
 //---------------------------------------------------------
@@ -171,6 +188,7 @@ void TempoMap::clearRange(int tick1, int tick2)
     }
     erase(first, last);
     ++_tempoSN;
+    rebuildIndex();
 }
 
 //---------------------------------------------------------
@@ -280,45 +298,108 @@ int TempoMap::time2tick(double time, int t, int* sn) const
     return (*sn == _tempoSN) ? t : time2tick(time, sn);
 }
 
+//---------------------------------------------------------
+//   indexEntryBefore
+//    return the last index entry at or before tick,
+//    or end() if tick precedes all tempo events
+//---------------------------------------------------------
+
+std::vector<TempoMap::IndexEntry>::const_iterator TempoMap::indexEntryBefore(int tick) const
+{
+    auto e = std::upper_bound(_index.cbegin(), _index.cend(), tick, [](int t, const IndexEntry& entry) {
+        return t < entry.tick;
+    });
+
+    if (e == _index.cbegin()) {
+        return _index.cend();
+    }
+
+    return --e;
+}
+
 //---------------------------------------------------------
 //   tick2time
+//    e is the index entry governing tick (see indexEntryBefore)
 //---------------------------------------------------------
 
-double TempoMap::tick2time(int tick, int* sn) const
+double TempoMap::tick2time(std::vector<IndexEntry>::const_iterator e, int tick) const
 {
     double time  = 0.0;
-    double delta = double(tick);
+    int ptick    = 0;
     BeatsPerSecond tempo = 2.0;
 
-    if (!empty()) {
-        int ptick  = 0;
-        auto e = lower_bound(tick);
-        if (e == end()) {
-            auto pe = e;
-            --pe;
-            ptick = pe->first;
-            tempo = pe->second.tempo;
-            time  = pe->second.time;
-        } else if (e->first == tick) {
-            ptick = tick;
-            tempo = e->second.tempo;
-            time  = e->second.time;
-        } else if (e != begin()) {
-            auto pe = e;
-            --pe;
-            ptick = pe->first;
-            tempo = pe->second.tempo;
-            time  = pe->second.time;
-        }
-        delta = double(tick - ptick);
-    } else {
+    if (e != _index.cend()) {
+        ptick = e->tick;
+        tempo = e->tempo;
+        time  = e->time;
+    }
+
+    time += double(tick - ptick) / (Constants::division * tempo.val * _tempoMultiplier.val);
+    return time;
+}
+
+//---------------------------------------------------------
+//   tick2time
+//---------------------------------------------------------
+
+double TempoMap::tick2time(int tick, int* sn) const
+{
+    if (_index.empty()) {
         LOGD("TempoMap: empty");
     }
     if (sn) {
         *sn = _tempoSN;
     }
-    time += delta / (Constants::division * tempo.val * _tempoMultiplier.val);
-    return time;
+    return tick2time(indexEntryBefore(tick), tick);
+}
+
+//---------------------------------------------------------
+//   ticks2times
+//    bulk version of tick2time; ascending runs of ticks
+//    are resolved by walking the index instead of searching it
+//---------------------------------------------------------
+
+std::vector<double> TempoMap::ticks2times(const std::vector<int>& ticks) const
+{
+    std::vector<double> result;
+    result.reserve(ticks.size());
+
+    auto e = _index.cend();
+    int prevTick = std::numeric_limits<int>::max();
+
+    for (int tick : ticks) {
+        if (tick < prevTick) {
+            e = indexEntryBefore(tick);
+        } else {
+            auto next = (e == _index.cend()) ? _index.cbegin() : std::next(e);
+            while (next != _index.cend() && next->tick <= tick) {
+                e = next++;
+            }
+        }
+
+        result.push_back(tick2time(e, tick));
+        prevTick = tick;
+    }
+
+    return result;
+}
+
+//---------------------------------------------------------
+//   ticks2msecs
+//---------------------------------------------------------
+
+std::vector<int64_t> TempoMap::ticks2msecs(const std::vector<int>& ticks) const
+{
+    std::vector<double> times = ticks2times(ticks);
+
+    std::vector<int64_t> result;
+    result.reserve(times.size());
+
+    for (double time : times) {
+        result.push_back(static_cast<int64_t>(std::llround(time * 1000.0)));
+    }
+
+    return result;
 }
 
 //---------------------------------------------------------
@@ -328,24 +409,26 @@ double TempoMap::tick2time(int tick, int* sn) const
 int TempoMap::time2tick(double time, int* sn) const
 {
     int tick     = 0;
-    double delta = time;
-    BeatsPerSecond tempo = _tempo;
+    double delta = 0.0;
+    BeatsPerSecond tempo = 2.0;
 
-    delta = 0.0;
-    tempo = 2.0;
-    for (auto e = begin(); e != end(); ++e) {
-        // if in a pause period, wait on previous tick
-        if ((time <= e->second.time) && (time > e->second.time - e->second.pause)) {
-            delta = (time - (e->second.time - e->second.pause) + delta);
-            break;
-        }
-        if (e->second.time >= time) {
-            break;
-        }
-        delta = e->second.time;
-        tick  = e->first;
-        tempo = e->second.tempo;
+    // first event at or after time; times grow monotonically with ticks
+    auto e = std::lower_bound(_index.cbegin(), _index.cend(), time, [](const IndexEntry& entry, double t) {
+        return entry.time < t;
+    });
+
+    if (e != _index.cbegin()) {
+        auto pe = std::prev(e);
+        delta = pe->time;
+        tick  = pe->tick;
+        tempo = pe->tempo;
     }
+
+    // if in a pause period, wait on previous tick
+    if (e != _index.cend() && time > e->time - e->pause) {
+        delta = (time - (e->time - e->pause) + delta);
+    }
+
     delta = time - delta;
     tick += lrint(delta * _tempoMultiplier.val * Constants::division * tempo.val);
     if (sn) {
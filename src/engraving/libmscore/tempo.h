@@ -24,6 +24,7 @@
 #define __AL_TEMPO_H__
 
 #include <map>
+#include <vector>
 
 #include "global/allocator.h"
 #include "global/async/notification.h"
@@ -72,14 +73,28 @@ class TempoMap : public std::map<int, TEvent>
 {
     OBJECT_ALLOCATOR(engraving, TempoMap)
 
+    //! NOTE flat copy of the map, sorted by tick (and so by time),
+    //! rebuilt every time _tempoSN changes; used for binary search lookups
+    struct IndexEntry {
+        int tick = 0;
+        double time = 0.0;
+        double pause = 0.0;
+        BeatsPerSecond tempo;
+    };
+
     int _tempoSN = 0; // serial no to track tempo changes
     BeatsPerSecond _tempo; // tempo if not using tempo list (beats per second)
     BeatsPerSecond _tempoMultiplier;
     async::Notification _tempoMultiplierChanged;
+    std::vector<IndexEntry> _index;
 
     void normalize();
+    void rebuildIndex();
     void del(int tick);
 
+    std::vector<IndexEntry>::const_iterator indexEntryBefore(int tick) const;
+    double tick2time(std::vector<IndexEntry>::const_iterator e, int tick) const;
+
 public:
     TempoMap();
     void clear();
@@ -96,6 +111,9 @@ public:
     int time2tick(double time, int tick, int* sn) const;
     int tempoSN() const { return _tempoSN; }
 
+    std::vector<double> ticks2times(const std::vector<int>& ticks) const;
+    std::vector<int64_t> ticks2msecs(const std::vector<int>& ticks) const;
+
     void setTempo(int t, BeatsPerSecond);
     void setPause(int t, double);
     void delTempo(int tick);
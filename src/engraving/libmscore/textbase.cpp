@@ -46,6 +46,7 @@
 #include "system.h"
 #include "textedit.h"
 #include "textframe.h"
+#include "textlayoutcache.h"
 #include "undo.h"
 
 #ifndef ENGRAVING_NO_ACCESSIBILITY
@@ -802,30 +803,7 @@ mu::draw::Font TextFragment::font(const TextBase* t) const
         }
         // check if all symbols are available
         font.setFamily(family);
-        mu::draw::FontMetrics fm(font);
-
-        bool fail = false;
-        for (size_t i = 0; i < text.size(); ++i) {
-            const Char& c = text.at(i);
-            if (c.isHighSurrogate()) {
-                if (i + 1 == text.size()) {
-                    ASSERT_X("bad string");
-                }
-                const Char& c2 = text.at(i + 1);
-                ++i;
-                char32_t v = Char::surrogateToUcs4(c, c2);
-                if (!fm.inFontUcs4(v)) {
-                    fail = true;
-                    break;
-                }
-            } else {
-                if (!fm.inFont(c)) {
-                    fail = true;
-                    break;
-                }
-            }
-        }
-        if (fail) {
+        if (!TextLayoutCache::instance()->isInFont(font, text)) {
             family = String::fromUtf8(SymbolFonts::fallbackTextFont());
         }
     } else {
@@ -896,17 +874,19 @@ void TextBlock::layout(TextBase* t)
         }
     }
 
+    TextLayoutCache* cache = TextLayoutCache::instance();
+
     if (_fragments.empty()) {
-        mu::draw::FontMetrics fm = t->fontMetrics();
-        _bbox.setRect(0.0, -fm.ascent(), 1.0, fm.descent());
-        _lineSpacing = fm.lineSpacing();
+        TextLayoutCache::Metrics fm = cache->metrics(t->font(), String());
+        _bbox.setRect(0.0, -fm.ascent, 1.0, fm.descent);
+        _lineSpacing = fm.lineSpacing;
     } else if (_fragments.size() == 1 && _fragments.front().text.isEmpty()) {
         auto fi = _fragments.begin();
         TextFragment& f = *fi;
         f.pos.setX(x);
-        mu::draw::FontMetrics fm(f.font(t));
+        TextLayoutCache::Metrics fm = cache->metrics(f.font(t), f.text);
         if (f.format.valign() != VerticalAlignment::AlignNormal) {
-            double voffset = fm.xHeight() / subScriptSize;   // use original height
+            double voffset = fm.xHeight / subScriptSize;   // use original height
             if (f.format.valign() == VerticalAlignment::AlignSubScript) {
                 voffset *= subScriptOffset;
             } else {
@@ -918,17 +898,17 @@ void TextBlock::layout(TextBase* t)
             f.pos.setY(0.0);
         }
 
-        RectF temp(0.0, -fm.ascent(), 1.0, fm.descent());
+        RectF temp(0.0, -fm.ascent, 1.0, fm.descent);
         _bbox |= temp;
-        _lineSpacing = std::max(_lineSpacing, fm.lineSpacing());
+        _lineSpacing = std::max(_lineSpacing, fm.lineSpacing);
     } else {
         const auto fiLast = --_fragments.end();
         for (auto fi = _fragments.begin(); fi != _fragments.end(); ++fi) {
             TextFragment& f = *fi;
             f.pos.setX(x);
-            mu::draw::FontMetrics fm(f.font(t));
+            TextLayoutCache::Metrics fm = cache->metrics(f.font(t), f.text);
             if (f.format.valign() != VerticalAlignment::AlignNormal) {
-                double voffset = fm.xHeight() / subScriptSize;           // use original height
+                double voffset = fm.xHeight / subScriptSize;           // use original height
                 if (f.format.valign() == VerticalAlignment::AlignSubScript) {
                     voffset *= subScriptOffset;
                 } else {
@@ -942,12 +922,11 @@ void TextBlock::layout(TextBase* t)
             // Optimization: don't calculate character position
             // for the next fragment if there is no next fragment
             if (fi != fiLast) {
-                const double w  = fm.width(f.text);
-                x += w;
+                x += fm.width;
             }
 
-            _bbox   |= fm.tightBoundingRect(f.text).translated(f.pos);
-            _lineSpacing = std::max(_lineSpacing, fm.lineSpacing());
+            _bbox   |= fm.tightBoundingRect.translated(f.pos);
+            _lineSpacing = std::max(_lineSpacing, fm.lineSpacing);
         }
     }
 
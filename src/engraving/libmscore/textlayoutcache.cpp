@@ -0,0 +1,173 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "textlayoutcache.h"
+
+#include <cmath>
+
+#include "draw/fontmetrics.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+//! NOTE When the cache is full, the least recently used entry is dropped
+static constexpr size_t MAX_CACHE_SIZE = 100000;
+
+TextLayoutCache* TextLayoutCache::instance()
+{
+    static TextLayoutCache s;
+    return &s;
+}
+
+//---------------------------------------------------------
+//   Key
+//---------------------------------------------------------
+
+TextLayoutCache::Key::Key(const mu::draw::Font& f, const String& t)
+    : font(f), text(t), pointSize(std::llround(f.pointSizeF() * 1000.0))
+{
+}
+
+//---------------------------------------------------------
+//   KeyHash
+//---------------------------------------------------------
+
+size_t TextLayoutCache::KeyHash::operator()(const Key& k) const
+{
+    size_t h = k.text.hash();
+    h ^= k.font.family().hash() + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<int64_t> {}(k.pointSize) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<int> {}(k.font.pixelSize()) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<int> {}(static_cast<int>(k.font.weight())) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+template<typename T, typename Make>
+T TextLayoutCache::value(Cache<T>& cache, const mu::draw::Font& font, const String& text, Make make)
+{
+    Key key(font, text);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = cache.index.find(key);
+        if (it != cache.index.end()) {
+            ++m_stats.hits;
+            cache.entries.splice(cache.entries.begin(), cache.entries, it->second);
+            return it->second->second;
+        }
+        ++m_stats.misses;
+    }
+
+    //! NOTE Measure outside of the lock, the font provider may take a while for a new font
+    T val = make();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    //! NOTE Another thread may have measured the same text meanwhile
+    if (cache.index.find(key) != cache.index.end()) {
+        return val;
+    }
+
+    if (cache.index.size() >= MAX_CACHE_SIZE) {
+        cache.index.erase(cache.entries.back().first);
+        cache.entries.pop_back();
+    }
+
+    cache.entries.emplace_front(key, val);
+    cache.index.emplace(std::move(key), cache.entries.begin());
+
+    return val;
+}
+
+//---------------------------------------------------------
+//   metrics
+//---------------------------------------------------------
+
+TextLayoutCache::Metrics TextLayoutCache::metrics(const mu::draw::Font& font, const String& text)
+{
+    return value(m_metrics, font, text, [&font, &text]() {
+        mu::draw::FontMetrics fm(font);
+        Metrics m;
+        m.ascent = fm.ascent();
+        m.descent = fm.descent();
+        m.lineSpacing = fm.lineSpacing();
+        m.xHeight = fm.xHeight();
+        m.width = fm.width(text);
+        m.tightBoundingRect = fm.tightBoundingRect(text);
+        return m;
+    });
+}
+
+//---------------------------------------------------------
+//   isInFont
+//---------------------------------------------------------
+
+bool TextLayoutCache::isInFont(const mu::draw::Font& font, const String& text)
+{
+    return value(m_isInFont, font, text, [&font, &text]() {
+        mu::draw::FontMetrics fm(font);
+        for (size_t i = 0; i < text.size(); ++i) {
+            const Char& c = text.at(i);
+            if (c.isHighSurrogate()) {
+                if (i + 1 == text.size()) {
+                    ASSERT_X("bad string");
+                }
+                const Char& c2 = text.at(i + 1);
+                ++i;
+                char32_t v = Char::surrogateToUcs4(c, c2);
+                if (!fm.inFontUcs4(v)) {
+                    return false;
+                }
+            } else {
+                if (!fm.inFont(c)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    });
+}
+
+//---------------------------------------------------------
+//   stats
+//---------------------------------------------------------
+
+TextLayoutCache::Stats TextLayoutCache::stats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats s = m_stats;
+    s.size = m_metrics.index.size() + m_isInFont.index.size();
+    return s;
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void TextLayoutCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_metrics = Cache<Metrics>();
+    m_isInFont = Cache<bool>();
+    m_stats = Stats();
+}
@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __TEXTLAYOUTCACHE_H__
+#define __TEXTLAYOUTCACHE_H__
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "draw/types/font.h"
+#include "draw/types/geometry.h"
+#include "types/string.h"
+
+namespace mu::engraving {
+//---------------------------------------------------------
+//   TextLayoutCache
+//    font metrics of text fragments, shared by all scores;
+//    scores repeat the same short texts (syllables,
+//    dynamics, fingerings) many times, so measuring them
+//    once is enough for layout and painting
+//---------------------------------------------------------
+
+class TextLayoutCache
+{
+public:
+    struct Metrics {
+        double ascent = 0.0;
+        double descent = 0.0;
+        double lineSpacing = 0.0;
+        double xHeight = 0.0;
+        double width = 0.0;
+        RectF tightBoundingRect;
+    };
+
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t size = 0;
+
+        double hitRate() const { return hits + misses > 0 ? double(hits) / double(hits + misses) : 0.0; }
+    };
+
+    static TextLayoutCache* instance();
+
+    Metrics metrics(const mu::draw::Font& font, const String& text);
+
+    //! NOTE Whether the font has glyphs for all characters of the text
+    bool isInFont(const mu::draw::Font& font, const String& text);
+
+    Stats stats() const;
+
+    //! NOTE Must be called when the fonts change, the cached metrics may be stale then
+    void clear();
+
+private:
+    TextLayoutCache() = default;
+
+    struct Key {
+        Key(const mu::draw::Font& f, const String& t);
+
+        mu::draw::Font font;
+        String text;
+        int64_t pointSize = 0; // 1/1000 pt, the font compares the point size fuzzy
+
+        bool operator==(const Key& k) const { return pointSize == k.pointSize && font == k.font && text == k.text; }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& k) const;
+    };
+
+    //! NOTE The most recently used entries are at the front of the list
+    template<typename T>
+    struct Cache {
+        using Entries = std::list<std::pair<Key, T> >;
+
+        Entries entries;
+        std::unordered_map<Key, typename Entries::iterator, KeyHash> index;
+    };
+
+    template<typename T, typename Make>
+    T value(Cache<T>& cache, const mu::draw::Font& font, const String& text, Make make);
+
+    mutable std::mutex m_mutex;
+    Cache<Metrics> m_metrics;
+    Cache<bool> m_isInFont;
+    Stats m_stats;
+};
+} // namespace mu::engraving
+
+#endif
@@ -85,6 +85,24 @@ using namespace mu::engraving;
 namespace mu::engraving {
 extern Measure* tick2measure(int tick);
 
+//! NOTE rough average footprint of an element kept alive by the undo stack,
+//! used to estimate the memory held by element clones
+static constexpr size_t ESTIMATED_OBJECT_SIZE = 512;
+
+static size_t objectTreeMemoryUsage(const EngravingObject* object)
+{
+    if (!object) {
+        return 0;
+    }
+
+    size_t result = ESTIMATED_OBJECT_SIZE;
+    for (const EngravingObject* child : object->children()) {
+        result += objectTreeMemoryUsage(child);
+    }
+
+    return result;
+}
+
 static std::vector<const EngravingObject*> compoundObjects(const EngravingObject* object)
 {
     std::vector<const EngravingObject*> objects;
@@ -168,6 +186,20 @@ void UndoCommand::cleanup(bool undo)
     }
 }
 
+//---------------------------------------------------------
+//   memoryUsage
+//    estimated memory held by this command and its children
+//---------------------------------------------------------
+
+size_t UndoCommand::memoryUsage() const
+{
+    size_t result = ownMemoryUsage();
+    for (const UndoCommand* c : childList) {
+        result += c->memoryUsage();
+    }
+    return result;
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -338,6 +370,44 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
 #endif
     curCmd->appendChild(cmd);
     cmd->redo(ed);
+
+    if (mergeWithLast(cmd)) {
+        curCmd->removeChild();
+        delete cmd;
+    }
+}
+
+//---------------------------------------------------------
+//   mergeWithLast
+//    Consecutive changes of the same property of the same
+//    element need only the first command: it remembers the
+//    value from before the whole sequence, and undo/redo
+//    swap in whatever the element holds at that time.
+//    cmd must be the last child of curCmd and already
+//    executed.
+//---------------------------------------------------------
+
+bool UndoStack::mergeWithLast(UndoCommand* cmd)
+{
+    // subclasses of ChangeProperty do extra work on flip, leave them alone
+    if (strcmp(cmd->name(), "ChangeProperty")) {
+        return false;
+    }
+
+    const std::list<UndoCommand*>& commands = curCmd->commands();
+    if (commands.size() < 2) {
+        return false;
+    }
+
+    const UndoCommand* last = *std::prev(commands.end(), 2);
+    if (strcmp(last->name(), "ChangeProperty")) {
+        return false;
+    }
+
+    const ChangeProperty* lastChange = static_cast<const ChangeProperty*>(last);
+    const ChangeProperty* change = static_cast<const ChangeProperty*>(cmd);
+
+    return lastChange->getElement() == change->getElement() && lastChange->getId() == change->getId();
 }
 
 //---------------------------------------------------------
@@ -386,6 +456,9 @@ void UndoStack::remove(size_t idx)
 
 void UndoStack::mergeCommands(size_t startIdx)
 {
+    // startIdx comes from getCurIdx(), which counts evicted macros too
+    startIdx = startIdx > evictedCount ? startIdx - evictedCount : 0;
+
     assert(startIdx <= curIdx);
 
     if (startIdx >= list.size()) {
@@ -398,6 +471,7 @@ void UndoStack::mergeCommands(size_t startIdx)
         startMacro->append(std::move(*list[idx]));
     }
     remove(startIdx + 1);   // TODO: remove from startIdx to curIdx only
+    startMacro->updateMemoryUsage();
 }
 
 //---------------------------------------------------------
@@ -450,11 +524,68 @@ void UndoStack::endMacro(bool rollback)
             cmd->cleanup(false);        // delete elements for which UndoCommand() holds ownership
             delete cmd;
         }
+        curCmd->updateMemoryUsage();
         list.push_back(curCmd);
         stateList.push_back(nextState++);
         ++curIdx;
     }
     curCmd = 0;
+
+    if (!rollback) {
+        enforceMemoryLimit();
+    }
+}
+
+//---------------------------------------------------------
+//   memoryUsage
+//    estimated memory held by the undo history
+//---------------------------------------------------------
+
+size_t UndoStack::memoryUsage() const
+{
+    size_t result = 0;
+    for (const UndoMacro* macro : list) {
+        result += macro->cachedMemoryUsage();
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+//   setMemoryLimit
+//---------------------------------------------------------
+
+void UndoStack::setMemoryLimit(size_t bytes)
+{
+    memoryLimit = bytes;
+    if (!curCmd) {
+        enforceMemoryLimit();
+    }
+}
+
+//---------------------------------------------------------
+//   enforceMemoryLimit
+//    drop the oldest undo steps until the history fits
+//    into memoryLimit; the most recent step and the redo
+//    stack are always kept
+//---------------------------------------------------------
+
+void UndoStack::enforceMemoryLimit()
+{
+    if (memoryLimit == 0) {
+        return;
+    }
+
+    size_t usage = memoryUsage();
+    while (usage > memoryLimit && curIdx > 1) {
+        UndoMacro* macro = mu::takeFirst(list);
+        stateList.erase(stateList.begin());
+        --curIdx;
+        ++evictedCount;
+
+        usage -= macro->cachedMemoryUsage();
+        macro->cleanup(true);
+        delete macro;
+    }
 }
 
 //---------------------------------------------------------
@@ -493,7 +624,7 @@ void UndoStack::undo(EditData* ed)
     // Are we currently editing text?
     if (ed && ed->element && ed->element->isTextBase()) {
         TextEditData* ted = static_cast<TextEditData*>(ed->getData(ed->element).get());
-        if (ted && ted->startUndoIdx == curIdx) {
+        if (ted && ted->startUndoIdx == getCurIdx()) {
             // No edits to undo, so do nothing
             return;
         }
@@ -603,6 +734,12 @@ bool UndoMacro::empty() const
     return childCount() == 0;
 }
 
+size_t UndoMacro::ownMemoryUsage() const
+{
+    return sizeof(UndoMacro)
+           + (m_undoSelectionInfo.elements.capacity() + m_redoSelectionInfo.elements.capacity()) * sizeof(EngravingItem*);
+}
+
 void UndoMacro::append(UndoMacro&& other)
 {
     appendChildren(&other);
@@ -797,6 +934,12 @@ void AddElement::cleanup(bool undo)
     }
 }
 
+size_t AddElement::ownMemoryUsage() const
+{
+    // while the command is on the undo stack, the element belongs to the score
+    return sizeof(AddElement);
+}
+
 //---------------------------------------------------------
 //   undoRemoveTuplet
 //---------------------------------------------------------
@@ -993,6 +1136,12 @@ void RemoveElement::cleanup(bool undo)
     }
 }
 
+size_t RemoveElement::ownMemoryUsage() const
+{
+    // while the command is on the undo stack, the removed element belongs to it
+    return sizeof(RemoveElement) + objectTreeMemoryUsage(element);
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
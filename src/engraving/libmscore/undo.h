@@ -101,6 +101,7 @@ class UndoCommand
 protected:
     virtual void flip(EditData*) {}
     void appendChildren(UndoCommand*);
+    virtual size_t ownMemoryUsage() const { return sizeof(UndoCommand); }
 
 public:
     enum class Filter {
@@ -121,6 +122,7 @@ public:
     size_t childCount() const { return childList.size(); }
     void unwind();
     const std::list<UndoCommand*>& commands() const { return childList; }
+    size_t memoryUsage() const;
     virtual std::vector<const EngravingObject*> objectItems() const { return {}; }
     virtual void cleanup(bool undo);
 // #ifndef QT_NO_DEBUG
@@ -176,9 +178,17 @@ public:
 
     static bool canRecordSelectedElement(const EngravingItem* e);
 
+    size_t cachedMemoryUsage() const { return m_memoryUsage; }
+    void updateMemoryUsage() { m_memoryUsage = memoryUsage(); }
+
     UNDO_NAME("UndoMacro")
 
+protected:
+    size_t ownMemoryUsage() const override;
+
 private:
+    size_t m_memoryUsage = 0;
+
     InputState m_undoInputState;
     InputState m_redoInputState;
     SelectionInfo m_undoSelectionInfo;
@@ -198,8 +208,12 @@ class UndoStack
     int nextState;
     int cleanState;
     size_t curIdx = 0;
+    size_t evictedCount = 0;   // number of macros dropped from the bottom of the stack
+    size_t memoryLimit = 0;    // in bytes, 0 means unlimited
 
     void remove(size_t idx);
+    bool mergeWithLast(UndoCommand*);
+    void enforceMemoryLimit();
 
 public:
     UndoStack();
@@ -216,7 +230,7 @@ public:
     bool canRedo() const { return curIdx < list.size(); }
     int state() const { return stateList[curIdx]; }
     bool isClean() const { return cleanState == state(); }
-    size_t getCurIdx() const { return curIdx; }
+    size_t getCurIdx() const { return evictedCount + curIdx; }
     bool empty() const { return !canUndo() && !canRedo(); }
     UndoMacro* current() const { return curCmd; }
     UndoMacro* last() const { return curIdx > 0 ? list[curIdx - 1] : 0; }
@@ -228,6 +242,11 @@ public:
 
     void mergeCommands(size_t startIdx);
     void cleanRedoStack() { remove(curIdx); }
+
+    size_t memoryUsage() const;
+    size_t macroCount() const { return list.size(); }
+    size_t evictedMacroCount() const { return evictedCount; }
+    void setMemoryLimit(size_t bytes);
 };
 
 class InsertPart : public UndoCommand
@@ -623,6 +642,9 @@ class AddElement : public UndoCommand
     void undo(EditData*) override;
     void redo(EditData*) override;
 
+protected:
+    size_t ownMemoryUsage() const override;
+
 public:
     AddElement(EngravingItem*);
     EngravingItem* getElement() const { return element; }
@@ -642,6 +664,9 @@ class RemoveElement : public UndoCommand
 
     EngravingItem* element = nullptr;
 
+protected:
+    size_t ownMemoryUsage() const override;
+
 public:
     RemoveElement(EngravingItem*);
     void undo(EditData*) override;
@@ -1100,6 +1125,7 @@ protected:
     PropertyFlags flags;
 
     void flip(EditData*) override;
+    size_t ownMemoryUsage() const override { return sizeof(ChangeProperty); }
 
 public:
     ChangeProperty(EngravingObject* e, Pid i, const PropertyValue& v, PropertyFlags ps = PropertyFlags::NOSTYLE)
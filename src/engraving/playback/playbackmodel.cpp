@@ -228,6 +228,32 @@ void PlaybackModel::triggerEventsForItems(const std::vector<const EngravingItem*
     trackPlaybackData->second.offStream.send(std::move(result));
 }
 
+void PlaybackModel::triggerEventForPitch(const InstrumentTrackId& trackId, int pitch)
+{
+    auto trackPlaybackData = m_playbackDataMap.find(trackId);
+    if (trackPlaybackData == m_playbackDataMap.cend()) {
+        return;
+    }
+
+    constexpr timestamp_t actualTimestamp = 0;
+    constexpr dynamic_level_t actualDynamicLevel = dynamicLevelFromType(mpe::DynamicType::Natural);
+    duration_t actualDuration = MScore::defaultPlayDuration * 1000;
+    static ArticulationMap emptyArticulations;
+
+    //! NOTE The pitch is a MIDI note number, there is no note in the score yet to render
+    pitch_level_t eventPitchLevel = pitchLevel(static_cast<PitchClass>(pitch % 12), pitch / 12 - 1);
+
+    PlaybackEventsMap result;
+    result[actualTimestamp].emplace_back(mpe::NoteEvent(actualTimestamp,
+                                                        actualDuration,
+                                                        0,
+                                                        eventPitchLevel,
+                                                        actualDynamicLevel,
+                                                        emptyArticulations));
+
+    trackPlaybackData->second.offStream.send(std::move(result));
+}
+
 void PlaybackModel::triggerMetronome(int tick)
 {
     auto trackPlaybackData = m_playbackDataMap.find(metronomeTrackId());
@@ -71,6 +71,7 @@ public:
     const mpe::PlaybackData& resolveTrackPlaybackData(const InstrumentTrackId& trackId);
     const mpe::PlaybackData& resolveTrackPlaybackData(const ID& partId, const std::string& instrumentId);
     void triggerEventsForItems(const std::vector<const EngravingItem*>& items);
+    void triggerEventForPitch(const InstrumentTrackId& trackId, int pitch);
 
     void triggerMetronome(int tick);
 
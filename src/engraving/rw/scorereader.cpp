@@ -21,6 +21,8 @@
  */
 #include "scorereader.h"
 
+#include <thread>
+
 #include "io/buffer.h"
 
 #include "compat/readstyle.h"
@@ -38,6 +40,34 @@
 using namespace mu::io;
 using namespace mu::engraving;
 
+std::vector<std::future<ScoreReader::ExcerptFiles> > ScoreReader::readExcerptFilesAsync(const MscReader& mscReader,
+                                                                                        const std::vector<String>& excerptNames)
+{
+    std::vector<std::promise<ExcerptFiles> > promises(excerptNames.size());
+    std::vector<std::future<ExcerptFiles> > futures;
+    futures.reserve(promises.size());
+    for (std::promise<ExcerptFiles>& promise : promises) {
+        futures.push_back(promise.get_future());
+    }
+
+    if (excerptNames.empty()) {
+        return futures;
+    }
+
+    //! NOTE The files are read in order, so that the first excerpt can be parsed while the next ones are inflating
+    std::thread([&mscReader, excerptNames, promises = std::move(promises)]() mutable {
+        for (size_t i = 0; i < excerptNames.size(); ++i) {
+            ExcerptFiles files;
+            files.name = excerptNames.at(i);
+            files.styleData = mscReader.readExcerptStyleFile(files.name);
+            files.scoreData = mscReader.readExcerptFile(files.name);
+            promises.at(i).set_value(std::move(files));
+        }
+    }).detach();
+
+    return futures;
+}
+
 Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader, bool ignoreVersionError)
 {
     TRACEFUNC;
@@ -50,6 +80,8 @@ Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader,
 
     ScoreLoad sl;
 
+    BEGIN_STEP_TIME("loadMscz");
+
     // Read style
     {
         ByteArray styleData = mscReader.readStyleFile();
@@ -80,14 +112,24 @@ Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader,
         }
     }
 
+    STEP_TIME("loadMscz", "read style, chordlist and images");
+
     ReadContext masterScoreCtx(masterScore);
     masterScoreCtx.setIgnoreVersionError(ignoreVersionError);
 
     Err retval = Err::NoError;
 
+    ByteArray scoreData = mscReader.readScoreFile();
+
+    STEP_TIME("loadMscz", "read score file");
+
+    //! NOTE The excerpt files are read and inflated on a worker thread while the master score is parsing.
+    //! The reader is used only by the worker until all excerpt files are read.
+    std::vector<String> excerptNames = mscReader.excerptNames();
+    std::vector<std::future<ExcerptFiles> > excerptsFiles = readExcerptFilesAsync(mscReader, excerptNames);
+
     // Read score
     {
-        ByteArray scoreData = mscReader.readScoreFile();
         String docName = masterScore->fileInfo()->fileName().toString();
 
         compat::ReadStyleHook styleHook(masterScore, scoreData, docName);
@@ -99,10 +141,13 @@ Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader,
         retval = read(masterScore, xml, masterScoreCtx, &styleHook);
     }
 
+    STEP_TIME("loadMscz", "parse score");
+
     // Read excerpts
     if (masterScore->mscVersion() >= 400) {
-        std::vector<String> excerptNames = mscReader.excerptNames();
-        for (const String& excerptName : excerptNames) {
+        for (std::future<ExcerptFiles>& excerptFiles : excerptsFiles) {
+            ExcerptFiles files = excerptFiles.get();
+
             Score* partScore = masterScore->createScore();
 
             compat::ReadStyleHook::setupDefaultStyle(partScore);
@@ -110,18 +155,15 @@ Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader,
             Excerpt* ex = new Excerpt(masterScore);
             ex->setExcerptScore(partScore);
 
-            ByteArray excerptStyleData = mscReader.readExcerptStyleFile(excerptName);
-            Buffer excerptStyleBuf(&excerptStyleData);
+            Buffer excerptStyleBuf(&files.styleData);
             excerptStyleBuf.open(IODevice::ReadOnly);
             partScore->style().read(&excerptStyleBuf);
 
-            ByteArray excerptData = mscReader.readExcerptFile(excerptName);
-
             ReadContext ctx(partScore);
             ctx.initLinks(masterScoreCtx);
 
-            XmlReader xml(excerptData);
-            xml.setDocName(excerptName);
+            XmlReader xml(files.scoreData);
+            xml.setDocName(files.name);
             xml.setContext(&ctx);
 
             Read400::read400(partScore, xml, ctx);
@@ -129,10 +171,19 @@ Err ScoreReader::loadMscz(MasterScore* masterScore, const MscReader& mscReader,
             partScore->linkMeasures(masterScore);
             ex->setTracksMapping(xml.context()->tracks());
 
-            ex->setName(excerptName);
+            ex->setName(files.name);
 
             masterScore->addExcerpt(ex);
         }
+
+        STEP_TIME("loadMscz", "parse excerpts: " + std::to_string(excerptsFiles.size()));
+    }
+
+    // Make sure the worker has finished with the reader
+    for (std::future<ExcerptFiles>& excerptFiles : excerptsFiles) {
+        if (excerptFiles.valid()) {
+            excerptFiles.wait();
+        }
     }
 
     //  Read audio
@@ -22,6 +22,8 @@
 #ifndef MU_ENGRAVING_SCOREREADER_H
 #define MU_ENGRAVING_SCOREREADER_H
 
+#include <future>
+
 #include "../engravingerrors.h"
 
 #include "infrastructure/mscreader.h"
@@ -42,6 +44,16 @@ private:
 
     friend class MasterScore;
 
+    struct ExcerptFiles {
+        String name;
+        ByteArray styleData;
+        ByteArray scoreData;
+    };
+
+    //! NOTE Reads the files on a worker thread, the reader must not be used until all futures are ready
+    static std::vector<std::future<ExcerptFiles> > readExcerptFilesAsync(const MscReader& mscReader,
+                                                                          const std::vector<String>& excerptNames);
+
     Err read(MasterScore* score, XmlReader&, ReadContext& ctx, compat::ReadStyleHook* styleHook = nullptr);
     Err doRead(MasterScore* score, XmlReader& e, ReadContext& ctx);
 };
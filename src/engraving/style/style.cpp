@@ -37,6 +37,31 @@ using namespace mu;
 using namespace mu::io;
 using namespace mu::engraving;
 
+static bool isSameValue(const PropertyValue& v1, const PropertyValue& v2)
+{
+    return v1.type() == v2.type() && v1 == v2;
+}
+
+const std::shared_ptr<MStyle::Values>& MStyle::defaultValues()
+{
+    static const std::shared_ptr<Values> values = std::make_shared<Values>();
+    return values;
+}
+
+MStyle::MStyle()
+    : m_values(defaultValues())
+{
+}
+
+MStyle::Values& MStyle::mutableValues()
+{
+    if (m_values.use_count() > 1) {
+        m_values = std::make_shared<Values>(*m_values);
+    }
+
+    return *m_values;
+}
+
 const PropertyValue& MStyle::value(Sid idx) const
 {
     if (idx == Sid::NOSTYLE) {
@@ -44,9 +69,9 @@ const PropertyValue& MStyle::value(Sid idx) const
         return dummy;
     }
 
-    const PropertyValue& val = m_values[size_t(idx)];
-    if (val.isValid()) {
-        return val;
+    const uint16_t index = m_values->changedValueIndexes[size_t(idx)];
+    if (index) {
+        return m_values->changedValues[index - 1].second;
     }
 
     return StyleDef::styleValues[size_t(idx)].defaultValue();
@@ -58,7 +83,7 @@ Millimetre MStyle::valueMM(Sid idx) const
         return Millimetre();
     }
 
-    return m_precomputedValues[size_t(idx)];
+    return m_values->precomputedValues[size_t(idx)];
 }
 
 void MStyle::set(const Sid t, const PropertyValue& val)
@@ -67,26 +92,63 @@ void MStyle::set(const Sid t, const PropertyValue& val)
         return;
     }
 
+    //! NOTE Nothing to update, so don't detach the shared values
+    if (m_values->isPrecomputed && isSameValue(value(t), val)) {
+        return;
+    }
+
     const size_t idx = size_t(t);
-    m_values[idx] = val;
+    Values& values = mutableValues();
+    uint16_t& index = values.changedValueIndexes[idx];
+
+    if (!val.isValid() || isSameValue(val, StyleDef::styleValues[idx].defaultValue())) {
+        if (index) {
+            //! NOTE Move the last changed value into the freed place
+            const size_t pos = index - 1;
+            if (pos != values.changedValues.size() - 1) {
+                values.changedValues[pos] = std::move(values.changedValues.back());
+                values.changedValueIndexes[size_t(values.changedValues[pos].first)] = index;
+            }
+            values.changedValues.pop_back();
+            index = 0;
+        }
+    } else if (index) {
+        values.changedValues[index - 1].second = val;
+    } else {
+        values.changedValues.push_back({ t, val });
+        index = static_cast<uint16_t>(values.changedValues.size());
+    }
+
     if (t == Sid::spatium) {
-        precomputeValues();
+        updatePrecomputedValues(values);
     } else {
         if (StyleDef::styleValues[idx].valueType() == P_TYPE::SPATIUM) {
             double _spatium = value(Sid::spatium).toReal();
-            m_precomputedValues[idx] = m_values[idx].value<Spatium>().val() * _spatium;
+            values.precomputedValues[idx] = value(t).value<Spatium>().val() * _spatium;
         }
     }
 }
 
 void MStyle::precomputeValues()
+{
+    //! NOTE Once computed, the values are kept up to date by set(),
+    //! so a style shared with another one is not detached here
+    if (m_values->isPrecomputed) {
+        return;
+    }
+
+    updatePrecomputedValues(mutableValues());
+}
+
+void MStyle::updatePrecomputedValues(Values& values)
 {
     double _spatium = value(Sid::spatium).toReal();
     for (const StyleDef::StyleValue& t : StyleDef::styleValues) {
         if (t.valueType() == P_TYPE::SPATIUM) {
-            m_precomputedValues[t.idx()] = value(t.styleIdx()).value<Spatium>().val() * _spatium;
+            values.precomputedValues[t.idx()] = value(t.styleIdx()).value<Spatium>().val() * _spatium;
         }
     }
+    values.isPrecomputed = true;
 }
 
 bool MStyle::isDefault(Sid idx) const
@@ -104,6 +166,11 @@ int MStyle::defaultStyleVersion() const
     return styleI(Sid::defaultsVersion);
 }
 
+size_t MStyle::changedValuesCount() const
+{
+    return m_values->changedValues.size();
+}
+
 bool MStyle::readProperties(XmlReader& e)
 {
     const AsciiStringView tag(e.name());
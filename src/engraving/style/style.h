@@ -25,6 +25,8 @@
 
 #include <array>
 #include <cassert>
+#include <memory>
+#include <vector>
 
 #include "io/iodevice.h"
 
@@ -47,7 +49,9 @@ class XmlWriter;
 class MStyle
 {
 public:
-    MStyle() = default;
+    MStyle();
+    MStyle(const MStyle&) = default;
+    MStyle& operator=(const MStyle&) = default;
 
     const PropertyValue& styleV(Sid idx) const { return value(idx); }
     Spatium styleS(Sid idx) const
@@ -68,6 +72,9 @@ public:
     void set(Sid idx, const PropertyValue& v);
 
     bool isDefault(Sid idx) const;
+
+    //! NOTE Number of values that differ from the built-in defaults (see StyleDef)
+    size_t changedValuesCount() const;
     void setDefaultStyleVersion(const int defaultsVersion);
     int defaultStyleVersion() const;
 
@@ -78,6 +85,9 @@ public:
 
     void precomputeValues();
 
+    //! NOTE Whether the values are shared with the other style, i.e. none of them has been changed since the copy
+    bool sharesValuesWith(const MStyle& other) const { return m_values == other.m_values; }
+
     static P_TYPE valueType(const Sid);
     static const char* valueName(const Sid);
     static Sid styleIdx(const String& name);
@@ -92,8 +102,21 @@ private:
     bool readStyleValCompat(XmlReader&);
     bool readTextStyleValCompat(XmlReader&);
 
-    std::array<PropertyValue, size_t(Sid::STYLES)> m_values;
-    std::array<Millimetre, size_t(Sid::STYLES)> m_precomputedValues;
+    //! NOTE Only the values that differ from the built-in defaults are stored.
+    //! The storage is shared between the copies of a style and is copied on the first change,
+    //! so creating a score or an excerpt doesn't copy the whole style table
+    struct Values {
+        std::vector<std::pair<Sid, PropertyValue> > changedValues;
+        std::array<uint16_t, size_t(Sid::STYLES)> changedValueIndexes = {}; // index in changedValues + 1, 0 - not changed
+        std::array<Millimetre, size_t(Sid::STYLES)> precomputedValues = {};
+        bool isPrecomputed = false;
+    };
+
+    static const std::shared_ptr<Values>& defaultValues();
+    Values& mutableValues();
+    void updatePrecomputedValues(Values& values);
+
+    std::shared_ptr<Values> m_values;
 };
 } // namespace mu::engraving
 
@@ -0,0 +1,143 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "libmscore/instrtemplate.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String INSTRUMENTS_XML(u":/data/instruments.xml");
+
+class Engraving_InstrumentTemplatesTests : public ::testing::Test
+{
+public:
+    //! NOTE The lookup by id as it was done before the index: the first template with the id, in the order of the groups
+    static InstrumentTemplate* scanTemplate(const String& id)
+    {
+        for (InstrumentGroup* g : instrumentGroups) {
+            for (InstrumentTemplate* it : g->instrumentTemplates) {
+                if (it->id == id) {
+                    return it;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    static int64_t elapsedUs(const std::chrono::steady_clock::time_point& start)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+//---------------------------------------------------------
+///   searchById
+///   the id indexes give the same templates and positions
+///   as a scan of the groups
+//---------------------------------------------------------
+
+TEST_F(Engraving_InstrumentTemplatesTests, searchById)
+{
+    ASSERT_FALSE(instrumentGroups.empty());
+
+    int groupIndex = 0;
+    int instrIndex = 0;
+    size_t checked = 0;
+
+    for (InstrumentGroup* g : instrumentGroups) {
+        for (InstrumentTemplate* t : g->instrumentTemplates) {
+            InstrumentTemplate* expected = scanTemplate(t->id);
+            EXPECT_EQ(searchTemplate(t->id), expected);
+
+            //! NOTE Only the first template with an id is found, the copies made by <ref> are not
+            if (expected == t) {
+                InstrumentIndex index = searchTemplateIndexForId(t->id);
+                EXPECT_EQ(index.groupIndex, groupIndex);
+                EXPECT_EQ(index.instrIndex, instrIndex);
+                EXPECT_EQ(index.instrTemplate, t);
+                ++checked;
+            }
+
+            ++instrIndex;
+        }
+        ++groupIndex;
+    }
+
+    EXPECT_GT(checked, 0u);
+
+    EXPECT_EQ(searchTemplate(u"no-such-instrument"), nullptr);
+
+    InstrumentIndex notFound = searchTemplateIndexForId(u"no-such-instrument");
+    EXPECT_EQ(notFound.groupIndex, -1);
+    EXPECT_EQ(notFound.instrIndex, instrIndex);
+    EXPECT_EQ(notFound.instrTemplate, nullptr);
+}
+
+//---------------------------------------------------------
+///   loadTime
+///   reloads instruments.xml and measures the load against
+///   the id scans the load did before the index, one for
+///   every <Instrument> and <ref> element
+//---------------------------------------------------------
+
+TEST_F(Engraving_InstrumentTemplatesTests, loadTime)
+{
+    clearInstrumentTemplates();
+
+    auto loadStart = std::chrono::steady_clock::now();
+    ASSERT_TRUE(loadInstrumentTemplates(INSTRUMENTS_XML));
+    const int64_t loadUs = elapsedUs(loadStart);
+
+    std::vector<String> ids;
+    for (InstrumentGroup* g : instrumentGroups) {
+        for (InstrumentTemplate* t : g->instrumentTemplates) {
+            ids.push_back(t->id);
+        }
+    }
+    ASSERT_FALSE(ids.empty());
+
+    size_t found = 0;
+
+    auto scanStart = std::chrono::steady_clock::now();
+    for (const String& id : ids) {
+        found += scanTemplate(id) ? 1 : 0;
+    }
+    const int64_t scanUs = elapsedUs(scanStart);
+
+    auto indexStart = std::chrono::steady_clock::now();
+    for (const String& id : ids) {
+        found += searchTemplate(id) ? 1 : 0;
+    }
+    const int64_t indexUs = elapsedUs(indexStart);
+
+    EXPECT_EQ(found, 2 * ids.size());
+
+    LOGI() << "templates: " << ids.size() << ", load: " << loadUs << " us"
+           << ", id lookups by scan (removed from the load): " << scanUs << " us"
+           << ", by index: " << indexUs << " us";
+}
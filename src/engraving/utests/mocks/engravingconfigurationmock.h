@@ -69,6 +69,9 @@ public:
     MOCK_METHOD(async::Notification, debuggingOptionsChanged, (), (const, override));
 
     MOCK_METHOD(bool, isAccessibleEnabled, (), (const, override));
+
+    MOCK_METHOD(size_t, undoHistoryMemoryLimit, (), (const, override));
+    MOCK_METHOD(async::Notification, undoHistoryMemoryLimitChanged, (), (const, override));
 };
 }
 
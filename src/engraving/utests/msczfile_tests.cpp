@@ -26,14 +26,43 @@
 #include "io/buffer.h"
 #include "infrastructure/mscwriter.h"
 #include "infrastructure/mscreader.h"
+#include "compat/writescorehook.h"
+#include "libmscore/excerpt.h"
+#include "libmscore/masterscore.h"
+#include "rw/writecontext.h"
+
+#include "utils/scorerw.h"
 
 using namespace mu;
 using namespace mu::io;
 using namespace mu::engraving;
 
+static const String MSCZFILE_DATA_DIR(u"chordsymbol_data/");
+
 class Engraving_MsczFileTests : public ::testing::Test
 {
 public:
+    static void addExcerpt(MasterScore* score, Part* part)
+    {
+        Score* nscore = score->createScore();
+
+        Excerpt* ex = new Excerpt(score);
+        ex->setExcerptScore(nscore);
+        nscore->setExcerpt(ex);
+        score->excerpts().push_back(ex);
+        ex->setName(part->partName());
+        ex->setParts({ part });
+        Excerpt::createExcerpt(ex);
+    }
+
+    static ByteArray styleData(Score* score)
+    {
+        ByteArray data;
+        Buffer buf(&data);
+        buf.open(IODevice::WriteOnly);
+        score->style().write(&buf);
+        return data;
+    }
 };
 
 TEST_F(Engraving_MsczFileTests, MsczFile_WriteRead)
@@ -87,3 +116,85 @@ TEST_F(Engraving_MsczFileTests, MsczFile_WriteRead)
         EXPECT_EQ(imageData, originImageData);
     }
 }
+
+TEST_F(Engraving_MsczFileTests, MsczFile_WriteScoreWithExcerpts)
+{
+    //! CASE Writing a score with excerpts gives the same files as the sequential serialization
+
+    //! GIVEN A score with an excerpt for each part
+    MasterScore* score = ScoreRW::readScore(MSCZFILE_DATA_DIR + u"no-system.mscx");
+    ASSERT_TRUE(score);
+
+    for (Part* part : score->parts()) {
+        addExcerpt(score, part);
+    }
+    score->setExcerptsChanged(true);
+    score->doLayout();
+
+    ASSERT_EQ(score->excerpts().size(), 2u);
+
+    //! GIVEN Files serialized one after another
+    ByteArray refStyleData = styleData(score);
+    ByteArray refScoreData;
+    std::vector<ByteArray> refExcerptsStyleData;
+    std::vector<ByteArray> refExcerptsData;
+    {
+        WriteContext ctx;
+        compat::WriteScoreHook hook;
+
+        Buffer scoreBuf(&refScoreData);
+        scoreBuf.open(IODevice::ReadWrite);
+        score->writeScore(&scoreBuf, false, false, hook, ctx);
+
+        for (const Excerpt* excerpt : score->excerpts()) {
+            refExcerptsStyleData.push_back(styleData(excerpt->excerptScore()));
+
+            ByteArray excerptData;
+            Buffer excerptBuf(&excerptData);
+            excerptBuf.open(IODevice::ReadWrite);
+            excerpt->excerptScore()->writeScore(&excerptBuf, false, false, hook, ctx);
+            refExcerptsData.push_back(excerptData);
+        }
+    }
+
+    //! DO Write mscz
+    ByteArray msczData;
+    {
+        Buffer buf(&msczData);
+        MscWriter::Params params;
+        params.device = &buf;
+        params.filePath = "excerpts.mscz";
+        params.mode = MscIoMode::Zip;
+
+        MscWriter writer(params);
+        writer.open();
+
+        EXPECT_TRUE(score->writeMscz(writer, false, false));
+    }
+
+    //! CHECK Read and compare with the sequential serialization
+    {
+        Buffer buf(&msczData);
+        MscReader::Params params;
+        params.device = &buf;
+        params.filePath = "excerpts.mscz";
+        params.mode = MscIoMode::Zip;
+
+        MscReader reader(params);
+        reader.open();
+
+        EXPECT_EQ(reader.readStyleFile(), refStyleData);
+        EXPECT_EQ(reader.readScoreFile(), refScoreData);
+
+        std::vector<String> excerptNames = reader.excerptNames();
+        ASSERT_EQ(excerptNames.size(), refExcerptsData.size());
+
+        for (size_t i = 0; i < score->excerpts().size(); ++i) {
+            const String& name = score->excerpts().at(i)->name();
+            EXPECT_EQ(reader.readExcerptStyleFile(name), refExcerptsStyleData.at(i));
+            EXPECT_EQ(reader.readExcerptFile(name), refExcerptsData.at(i));
+        }
+    }
+
+    delete score;
+}
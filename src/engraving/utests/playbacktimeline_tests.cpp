@@ -0,0 +1,154 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "libmscore/chord.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/note.h"
+#include "libmscore/playbacktimeline.h"
+#include "libmscore/repeatlist.h"
+#include "libmscore/segment.h"
+#include "types/constants.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String UNROLLREPEATS_DATA_DIR(u"unrollrepeats_data/");
+static const String TEMPOMAP_DATA_DIR(u"tempomap_data/");
+
+class Engraving_PlaybackTimelineTests : public ::testing::Test
+{
+protected:
+    void compareWithRepeatList(MasterScore* score)
+    {
+        PlaybackTimelinePtr timeline = score->playbackTimeline();
+        const RepeatList& repeatList = score->repeatList();
+
+        ASSERT_EQ(timeline->ticks(), repeatList.ticks());
+        EXPECT_DOUBLE_EQ(timeline->duration(), repeatList.utick2utime(repeatList.ticks()));
+
+        for (int utick = 0; utick <= repeatList.ticks(); utick += Constants::division / 4) {
+            EXPECT_EQ(timeline->utick2tick(utick), repeatList.utick2tick(utick));
+            EXPECT_DOUBLE_EQ(timeline->utick2utime(utick), repeatList.utick2utime(utick));
+
+            double utime = repeatList.utick2utime(utick);
+            EXPECT_EQ(timeline->utime2utick(utime), repeatList.utime2utick(utime));
+        }
+
+        for (int tick = 0; tick < score->endTick().ticks(); tick += Constants::division / 4) {
+            EXPECT_EQ(timeline->tick2utick(tick), repeatList.tick2utick(tick));
+        }
+    }
+};
+
+TEST_F(Engraving_PlaybackTimelineTests, Repeats)
+{
+    MasterScore* score = ScoreRW::readScore(UNROLLREPEATS_DATA_DIR + u"pickup-measure-test.mscx");
+    ASSERT_TRUE(score);
+
+    compareWithRepeatList(score);
+
+    delete score;
+}
+
+TEST_F(Engraving_PlaybackTimelineTests, GradualTempoChange)
+{
+    MasterScore* score = ScoreRW::readScore(TEMPOMAP_DATA_DIR + u"gradual_tempo_change_accelerando/gradual_tempo_change_accelerando.mscx");
+    ASSERT_TRUE(score);
+
+    compareWithRepeatList(score);
+
+    delete score;
+}
+
+TEST_F(Engraving_PlaybackTimelineTests, SnapshotIsKeptUntilChange)
+{
+    MasterScore* score = ScoreRW::readScore(UNROLLREPEATS_DATA_DIR + u"pickup-measure-test.mscx");
+    ASSERT_TRUE(score);
+
+    PlaybackTimelinePtr timeline = score->playbackTimeline();
+    EXPECT_EQ(timeline, score->playbackTimeline());
+
+    //! NOTE A dirty repeat list gives a new snapshot, the old one stays valid for its readers
+    score->setPlaylistDirty();
+    PlaybackTimelinePtr newTimeline = score->playbackTimeline();
+    EXPECT_NE(timeline, newTimeline);
+    EXPECT_EQ(timeline->ticks(), newTimeline->ticks());
+
+    //! NOTE Every chord/rest segment has a cursor position
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        PlaybackTimeline::Position pos = newTimeline->position(s->tick().ticks());
+        EXPECT_TRUE(pos.isValid());
+        EXPECT_FALSE(newTimeline->cursorRect(s->tick().ticks()).isEmpty());
+    }
+
+    delete score;
+}
+
+TEST_F(Engraving_PlaybackTimelineTests, RangeLayoutKeepsOtherPositions)
+{
+    MasterScore* score = ScoreRW::readScore(u"all_elements_data/moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    PlaybackTimelinePtr timeline = score->playbackTimeline();
+
+    //! DO Change a note in the middle of the score, only its pages are laid out again
+    Measure* measure = score->firstMeasure();
+    for (int i = 0; i < 20 && measure->nextMeasure(); ++i) {
+        measure = measure->nextMeasure();
+    }
+
+    Chord* chord = nullptr;
+    for (Segment* s = measure->first(SegmentType::ChordRest); s && !chord; s = s->next(SegmentType::ChordRest)) {
+        if (s->element(0) && s->element(0)->isChord()) {
+            chord = toChord(s->element(0));
+        }
+    }
+    ASSERT_TRUE(chord);
+
+    score->startCmd();
+    chord->upNote()->undoChangeProperty(Pid::PITCH, chord->upNote()->pitch() + 1);
+    score->endCmd();
+
+    //! CHECK The updated snapshot has the same positions as a new one
+    PlaybackTimelinePtr updated = score->playbackTimeline();
+    EXPECT_NE(updated, timeline);
+
+    PlaybackTimeline built(score);
+    EXPECT_EQ(updated->ticks(), built.ticks());
+
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        int tick = s->tick().ticks();
+        PlaybackTimeline::Position pos = updated->position(tick);
+        PlaybackTimeline::Position builtPos = built.position(tick);
+        EXPECT_EQ(pos.segment, builtPos.segment);
+        EXPECT_DOUBLE_EQ(pos.x, builtPos.x);
+        EXPECT_DOUBLE_EQ(pos.y, builtPos.y);
+        EXPECT_EQ(updated->cursorRect(tick), built.cursorRect(tick));
+    }
+
+    delete score;
+}
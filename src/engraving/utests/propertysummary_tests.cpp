@@ -0,0 +1,259 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/propertysummary.h"
+#include "libmscore/select.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String PROPERTYSUMMARY_SCORE(u"all_elements_data/moonlight.mscx");
+
+static const std::vector<Pid> NOTE_PIDS {
+    Pid::VISIBLE, Pid::COLOR, Pid::SMALL, Pid::OFFSET, Pid::PLAY, Pid::PITCH, Pid::TPC1, Pid::HEAD_GROUP, Pid::HEAD_TYPE,
+    Pid::MIRROR_HEAD, Pid::DOT_POSITION, Pid::TUNING, Pid::FIXED, Pid::GHOST, Pid::VELO_TYPE, Pid::AUTOPLACE
+};
+
+class Engraving_PropertySummaryTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_score = ScoreRW::readScore(PROPERTYSUMMARY_SCORE);
+        ASSERT_TRUE(m_score);
+        m_score->doLayout();
+
+        m_score->cmdSelectAll();
+        for (EngravingItem* e : m_score->selection().elements()) {
+            if (e->isNote()) {
+                m_notes.push_back(e);
+            }
+        }
+        m_score->deselectAll();
+
+        ASSERT_FALSE(m_notes.empty());
+    }
+
+    void TearDown() override
+    {
+        delete m_score;
+    }
+
+    //! NOTE The summary as the inspector computed it before, with a pass over the elements for every property
+    static PropertySummary scan(const std::vector<EngravingItem*>& elements, Pid pid)
+    {
+        PropertySummary summary;
+
+        for (const EngravingItem* e : elements) {
+            summary.styleId = e->getPropertyStyle(pid);
+            if (summary.styleId != Sid::NOSTYLE) {
+                break;
+            }
+        }
+
+        for (const EngravingItem* e : elements) {
+            PropertyValue value = e->getProperty(pid);
+            PropertyValue defaultValue = e->propertyDefault(pid);
+            if (!value.isValid()) {
+                continue;
+            }
+
+            if (!summary.element) {
+                summary.value = value;
+                summary.defaultValue = defaultValue;
+                summary.element = e;
+            } else if (!(summary.value.type() == value.type() && summary.value == value)) {
+                summary.isMixed = true;
+                break;
+            }
+        }
+
+        return summary;
+    }
+
+    static void expectSameSummaries(const PropertySummaryBuilder& builder, const std::vector<EngravingItem*>& elements)
+    {
+        for (Pid pid : NOTE_PIDS) {
+            const PropertySummary* summary = builder.summary(pid);
+            ASSERT_TRUE(summary);
+
+            PropertySummary expected = scan(elements, pid);
+            EXPECT_EQ(summary->isMixed, expected.isMixed) << propertyName(pid);
+            EXPECT_EQ(summary->styleId, expected.styleId) << propertyName(pid);
+            EXPECT_EQ(summary->element, expected.element) << propertyName(pid);
+            EXPECT_TRUE(summary->value == expected.value) << propertyName(pid);
+            EXPECT_TRUE(summary->defaultValue == expected.defaultValue) << propertyName(pid);
+        }
+    }
+
+    static int64_t elapsedUs(const std::chrono::steady_clock::time_point& start)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    MasterScore* m_score = nullptr;
+    std::vector<EngravingItem*> m_notes;
+};
+
+//---------------------------------------------------------
+///   onePass
+///   the summaries of one pass are the ones of a pass
+///   for every property
+//---------------------------------------------------------
+
+TEST_F(Engraving_PropertySummaryTests, onePass)
+{
+    PropertySummaryBuilder builder(m_notes, NOTE_PIDS);
+    EXPECT_TRUE(builder.process());
+    EXPECT_TRUE(builder.isFinished());
+
+    expectSameSummaries(builder, m_notes);
+
+    //! NOTE The notes of the score have different pitches, and the same visibility
+    EXPECT_TRUE(builder.summary(Pid::PITCH)->isMixed);
+    EXPECT_FALSE(builder.summary(Pid::VISIBLE)->isMixed);
+    EXPECT_EQ(builder.summary(Pid::SLUR_STYLE_TYPE), nullptr);
+}
+
+//---------------------------------------------------------
+///   steps
+///   a pass in steps gives the same summaries, which are
+///   only available once the pass is finished
+//---------------------------------------------------------
+
+TEST_F(Engraving_PropertySummaryTests, steps)
+{
+    //! NOTE Only equal properties, so the pass can't end early
+    std::vector<Pid> pids { Pid::VISIBLE, Pid::SMALL, Pid::FIXED };
+
+    PropertySummaryBuilder builder(m_notes, pids);
+
+    size_t steps = 0;
+    while (!builder.process(7)) {
+        EXPECT_EQ(builder.summary(Pid::VISIBLE), nullptr);
+        ++steps;
+    }
+
+    EXPECT_EQ(steps, (m_notes.size() - 1) / 7);
+
+    for (Pid pid : pids) {
+        const PropertySummary* summary = builder.summary(pid);
+        ASSERT_TRUE(summary);
+
+        PropertySummary expected = scan(m_notes, pid);
+        EXPECT_EQ(summary->isMixed, expected.isMixed);
+        EXPECT_TRUE(summary->value == expected.value);
+    }
+}
+
+//---------------------------------------------------------
+///   cancel
+///   a canceled pass doesn't go on and has no summaries
+//---------------------------------------------------------
+
+TEST_F(Engraving_PropertySummaryTests, cancel)
+{
+    ASSERT_GT(m_notes.size(), 1u);
+
+    PropertySummaryBuilder builder(m_notes, NOTE_PIDS);
+    EXPECT_FALSE(builder.process(1));
+
+    builder.cancel();
+
+    EXPECT_TRUE(builder.isCanceled());
+    EXPECT_FALSE(builder.process());
+    EXPECT_FALSE(builder.isFinished());
+    EXPECT_EQ(builder.summary(Pid::PITCH), nullptr);
+}
+
+//---------------------------------------------------------
+///   valuesEqual
+///   the caller decides which values are the same
+//---------------------------------------------------------
+
+TEST_F(Engraving_PropertySummaryTests, valuesEqual)
+{
+    auto samePitchClass = [](Pid pid, const PropertyValue& value1, const EngravingItem*, const PropertyValue& value2,
+                             const EngravingItem*) {
+        if (pid == Pid::PITCH) {
+            return value1.toInt() % 12 == value2.toInt() % 12;
+        }
+        return value1 == value2;
+    };
+
+    //! NOTE Only the notes that have the pitch class of the first one
+    std::vector<EngravingItem*> notes;
+    int pitchClass = m_notes.front()->getProperty(Pid::PITCH).toInt() % 12;
+    for (EngravingItem* note : m_notes) {
+        if (note->getProperty(Pid::PITCH).toInt() % 12 == pitchClass) {
+            notes.push_back(note);
+        }
+    }
+
+    PropertySummaryBuilder builder(notes, { Pid::PITCH }, samePitchClass);
+    EXPECT_TRUE(builder.process());
+    EXPECT_FALSE(builder.summary(Pid::PITCH)->isMixed);
+    EXPECT_EQ(builder.summary(Pid::PITCH)->element, notes.front());
+}
+
+//---------------------------------------------------------
+///   benchmark
+///   a selection of 50k notes, one pass against a pass for
+///   every property
+//---------------------------------------------------------
+
+TEST_F(Engraving_PropertySummaryTests, benchmark)
+{
+    const size_t selectionSize = 50000;
+
+    std::vector<EngravingItem*> selection;
+    selection.reserve(selectionSize);
+    while (selection.size() < selectionSize) {
+        selection.push_back(m_notes[selection.size() % m_notes.size()]);
+    }
+
+    auto scanStart = std::chrono::steady_clock::now();
+    std::vector<PropertySummary> scanned;
+    for (Pid pid : NOTE_PIDS) {
+        scanned.push_back(scan(selection, pid));
+    }
+    const int64_t scanUs = elapsedUs(scanStart);
+
+    auto passStart = std::chrono::steady_clock::now();
+    PropertySummaryBuilder builder(selection, NOTE_PIDS);
+    EXPECT_TRUE(builder.process());
+    const int64_t passUs = elapsedUs(passStart);
+
+    expectSameSummaries(builder, selection);
+
+    LOGI() << "elements: " << selection.size() << ", properties: " << NOTE_PIDS.size()
+           << ", pass per property: " << scanUs << " us, one pass: " << passUs << " us";
+}
@@ -0,0 +1,201 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/select.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String SELECTION_SCORE(u"all_elements_data/moonlight.mscx");
+
+class Engraving_SelectionTests : public ::testing::Test
+{
+};
+
+class ElapsedTimer
+{
+public:
+    ElapsedTimer()
+        : m_start(std::chrono::steady_clock::now()) {}
+
+    int64_t elapsedUs() const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+};
+
+//---------------------------------------------------------
+///   selectAllDeselect
+///   select-all materializes every element once, and
+///   deselecting them one by one empties the selection
+//---------------------------------------------------------
+
+TEST_F(Engraving_SelectionTests, selectAllDeselect)
+{
+    MasterScore* score = ScoreRW::readScore(SELECTION_SCORE);
+    ASSERT_TRUE(score);
+    score->doLayout();
+
+    ElapsedTimer selectTimer;
+    score->cmdSelectAll();
+    const int64_t selectUs = selectTimer.elapsedUs();
+
+    const Selection& selection = score->selection();
+    EXPECT_TRUE(selection.isRange());
+
+    const std::vector<EngravingItem*> elements = selection.elements();
+    ASSERT_FALSE(elements.empty());
+    EXPECT_EQ(selection.elementsCount(), elements.size());
+
+    for (EngravingItem* e : elements) {
+        EXPECT_TRUE(e->selected());
+        EXPECT_TRUE(selection.contains(e));
+    }
+
+    ElapsedTimer deselectTimer;
+    for (EngravingItem* e : elements) {
+        score->deselect(e);
+    }
+    const int64_t deselectUs = deselectTimer.elapsedUs();
+
+    EXPECT_TRUE(selection.isNone());
+    EXPECT_TRUE(selection.elements().empty());
+    for (EngravingItem* e : elements) {
+        EXPECT_FALSE(e->selected());
+    }
+
+    LOGI() << "elements: " << elements.size() << ", select all: " << selectUs << " us, deselect one by one: " << deselectUs << " us";
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   removeAndAddAgain
+///   an element removed and added back is listed once
+//---------------------------------------------------------
+
+TEST_F(Engraving_SelectionTests, removeAndAddAgain)
+{
+    MasterScore* score = ScoreRW::readScore(SELECTION_SCORE);
+    ASSERT_TRUE(score);
+    score->doLayout();
+
+    score->cmdSelectAll();
+    std::vector<EngravingItem*> elements = score->selection().elements();
+    ASSERT_GE(elements.size(), 2u);
+
+    score->deselectAll();
+    score->select(elements[0], SelectType::ADD);
+    score->select(elements[1], SelectType::ADD);
+    score->deselect(elements[0]);
+    score->select(elements[0], SelectType::ADD);
+
+    const Selection& selection = score->selection();
+    ASSERT_EQ(selection.elements().size(), 2u);
+    EXPECT_EQ(selection.elements()[0], elements[1]);
+    EXPECT_EQ(selection.elements()[1], elements[0]);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   filterToggle
+///   switching a voice off and on again restores the
+///   same range selection
+//---------------------------------------------------------
+
+TEST_F(Engraving_SelectionTests, filterToggle)
+{
+    MasterScore* score = ScoreRW::readScore(SELECTION_SCORE);
+    ASSERT_TRUE(score);
+    score->doLayout();
+
+    score->cmdSelectAll();
+    Selection& selection = score->selection();
+    const size_t count = selection.elementsCount();
+
+    ElapsedTimer timer;
+    score->selectionFilter().setFiltered(SelectionFilterType::FIRST_VOICE, false);
+    selection.updateSelectedElements();
+
+    for (const EngravingItem* e : selection.elements()) {
+        EXPECT_NE(e->voice(), 0u);
+    }
+    EXPECT_LT(selection.elementsCount(), count);
+
+    score->selectionFilter().setFiltered(SelectionFilterType::FIRST_VOICE, true);
+    selection.updateSelectedElements();
+    const int64_t toggleUs = timer.elapsedUs();
+
+    EXPECT_EQ(selection.elementsCount(), count);
+
+    LOGI() << "elements: " << count << ", filter toggle: " << toggleUs << " us";
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   shiftExtend
+///   extending a range measure by measure only grows
+///   the selection
+//---------------------------------------------------------
+
+TEST_F(Engraving_SelectionTests, shiftExtend)
+{
+    MasterScore* score = ScoreRW::readScore(SELECTION_SCORE);
+    ASSERT_TRUE(score);
+    score->doLayout();
+
+    Measure* first = score->firstMeasure();
+    ASSERT_TRUE(first);
+    score->select(first, SelectType::SINGLE, 0);
+
+    const Selection& selection = score->selection();
+    size_t count = selection.elementsCount();
+
+    ElapsedTimer timer;
+    for (Measure* m = first->nextMeasure(); m; m = m->nextMeasure()) {
+        score->select(m, SelectType::RANGE, 0);
+        EXPECT_GE(selection.elementsCount(), count);
+        count = selection.elementsCount();
+    }
+    const int64_t extendUs = timer.elapsedUs();
+
+    EXPECT_TRUE(selection.isRange());
+
+    LOGI() << "elements: " << count << ", shift-extend to the end: " << extendUs << " us";
+
+    delete score;
+}
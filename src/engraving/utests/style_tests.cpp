@@ -0,0 +1,146 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "io/buffer.h"
+
+#include "compat/scoreaccess.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/mscore.h"
+#include "style/defaultstyle.h"
+#include "style/style.h"
+
+using namespace mu;
+using namespace mu::io;
+using namespace mu::engraving;
+
+class Engraving_StyleTests : public ::testing::Test
+{
+};
+
+TEST_F(Engraving_StyleTests, OnlyChangedValuesAreStored)
+{
+    MStyle style;
+    EXPECT_EQ(style.changedValuesCount(), 0u);
+
+    style.set(Sid::concertPitch, true);
+    style.set(Sid::staffDistance, Spatium(8.0));
+    style.set(Sid::minNoteDistance, MStyle().value(Sid::minNoteDistance));
+    EXPECT_EQ(style.changedValuesCount(), 2u);
+    EXPECT_TRUE(style.styleB(Sid::concertPitch));
+    EXPECT_EQ(style.styleS(Sid::staffDistance), Spatium(8.0));
+
+    //! NOTE Setting the default value back drops the stored value
+    style.set(Sid::concertPitch, false);
+    EXPECT_EQ(style.changedValuesCount(), 1u);
+    EXPECT_FALSE(style.styleB(Sid::concertPitch));
+    EXPECT_EQ(style.styleS(Sid::staffDistance), Spatium(8.0));
+}
+
+TEST_F(Engraving_StyleTests, CopyOnWrite)
+{
+    MStyle style;
+    style.set(Sid::staffDistance, Spatium(8.0));
+    style.precomputeValues();
+
+    MStyle copy = style;
+    copy.set(Sid::spatium, 30.0);
+    copy.set(Sid::staffDistance, Spatium(5.0));
+
+    //! NOTE The original is not changed by the changes of the copy
+    EXPECT_EQ(style.styleS(Sid::staffDistance), Spatium(8.0));
+    EXPECT_DOUBLE_EQ(style.styleMM(Sid::staffDistance).val(), 8.0 * style.styleD(Sid::spatium));
+
+    EXPECT_EQ(copy.styleS(Sid::staffDistance), Spatium(5.0));
+    EXPECT_DOUBLE_EQ(copy.styleMM(Sid::staffDistance).val(), 5.0 * 30.0);
+    EXPECT_EQ(copy.changedValuesCount(), 2u);
+}
+
+TEST_F(Engraving_StyleTests, WriteAndReadBack)
+{
+    MStyle style = DefaultStyle::baseStyle();
+    style.set(Sid::spatium, 1.5 * DPMM);
+    style.set(Sid::concertPitch, true);
+    style.set(Sid::staffDistance, Spatium(8.0));
+
+    ByteArray data;
+    Buffer writeBuf(&data);
+    writeBuf.open(IODevice::WriteOnly);
+    style.write(&writeBuf);
+
+    //! NOTE All values are written, but only the changed ones are stored when read back
+    MStyle readStyle;
+    Buffer readBuf(&data);
+    readBuf.open(IODevice::ReadOnly);
+    ASSERT_TRUE(readStyle.read(&readBuf));
+
+    EXPECT_EQ(readStyle.changedValuesCount(), style.changedValuesCount());
+    EXPECT_DOUBLE_EQ(readStyle.styleD(Sid::spatium), 1.5 * DPMM);
+    EXPECT_TRUE(readStyle.styleB(Sid::concertPitch));
+    EXPECT_EQ(readStyle.styleS(Sid::staffDistance), Spatium(8.0));
+}
+
+TEST_F(Engraving_StyleTests, CreateScores)
+{
+    //! NOTE Scores and part scores created with a style share its values instead of copying them
+    constexpr int SCORES_COUNT = 10;
+
+    const MStyle& baseStyle = DefaultStyle::baseStyle();
+
+    for (int i = 0; i < SCORES_COUNT; ++i) {
+        MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle();
+        ASSERT_TRUE(score);
+        EXPECT_TRUE(score->style().sharesValuesWith(baseStyle));
+
+        Score* partScore = score->createScore();
+        EXPECT_TRUE(partScore->style().sharesValuesWith(baseStyle));
+        EXPECT_TRUE(partScore->style().sharesValuesWith(score->style()));
+
+        delete partScore;
+        delete score;
+    }
+}
+
+TEST_F(Engraving_StyleTests, PartScoreDetachesStyleOnChange)
+{
+    MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle();
+    ASSERT_TRUE(score);
+
+    Score* partScore = score->createScore();
+    ASSERT_TRUE(partScore->style().sharesValuesWith(score->style()));
+
+    //! NOTE Setting the value it already has keeps the style shared
+    partScore->style().set(Sid::concertPitch, partScore->style().styleB(Sid::concertPitch));
+    EXPECT_TRUE(partScore->style().sharesValuesWith(score->style()));
+
+    //! NOTE A change copies only the part score style, the master score style is not changed
+    const bool concertPitch = score->style().styleB(Sid::concertPitch);
+    partScore->style().set(Sid::concertPitch, !concertPitch);
+    EXPECT_FALSE(partScore->style().sharesValuesWith(score->style()));
+    EXPECT_TRUE(score->style().sharesValuesWith(DefaultStyle::baseStyle()));
+    EXPECT_EQ(score->style().styleB(Sid::concertPitch), concertPitch);
+    EXPECT_EQ(partScore->style().styleB(Sid::concertPitch), !concertPitch);
+
+    delete partScore;
+    delete score;
+}
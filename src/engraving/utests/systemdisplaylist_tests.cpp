@@ -0,0 +1,300 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "draw/bufferedpaintprovider.h"
+#include "draw/painter.h"
+
+#include "infrastructure/paint.h"
+#include "infrastructure/systemdisplaylist.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/page.h"
+#include "libmscore/system.h"
+
+#include "utils/scorerw.h"
+
+#include "mocks/engravingconfigurationmock.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::draw;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR(u"all_elements_data/");
+
+class Engraving_SystemDisplayListTests : public ::testing::Test
+{
+protected:
+    struct Counts {
+        size_t paths = 0;
+        size_t polygons = 0;
+        size_t texts = 0;
+        size_t pixmaps = 0;
+    };
+
+    static void expectSameCounts(const Counts& c1, const Counts& c2)
+    {
+        EXPECT_EQ(c1.paths, c2.paths);
+        EXPECT_EQ(c1.polygons, c2.polygons);
+        EXPECT_EQ(c1.texts, c2.texts);
+        EXPECT_EQ(c1.pixmaps, c2.pixmaps);
+    }
+
+    static Counts counts(const DrawData& data)
+    {
+        Counts c;
+        for (const DrawData::Object& obj : data.objects) {
+            for (const DrawData::Data& d : obj.datas) {
+                c.paths += d.paths.size();
+                c.polygons += d.polygons.size();
+                c.texts += d.texts.size() + d.rectTexts.size();
+                c.pixmaps += d.pixmaps.size() + d.tiledPixmap.size();
+            }
+        }
+        return c;
+    }
+
+    static DrawData paintDirectly(Page* page, double zoom = 1.0)
+    {
+        std::shared_ptr<BufferedPaintProvider> buf = std::make_shared<BufferedPaintProvider>();
+        Painter painter(buf, "direct");
+        painter.scale(zoom, zoom);
+        Paint::paintElements(painter, page->items(page->bbox()), true);
+        painter.endDraw();
+        return buf->drawData();
+    }
+
+    static DrawData paintFromDisplayLists(Page* page, double zoom = 1.0)
+    {
+        std::shared_ptr<BufferedPaintProvider> buf = std::make_shared<BufferedPaintProvider>();
+        Painter painter(buf, "displaylist");
+        painter.scale(zoom, zoom);
+        Paint::paintPage(painter, page, page->bbox(), true);
+        painter.endDraw();
+        return buf->drawData();
+    }
+};
+
+TEST_F(Engraving_SystemDisplayListTests, SameAsDirectPainting)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_FALSE(score->pages().empty());
+
+    Page* page = score->pages().front();
+    Counts direct = counts(paintDirectly(page));
+
+    //! NOTE The first paint records the items, the second one replays the records
+    for (int pass = 0; pass < 2; ++pass) {
+        expectSameCounts(counts(paintFromDisplayLists(page)), direct);
+    }
+
+    delete score;
+}
+
+TEST_F(Engraving_SystemDisplayListTests, ZoomedPainting)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_FALSE(score->pages().empty());
+
+    Page* page = score->pages().front();
+    System* system = page->systems().front();
+
+    //! NOTE Zoomed out, the text is painted directly (see SystemDisplayList::isPaintedDirectly)
+    expectSameCounts(counts(paintFromDisplayLists(page, 0.5)), counts(paintDirectly(page, 0.5)));
+    const size_t recordedZoomedOut = system->displayList()->recordedCount();
+    EXPECT_GT(recordedZoomedOut, 0u);
+
+    //! NOTE Zoomed in, the text is recorded too, the other records are reused
+    expectSameCounts(counts(paintFromDisplayLists(page, 2.0)), counts(paintDirectly(page, 2.0)));
+    const size_t recordedZoomedIn = system->displayList()->recordedCount();
+#ifndef Q_OS_MACOS
+    EXPECT_GT(recordedZoomedIn, recordedZoomedOut);
+#else
+    EXPECT_EQ(recordedZoomedIn, recordedZoomedOut);
+#endif
+
+    //! NOTE Zooming out again doesn't replay the text recorded zoomed in
+    expectSameCounts(counts(paintFromDisplayLists(page, 0.5)), counts(paintDirectly(page, 0.5)));
+    EXPECT_EQ(system->displayList()->recordedCount(), recordedZoomedIn);
+
+    delete score;
+}
+
+TEST_F(Engraving_SystemDisplayListTests, Invalidation)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_FALSE(score->systems().empty());
+
+    Page* page = score->pages().front();
+    System* system = page->systems().front();
+
+    paintFromDisplayLists(page);
+    size_t recorded = system->displayList()->recordedCount();
+    EXPECT_GT(recorded, 0u);
+
+    //! NOTE The refresh is collected and applied once before painting
+    ASSERT_GT(system->measures().size(), 1u);
+    score->addRefresh(system->firstMeasure()->canvasBoundingRect());
+    score->addRefresh(system->firstMeasure()->canvasBoundingRect());
+    EXPECT_EQ(system->displayList()->recordedCount(), recorded);
+
+    //! NOTE Only the items in the refreshed area are recorded again
+    score->applyDisplayListRefresh();
+    size_t afterRefresh = system->displayList()->recordedCount();
+    EXPECT_LT(afterRefresh, recorded);
+    EXPECT_GT(afterRefresh, 0u);
+
+    //! NOTE The systems out of the refreshed area keep their records
+    if (page->systems().size() > 1) {
+        System* lastSystem = page->systems().back();
+        size_t lastRecorded = lastSystem->displayList()->recordedCount();
+        score->addRefresh(system->firstMeasure()->canvasBoundingRect());
+        score->applyDisplayListRefresh();
+        EXPECT_EQ(lastSystem->displayList()->recordedCount(), lastRecorded);
+    }
+
+    //! NOTE Layout drops the whole list
+    score->doLayout();
+    system = score->pages().front()->systems().front();
+    EXPECT_EQ(system->displayList()->recordedCount(), 0u);
+
+    delete score;
+}
+
+TEST_F(Engraving_SystemDisplayListTests, PageZOrder)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    Page* page = score->pages().front();
+    ASSERT_GT(page->systems().size(), 1u);
+
+    std::vector<std::shared_ptr<SystemDisplayList> > lists;
+    for (const System* system : page->systems()) {
+        lists.push_back(system->displayList());
+    }
+
+    //! NOTE The filter is called in the paint order
+    std::vector<const EngravingItem*> painted;
+    auto filter = [&painted](const EngravingItem* item) {
+        painted.push_back(item);
+        return true;
+    };
+
+    std::shared_ptr<BufferedPaintProvider> buf = std::make_shared<BufferedPaintProvider>();
+    Painter painter(buf, "displaylist");
+    SystemDisplayList::paint(painter, lists, page->bbox(), filter);
+    painter.endDraw();
+
+    //! NOTE The items of all the systems are painted in the z order of the page, not system by system
+    EXPECT_FALSE(painted.empty());
+    EXPECT_TRUE(std::is_sorted(painted.begin(), painted.end(), elementLessThan));
+
+    delete score;
+}
+
+TEST_F(Engraving_SystemDisplayListTests, ColorsChangeKey)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    auto configuration = std::dynamic_pointer_cast<EngravingConfigurationMock>(EngravingItem::engravingConfiguration());
+    ASSERT_TRUE(configuration);
+
+    System* system = score->pages().front()->systems().front();
+    paintFromDisplayLists(score->pages().front());
+    std::shared_ptr<SystemDisplayList> list = system->displayList();
+
+    //! NOTE The records made before the inversion of the score colors are not replayed after it
+    ON_CALL(*configuration, scoreInversionEnabled()).WillByDefault(::testing::Return(true));
+    EXPECT_NE(system->displayList(), list);
+    EXPECT_EQ(system->displayList()->recordedCount(), 0u);
+
+    ON_CALL(*configuration, scoreInversionEnabled()).WillByDefault(::testing::Return(false));
+    EXPECT_EQ(system->displayList(), list);
+
+    //! NOTE Same for the selection colors
+    ON_CALL(*configuration, selectionColor(1, true)).WillByDefault(::testing::Return(Color::redColor));
+    EXPECT_NE(system->displayList(), list);
+
+    ON_CALL(*configuration, selectionColor(1, true)).WillByDefault(::testing::Return(Color()));
+    EXPECT_EQ(system->displayList(), list);
+
+    delete score;
+}
+
+TEST_F(Engraving_SystemDisplayListTests, Benchmark)
+{
+    constexpr int PAINT_COUNT = 20;
+
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    auto paintAll = [score](DrawData (*paint)(Page*)) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < PAINT_COUNT; ++i) {
+            for (Page* page : score->pages()) {
+                paint(page);
+            }
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    const int64_t directUs = paintAll([](Page* page) { return paintDirectly(page); });
+
+    auto start = std::chrono::steady_clock::now();
+    for (Page* page : score->pages()) {
+        paintFromDisplayLists(page);
+    }
+    const int64_t recordUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<std::shared_ptr<SystemDisplayList> > lists;
+    std::vector<size_t> recordedCounts;
+    for (const System* system : score->systems()) {
+        lists.push_back(system->displayList());
+        recordedCounts.push_back(lists.back()->recordedCount());
+    }
+
+    const int64_t replayUs = paintAll([](Page* page) { return paintFromDisplayLists(page); });
+
+    //! NOTE The replays reuse the lists recorded by the first paint and record nothing new
+    for (size_t i = 0; i < score->systems().size(); ++i) {
+        EXPECT_EQ(score->systems().at(i)->displayList(), lists.at(i));
+        EXPECT_EQ(lists.at(i)->recordedCount(), recordedCounts.at(i));
+    }
+
+    LOGI() << "pages: " << score->npages() << ", paints: " << PAINT_COUNT
+           << ", direct: " << directUs << " us"
+           << ", record: " << recordUs << " us"
+           << ", replay: " << replayUs << " us";
+
+    delete score;
+}
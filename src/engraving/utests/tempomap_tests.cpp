@@ -22,6 +22,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+
 #include "utils/scorerw.h"
 #include "realfn.h"
 #include "types/constants.h"
@@ -213,3 +215,49 @@ TEST_F(Engraving_TempoMapTests, GRADUAL_TEMPO_CHANGE_RALLENTANDO)
         EXPECT_TRUE(RealIsEqual(RealRound(tempoMap->at(pair.first).tempo.val, 2), RealRound(pair.second.val, 2)));
     }
 }
+
+/**
+ * @brief TempoMapTests_TICK_TIME_CONVERSIONS
+ * @details In this case we're building a tempomap with several tempo changes and a pause
+ *          Conversions in both directions, single and batched, should agree with each other
+ */
+TEST_F(Engraving_TempoMapTests, TICK_TIME_CONVERSIONS)
+{
+    // [GIVEN] Tempomap with 120 BPM, then 60 BPM with a pause, then 180 BPM
+    TempoMap tempoMap;
+    tempoMap.setTempo(0, BeatsPerSecond::fromBPM(BeatsPerMinute(120.0)));
+    tempoMap.setTempo(4 * Constants::division, BeatsPerSecond::fromBPM(BeatsPerMinute(60.0)));
+    tempoMap.setPause(8 * Constants::division, 1.5);
+    tempoMap.setTempo(12 * Constants::division, BeatsPerSecond::fromBPM(BeatsPerMinute(180.0)));
+
+    // [THEN] Tempo events are placed at the expected times
+    EXPECT_TRUE(RealIsEqual(tempoMap.tick2time(4 * Constants::division), 2.0));
+    EXPECT_TRUE(RealIsEqual(tempoMap.tick2time(8 * Constants::division), 7.5));
+    EXPECT_TRUE(RealIsEqual(tempoMap.tick2time(12 * Constants::division), 11.5));
+
+    // [GIVEN] Ticks in mixed order, including ticks between and after tempo events
+    std::vector<int> ticks;
+    for (int tick = 0; tick < 16 * Constants::division; tick += Constants::division / 4) {
+        ticks.push_back(tick);
+    }
+    ticks.push_back(2 * Constants::division);
+    ticks.push_back(13 * Constants::division);
+
+    // [WHEN] We convert them in one batch
+    std::vector<double> times = tempoMap.ticks2times(ticks);
+    std::vector<int64_t> msecs = tempoMap.ticks2msecs(ticks);
+
+    ASSERT_EQ(times.size(), ticks.size());
+    ASSERT_EQ(msecs.size(), ticks.size());
+
+    // [THEN] Batched conversion matches single conversion, and time2tick is its inverse outside of the pause
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        EXPECT_TRUE(RealIsEqual(times.at(i), tempoMap.tick2time(ticks.at(i))));
+        EXPECT_EQ(msecs.at(i), static_cast<int64_t>(std::llround(times.at(i) * 1000.0)));
+        EXPECT_EQ(tempoMap.time2tick(times.at(i)), ticks.at(i));
+    }
+
+    // [THEN] Any time inside of the pause resolves to the tick of the pause
+    EXPECT_EQ(tempoMap.time2tick(6.5), 8 * Constants::division);
+    EXPECT_EQ(tempoMap.time2tick(7.0), 8 * Constants::division);
+}
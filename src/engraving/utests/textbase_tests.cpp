@@ -31,6 +31,9 @@
 #include "libmscore/segment.h"
 #include "libmscore/stafftext.h"
 #include "libmscore/textedit.h"
+#include "libmscore/textlayoutcache.h"
+
+#include "draw/fontmetrics.h"
 
 #include "utils/scorerw.h"
 #include "utils/scorecomp.h"
@@ -192,3 +195,71 @@ TEST_F(Engraving_TextBaseTests, musicalSymbolsNotItalic)
     EXPECT_TRUE(fragmentList.front().font(dynamic).italic());
     EXPECT_TRUE(!std::next(fragmentList.begin())->font(dynamic).italic());
 }
+
+TEST_F(Engraving_TextBaseTests, layoutCache)
+{
+    MasterScore* score = ScoreRW::readScore(u"test.mscx");
+    StaffText* staffText1 = addStaffText(score);
+    staffText1->setXmlText(u"cresc.");
+    StaffText* staffText2 = addStaffText(score);
+    staffText2->setXmlText(u"cresc.");
+
+    TextLayoutCache* cache = TextLayoutCache::instance();
+    cache->clear();
+
+    staffText1->layout();
+    TextLayoutCache::Stats firstStats = cache->stats();
+    EXPECT_GT(firstStats.misses, 0u);
+
+    // the same text with the same format is measured only once
+    staffText2->layout();
+    TextLayoutCache::Stats secondStats = cache->stats();
+    EXPECT_EQ(secondStats.misses, firstStats.misses);
+    EXPECT_GT(secondStats.hits, firstStats.hits);
+    EXPECT_EQ(staffText2->bbox(), staffText1->bbox());
+
+    mu::draw::Font font = staffText1->fragmentList().front().font(staffText1);
+    TextLayoutCache::Metrics metrics = cache->metrics(font, u"cresc.");
+    mu::draw::FontMetrics fm(font);
+    EXPECT_DOUBLE_EQ(metrics.width, fm.width(u"cresc."));
+    EXPECT_EQ(metrics.tightBoundingRect, fm.tightBoundingRect(u"cresc."));
+}
+
+TEST_F(Engraving_TextBaseTests, layoutCacheFontSize)
+{
+    TextLayoutCache* cache = TextLayoutCache::instance();
+    cache->clear();
+
+    mu::draw::Font font(u"Edwin");
+    font.setPointSizeF(10.0);
+    TextLayoutCache::Metrics small = cache->metrics(font, u"cresc.");
+
+    // a bigger font is measured again and not taken from the smaller one
+    font.setPointSizeF(20.0);
+    TextLayoutCache::Metrics big = cache->metrics(font, u"cresc.");
+    EXPECT_EQ(cache->stats().misses, 2u);
+    EXPECT_EQ(cache->stats().size, 2u);
+    EXPECT_GT(big.width, small.width);
+
+    mu::draw::Font pixelFont = font;
+    pixelFont.setPixelSize(12);
+    EXPECT_NE(pixelFont, font);
+    cache->metrics(pixelFont, u"cresc.");
+    EXPECT_EQ(cache->stats().misses, 3u);
+}
+
+TEST_F(Engraving_TextBaseTests, layoutCacheStyleChanged)
+{
+    MasterScore* score = ScoreRW::readScore(u"test.mscx");
+    StaffText* staffText = addStaffText(score);
+    staffText->setXmlText(u"cresc.");
+    staffText->layout();
+
+    TextLayoutCache* cache = TextLayoutCache::instance();
+    EXPECT_GT(cache->stats().size, 0u);
+
+    // the fonts may change with the style, so the cache is dropped
+    score->style().set(Sid::staffTextFontFace, String(u"FreeSerif"));
+    score->styleChanged();
+    EXPECT_EQ(cache->stats().size, 0u);
+}
@@ -0,0 +1,126 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "libmscore/chord.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/note.h"
+#include "libmscore/segment.h"
+#include "libmscore/undo.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu::engraving;
+
+class Engraving_UndoTests : public ::testing::Test
+{
+};
+
+static Note* firstNote(MasterScore* score)
+{
+    Segment* s = score->firstMeasure()->first(SegmentType::ChordRest);
+    while (s && !(s->element(0) && s->element(0)->isChord())) {
+        s = s->next1(SegmentType::ChordRest);
+    }
+    return s ? toChord(s->element(0))->upNote() : nullptr;
+}
+
+//---------------------------------------------------------
+///   mergeChangeProperty
+///   consecutive changes of one property of one element
+///   are kept as a single command and still undo to the
+///   original value
+//---------------------------------------------------------
+
+TEST_F(Engraving_UndoTests, mergeChangeProperty)
+{
+    MasterScore* score = ScoreRW::readScore(u"test.mscx");
+    ASSERT_TRUE(score);
+
+    Note* note = firstNote(score);
+    ASSERT_TRUE(note);
+
+    const int originalVelocity = note->veloOffset();
+
+    score->startCmd();
+    for (int velocity = 10; velocity <= 50; velocity += 10) {
+        note->undoChangeProperty(Pid::VELO_OFFSET, velocity);
+    }
+    const UndoMacro* macro = score->undoStack()->current();
+    ASSERT_TRUE(macro);
+    EXPECT_EQ(macro->childCount(), 1u);
+    score->endCmd();
+
+    EXPECT_EQ(note->veloOffset(), 50);
+
+    score->undoRedo(true, nullptr);
+    EXPECT_EQ(note->veloOffset(), originalVelocity);
+
+    score->undoRedo(false, nullptr);
+    EXPECT_EQ(note->veloOffset(), 50);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   memoryLimit
+///   the oldest undo steps are dropped once the history
+///   exceeds its memory budget, the latest one is kept
+//---------------------------------------------------------
+
+TEST_F(Engraving_UndoTests, memoryLimit)
+{
+    MasterScore* score = ScoreRW::readScore(u"test.mscx");
+    ASSERT_TRUE(score);
+
+    Note* note = firstNote(score);
+    ASSERT_TRUE(note);
+
+    UndoStack* undoStack = score->undoStack();
+
+    for (int velocity = 10; velocity <= 100; velocity += 10) {
+        score->startCmd();
+        note->undoChangeProperty(Pid::VELO_OFFSET, velocity);
+        score->endCmd();
+    }
+
+    const size_t stepCount = undoStack->macroCount();
+    ASSERT_GE(stepCount, 10u);
+    EXPECT_GT(undoStack->memoryUsage(), 0u);
+
+    // [WHEN] The budget only fits a single step
+    undoStack->setMemoryLimit(1);
+
+    // [THEN] Only the latest step remains, the undo index keeps counting evicted steps
+    EXPECT_EQ(undoStack->macroCount(), 1u);
+    EXPECT_EQ(undoStack->evictedMacroCount(), stepCount - 1);
+    EXPECT_EQ(undoStack->getCurIdx(), stepCount);
+    EXPECT_TRUE(undoStack->canUndo());
+
+    score->undoRedo(true, nullptr);
+    EXPECT_EQ(note->veloOffset(), 90);
+    EXPECT_FALSE(undoStack->canUndo());
+
+    delete score;
+}
@@ -198,7 +198,8 @@ void AudioModule::onInit(const framework::IApplication::RunMode& mode)
     }
 
     // Setup worker
-    auto workerSetup = [activeSpec]() {
+    bool useSharedFluidEngines = s_audioConfiguration->sharedFluidEnginesEnabled();
+    auto workerSetup = [activeSpec, useSharedFluidEngines]() {
         AudioSanitizer::setupWorkerThread();
         ONLY_AUDIO_WORKER_THREAD;
 
@@ -208,7 +209,7 @@ void AudioModule::onInit(const framework::IApplication::RunMode& mode)
         AudioEngine::instance()->setSampleRate(activeSpec.sampleRate);
         AudioEngine::instance()->setReadBufferSize(activeSpec.samples);
 
-        auto fluidResolver = std::make_shared<FluidResolver>();
+        auto fluidResolver = std::make_shared<FluidResolver>(useSharedFluidEngines);
         s_synthResolver->registerResolver(AudioSourceType::Fluid, fluidResolver);
         s_synthResolver->init(s_audioConfiguration->defaultAudioInputParams());
 
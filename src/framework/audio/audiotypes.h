@@ -25,8 +25,10 @@
 
 #include <variant>
 #include <memory>
+#include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "realfn.h"
 #include "midi/miditypes.h"
@@ -302,6 +304,16 @@ struct SoundTrackFormat {
     }
 };
 
+struct SoundTrackDestination {
+    io::path_t path;
+    SoundTrackFormat format;
+};
+
+using SoundTrackDestinationList = std::vector<SoundTrackDestination>;
+
+//! NOTE The destinations of the output of single tracks (stems)
+using SoundTrackStemDestinations = std::map<TrackId, SoundTrackDestinationList>;
+
 using AudioDeviceID = std::string;
 struct AudioDevice {
     AudioDeviceID id;
@@ -64,6 +64,9 @@ public:
     virtual void setUserSoundFontDirectories(const io::paths_t& paths) = 0;
     virtual async::Channel<io::paths_t> soundFontDirectoriesChanged() const = 0;
 
+    virtual bool sharedFluidEnginesEnabled() const = 0;
+    virtual void setSharedFluidEnginesEnabled(bool enabled) = 0;
+
     virtual const synth::SynthesizerState& synthesizerState() const = 0;
     virtual Ret saveSynthesizerState(const synth::SynthesizerState& state) = 0;
     virtual async::Notification synthesizerStateChanged() const = 0;
@@ -51,6 +51,13 @@ public:
 
     virtual async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                                 const SoundTrackFormat& format) = 0;
+
+    //! NOTE Renders the sequence once and encodes it into all the destinations
+    virtual async::Promise<bool> saveSoundTracks(const TrackSequenceId sequenceId, const SoundTrackDestinationList& destinations) = 0;
+
+    //! NOTE Also writes every track of the sequence into its own files (stems) in the same pass,
+    //!      named after the destinations with the track name appended
+    virtual async::Promise<bool> saveSoundTrackStems(const TrackSequenceId sequenceId, const SoundTrackDestinationList& destinations) = 0;
 };
 
 using IAudioOutputPtr = std::shared_ptr<IAudioOutput>;
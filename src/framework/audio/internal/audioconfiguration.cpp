@@ -45,6 +45,7 @@ static const Settings::Key AUDIO_BUFFER_SIZE_KEY("audio", "io/bufferSize");
 static const Settings::Key AUDIO_SAMPLE_RATE_KEY("audio", "io/sampleRate");
 
 static const Settings::Key USER_SOUNDFONTS_PATHS("midi", "application/paths/mySoundfonts");
+static const Settings::Key SHARED_FLUID_ENGINES_KEY("audio", "synth/fluid/sharedEngines");
 
 static const AudioResourceId DEFAULT_SOUND_FONT_NAME = "MS Basic";     // "GeneralUser GS v1.471.sf2"; // "MS Basic.sf3";
 static const AudioResourceMeta DEFAULT_AUDIO_RESOURCE_META
@@ -79,6 +80,9 @@ void AudioConfiguration::init()
         m_soundFontDirsChanged.send(soundFontDirectories());
     });
 
+    settings()->setDefaultValue(SHARED_FLUID_ENGINES_KEY, Val(false));
+    settings()->setCanBeManuallyEdited(SHARED_FLUID_ENGINES_KEY, true);
+
     for (const auto& path : userSoundFontDirectories()) {
         fileSystem()->makePath(path);
     }
@@ -188,6 +192,16 @@ AudioInputParams AudioConfiguration::defaultAudioInputParams() const
     return result;
 }
 
+bool AudioConfiguration::sharedFluidEnginesEnabled() const
+{
+    return settings()->value(SHARED_FLUID_ENGINES_KEY).toBool();
+}
+
+void AudioConfiguration::setSharedFluidEnginesEnabled(bool enabled)
+{
+    settings()->setSharedValue(SHARED_FLUID_ENGINES_KEY, Val(enabled));
+}
+
 const SynthesizerState& AudioConfiguration::defaultSynthesizerState() const
 {
     static SynthesizerState state;
@@ -63,6 +63,9 @@ public:
 
     AudioInputParams defaultAudioInputParams() const override;
 
+    bool sharedFluidEnginesEnabled() const override;
+    void setSharedFluidEnginesEnabled(bool enabled) override;
+
     const synth::SynthesizerState& defaultSynthesizerState() const;
     const synth::SynthesizerState& synthesizerState() const override;
     Ret saveSynthesizerState(const synth::SynthesizerState& state) override;
@@ -49,6 +49,11 @@ struct FlacHandler : public FLAC::Encoder::File
     }
 };
 
+FlacEncoder::~FlacEncoder()
+{
+    closeDestination();
+}
+
 bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
 {
     if (!format.isValid()) {
@@ -95,30 +100,21 @@ size_t FlacEncoder::encode(samples_t samplesPerChannel, const float* input)
         return 0;
     }
 
-    size_t result = 0;
-    size_t totalSamplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
-    uint32_t frameSize = 1024;
-    size_t stepSize = frameSize * m_format.audioChannelsNumber;
-
-    std::vector<FLAC__int32> buff(samplesPerChannel * sizeof(float));
+    size_t samplesCount = samplesPerChannel * m_format.audioChannelsNumber;
 
-    for (size_t i = 0; i < buff.size(); ++i) {
-        buff[i] = static_cast<FLAC__int32>(dsp::convertFloatSamples<FLAC__int16>(input[i]));
+    if (m_intermBuffer.size() < samplesCount) {
+        m_intermBuffer.resize(samplesCount);
     }
 
-    std::vector<FLAC__int32> intermBuff(stepSize);
-
-    for (size_t i = 0; i < totalSamplesNumber; i += stepSize) {
-        std::copy(buff.data() + i, buff.data() + i + stepSize, intermBuff.data());
+    for (size_t i = 0; i < samplesCount; ++i) {
+        m_intermBuffer[i] = static_cast<FLAC__int32>(dsp::convertFloatSamples<FLAC__int16>(input[i]));
+    }
 
-        if (m_flac->process_interleaved(intermBuff.data(), frameSize)) {
-            result += stepSize;
-        } else {
-            break;
-        }
+    if (!m_flac->process_interleaved(m_intermBuffer.data(), samplesPerChannel)) {
+        return 0;
     }
 
-    return result;
+    return samplesCount;
 }
 
 size_t FlacEncoder::flush()
@@ -148,4 +144,5 @@ bool FlacEncoder::openDestination(const io::path_t& path)
 void FlacEncoder::closeDestination()
 {
     delete m_flac;
+    m_flac = nullptr;
 }
@@ -31,6 +31,8 @@ namespace mu::audio::encode {
 class FlacEncoder : public AbstractAudioEncoder
 {
 public:
+    ~FlacEncoder() override;
+
     bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber) override;
 
     size_t encode(samples_t samplesPerChannel, const float* input) override;
@@ -43,6 +45,7 @@ protected:
 
 private:
     FlacHandler* m_flac = nullptr;
+    std::vector<int32_t> m_intermBuffer;
 };
 }
 
@@ -30,10 +30,24 @@ using namespace mu::audio::encode;
 
 struct LameHandler
 {
-    static LameHandler* instance()
+    LameHandler()
+    {
+        flags = lame_init();
+
+        lame_set_errorf(flags, [](const char* msg, va_list /*ap*/) {
+            LOGE() << msg;
+        });
+        lame_set_debugf(flags, [](const char* msg, va_list /*ap*/) {
+            LOGD() << msg;
+        });
+        lame_set_msgf(flags, [](const char* msg, va_list /*ap*/) {
+            LOGI() << msg;
+        });
+    }
+
+    ~LameHandler()
     {
-        static LameHandler handler;
-        return &handler;
+        lame_close(flags);
     }
 
     bool updateSpec(const SoundTrackFormat& format)
@@ -68,50 +82,52 @@ struct LameHandler
     lame_global_flags* flags = nullptr;
 
 private:
-    LameHandler()
-    {
-        flags = lame_init();
-
-        lame_set_errorf(flags, [](const char* msg, va_list /*ap*/) {
-            LOGE() << msg;
-        });
-        lame_set_debugf(flags, [](const char* msg, va_list /*ap*/) {
-            LOGD() << msg;
-        });
-        lame_set_msgf(flags, [](const char* msg, va_list /*ap*/) {
-            LOGI() << msg;
-        });
-    }
-
-    ~LameHandler()
-    {
-        lame_close(flags);
-    }
-
     SoundTrackFormat m_format;
 };
 
-size_t Mp3Encoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+//! NOTE See thirdparty/lame/API, the worst case size of the encoded data
+static size_t mp3BufferSize(samples_t samplesPerChannel)
+{
+    return samplesPerChannel * 5 / 4 + 7200;
+}
+
+Mp3Encoder::Mp3Encoder()
+    : m_lame(std::make_unique<LameHandler>())
 {
-    //!Note See thirdparty/lame/API
+}
+
+Mp3Encoder::~Mp3Encoder() = default;
 
-    return totalSamplesNumber;
+size_t Mp3Encoder::requiredOutputBufferSize(samples_t /*totalSamplesNumber*/) const
+{
+    //! NOTE The buffer grows with the blocks passed to encode()
+    return mp3BufferSize(0);
 }
 
 size_t Mp3Encoder::encode(samples_t samplesPerChannel, const float* input)
 {
-    LameHandler::instance()->updateSpec(m_format);
+    m_lame->updateSpec(m_format);
+
+    if (m_outputBuffer.size() < mp3BufferSize(samplesPerChannel)) {
+        m_outputBuffer.resize(mp3BufferSize(samplesPerChannel));
+    }
 
-    int encodedBytes = lame_encode_buffer_interleaved_ieee_float(LameHandler::instance()->flags, input, samplesPerChannel,
+    int encodedBytes = lame_encode_buffer_interleaved_ieee_float(m_lame->flags, input, samplesPerChannel,
                                                                  m_outputBuffer.data(),
                                                                  static_cast<int>(m_outputBuffer.size()));
+    if (encodedBytes < 0) {
+        return 0;
+    }
 
-    return std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream);
+    //! NOTE lame may keep the samples until it has a whole frame, so no output is not an error
+    std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream);
+
+    return samplesPerChannel * m_format.audioChannelsNumber;
 }
 
 size_t Mp3Encoder::flush()
 {
-    int encodedBytes = lame_encode_flush(LameHandler::instance()->flags,
+    int encodedBytes = lame_encode_flush(m_lame->flags,
                                          m_outputBuffer.data(),
                                          static_cast<int>(m_outputBuffer.size()));
 
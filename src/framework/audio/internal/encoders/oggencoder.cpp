@@ -29,14 +29,32 @@
 using namespace mu::audio;
 using namespace mu::audio::encode;
 
+OggEncoder::~OggEncoder()
+{
+    closeDestination();
+}
+
 size_t OggEncoder::encode(samples_t samplesPerChannel, const float* input)
 {
-    return ope_encoder_write_float(m_opusEncoder, input, samplesPerChannel + m_format.sampleRate * 2);
+    if (!m_opusEncoder) {
+        return 0;
+    }
+
+    if (ope_encoder_write_float(m_opusEncoder, input, samplesPerChannel) != OPE_OK) {
+        return 0;
+    }
+
+    return samplesPerChannel * m_format.audioChannelsNumber;
 }
 
 size_t OggEncoder::flush()
 {
-    return ope_encoder_flush_header(m_opusEncoder);
+    if (!m_opusEncoder) {
+        return 0;
+    }
+
+    //! NOTE Encodes the samples kept by the encoder and finishes the stream
+    return ope_encoder_drain(m_opusEncoder) == OPE_OK ? 1 : 0;
 }
 
 size_t OggEncoder::requiredOutputBufferSize(samples_t /*totalSamplesNumber*/) const
@@ -52,8 +70,8 @@ bool OggEncoder::openDestination(const io::path_t& path)
     m_opusEncoder = ope_encoder_create_file(path.c_str(), comments, m_format.sampleRate,
                                             m_format.audioChannelsNumber, 0, &error);
 
-    if (error != OPE_OK && m_opusEncoder) {
-        ope_encoder_destroy(m_opusEncoder);
+    if (error != OPE_OK) {
+        closeDestination();
         return false;
     }
 
@@ -64,5 +82,8 @@ bool OggEncoder::openDestination(const io::path_t& path)
 
 void OggEncoder::closeDestination()
 {
-    ope_encoder_destroy(m_opusEncoder);
+    if (m_opusEncoder) {
+        ope_encoder_destroy(m_opusEncoder);
+        m_opusEncoder = nullptr;
+    }
 }
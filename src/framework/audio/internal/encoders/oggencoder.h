@@ -31,6 +31,8 @@ namespace mu::audio::encode {
 class OggEncoder : public AbstractAudioEncoder
 {
 public:
+    ~OggEncoder() override;
+
     size_t encode(samples_t samplesPerChannel, const float* input) override;
     size_t flush() override;
 
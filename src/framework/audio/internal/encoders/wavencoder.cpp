@@ -87,31 +87,39 @@ size_t WavEncoder::encode(samples_t samplesPerChannel, const float* input)
         return 0;
     }
 
-    WavHeader header;
-    header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
-    header.bitsPerSample = 32;
-    header.code = 3; // IEEE_FLOAT = 3, PCM = 1
-    header.audioChannelsNumber = m_format.audioChannelsNumber;
-    header.sampleRate = m_format.sampleRate;
-    header.samplesPerChannel = samplesPerChannel;
+    const size_t samplesCount = samplesPerChannel * m_format.audioChannelsNumber;
+    m_fileStream.write(reinterpret_cast<const char*>(input), samplesCount * sizeof(float));
+    m_samplesPerChannel += samplesPerChannel;
 
-    header.write(m_fileStream);
+    return samplesCount;
+}
 
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel; ++sampleIdx) {
-        for (audioch_t audioChNum = 0; audioChNum < m_format.audioChannelsNumber; ++audioChNum) {
-            int idx = sampleIdx * m_format.audioChannelsNumber + audioChNum;
-            m_fileStream.write(reinterpret_cast<const char*>(input + idx), 4);
-        }
+size_t WavEncoder::flush()
+{
+    if (!m_fileStream.is_open()) {
+        return 0;
     }
 
-    return samplesPerChannel * m_format.audioChannelsNumber;
+    //! NOTE The length of the data is known only now
+    m_fileStream.seekp(0);
+    writeHeader();
+    m_fileStream.seekp(0, std::ios_base::end);
+    m_fileStream.flush();
+
+    return m_samplesPerChannel * m_format.audioChannelsNumber;
 }
 
-size_t WavEncoder::flush()
+void WavEncoder::writeHeader()
 {
-    NOT_SUPPORTED;
+    WavHeader header;
+    header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
+    header.bitsPerSample = 32;
+    header.code = 3; // IEEE_FLOAT = 3, PCM = 1
+    header.audioChannelsNumber = m_format.audioChannelsNumber;
+    header.sampleRate = m_format.sampleRate;
+    header.samplesPerChannel = m_samplesPerChannel;
 
-    return 0;
+    header.write(m_fileStream);
 }
 
 size_t WavEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
@@ -122,8 +130,14 @@ size_t WavEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
 bool WavEncoder::openDestination(const io::path_t& path)
 {
     m_fileStream.open(path.toStdString(), std::ios_base::binary);
+    if (!m_fileStream.is_open()) {
+        return false;
+    }
+
+    //! NOTE Written again with the length of the data by flush()
+    writeHeader();
 
-    return m_fileStream.is_open();
+    return true;
 }
 
 void WavEncoder::closeDestination()
@@ -22,6 +22,12 @@
 
 #include "soundtrackwriter.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "internal/worker/audioengine.h"
 #include "internal/encoders/mp3encoder.h"
 #include "internal/encoders/oggencoder.h"
@@ -36,56 +42,167 @@ static constexpr audioch_t SUPPORTED_AUDIO_CHANNELS_COUNT = 2;
 static constexpr samples_t SAMPLES_PER_CHANNEL = 1024;
 static constexpr size_t INTERNAL_BUFFER_SIZE = SUPPORTED_AUDIO_CHANNELS_COUNT * SAMPLES_PER_CHANNEL;
 
-SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration,
-                                   IAudioSourcePtr source)
-    : m_source(std::move(source))
+//! NOTE The rendering waits for the encoders when so many blocks are pending for one thread
+static constexpr size_t MAX_PENDING_BLOCKS = 64;
+
+using Block = std::vector<float>;
+using BlockPtr = std::shared_ptr<const Block>;
+
+namespace {
+//! NOTE Encodes the blocks of its encoders in the order they are pushed
+class EncoderThread
 {
-    if (!m_source) {
-        return;
+public:
+    struct Job {
+        encode::AbstractAudioEncoder* encoder = nullptr;
+        BlockPtr block;
+        samples_t samplesPerChannel = 0;
+    };
+
+    void addEncoder(encode::AbstractAudioEncoder* encoder)
+    {
+        m_encoders.push_back(encoder);
     }
 
-    samples_t totalSamplesNumber = (totalDuration / 1000000.f) * sizeof(float) * format.sampleRate;
-    m_inputBuffer.resize(totalSamplesNumber);
-    m_intermBuffer.resize(INTERNAL_BUFFER_SIZE);
+    void start()
+    {
+        m_thread = std::thread([this]() { run(); });
+    }
 
-    m_encoderPtr = createEncoder(format.type);
+    void push(Job job)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_spaceAvailable.wait(lock, [this]() { return m_jobs.size() < MAX_PENDING_BLOCKS; });
+        m_jobs.push_back(std::move(job));
+        m_jobAvailable.notify_one();
+    }
 
-    if (!m_encoderPtr) {
-        return;
+    bool finish()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_finished = true;
+        }
+
+        m_jobAvailable.notify_one();
+        m_thread.join();
+
+        return m_ok;
+    }
+
+private:
+    void run()
+    {
+        for (;;) {
+            Job job;
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_jobAvailable.wait(lock, [this]() { return !m_jobs.empty() || m_finished; });
+                if (m_jobs.empty()) {
+                    break;
+                }
+
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+
+            m_spaceAvailable.notify_one();
+
+            if (job.encoder->encode(job.samplesPerChannel, job.block->data()) == 0) {
+                m_ok = false;
+            }
+        }
+
+        for (encode::AbstractAudioEncoder* encoder : m_encoders) {
+            encoder->flush();
+        }
     }
 
-    m_encoderPtr->init(destination, format, totalSamplesNumber);
+    std::vector<encode::AbstractAudioEncoder*> m_encoders;
+
+    std::deque<Job> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_jobAvailable;
+    std::condition_variable m_spaceAvailable;
+    bool m_finished = false;
+    std::atomic<bool> m_ok = true;
+
+    std::thread m_thread;
+};
 }
 
-bool SoundTrackWriter::write()
+SoundTrackWriter::SoundTrackWriter(const SoundTrackDestinationList& destinations, const SoundTrackStemDestinations& stemDestinations,
+                                   const msecs_t totalDuration, MixerPtr mixer)
+    : m_mixer(std::move(mixer))
 {
-    TRACEFUNC;
+    if (!m_mixer || destinations.empty()) {
+        return;
+    }
 
-    if (!m_source || !m_encoderPtr) {
-        return false;
+    const SoundTrackFormat& firstFormat = destinations.front().format;
+    m_sampleRate = firstFormat.sampleRate;
+    m_totalSamplesPerChannel = (totalDuration / 1000000.f) * m_sampleRate;
+
+    //! NOTE The mixer is rendered once, so all the formats have to agree on the sample stream
+    auto addEncoder = [this, &firstFormat](const SoundTrackDestination& destination) -> encode::AbstractAudioEncoder* {
+        if (destination.format.sampleRate != m_sampleRate
+            || destination.format.audioChannelsNumber != firstFormat.audioChannelsNumber) {
+            LOGE() << "incompatible format, skipped: " << destination.path;
+            return nullptr;
+        }
+
+        encode::AbstractAudioEncoderPtr encoder = createEncoder(destination.format.type);
+        if (!encoder || !encoder->init(destination.path, destination.format, m_totalSamplesPerChannel)) {
+            LOGE() << "failed init encoder: " << destination.path;
+            return nullptr;
+        }
+
+        m_encoders.push_back(std::move(encoder));
+        return m_encoders.back().get();
+    };
+
+    for (const SoundTrackDestination& destination : destinations) {
+        if (encode::AbstractAudioEncoder* encoder = addEncoder(destination)) {
+            m_masterEncoders.push_back(encoder);
+        }
     }
 
-    AudioEngine::instance()->setMode(AudioEngine::Mode::OfflineMode);
+    for (const auto& pair : stemDestinations) {
+        for (const SoundTrackDestination& destination : pair.second) {
+            if (encode::AbstractAudioEncoder* encoder = addEncoder(destination)) {
+                m_stemEncoders[pair.first].push_back(encoder);
+            }
+        }
+    }
+}
 
-    m_source->setSampleRate(m_encoderPtr->format().sampleRate);
-    m_source->setIsActive(true);
+bool SoundTrackWriter::write()
+{
+    TRACEFUNC;
 
-    if (!prepareInputBuffer()) {
+    if (!m_mixer || m_encoders.empty()) {
         return false;
     }
 
-    if (m_encoderPtr->encode(m_inputBuffer.size() / sizeof(float), m_inputBuffer.data()) == 0) {
+    if (m_totalSamplesPerChannel == 0) {
+        LOGI() << "No audio to export";
         return false;
     }
 
-    m_encoderPtr->flush();
+    AudioEngine::instance()->setMode(AudioEngine::Mode::OfflineMode);
+
+    m_mixer->setSampleRate(m_sampleRate);
+    m_mixer->setIsActive(true);
+
+    bool ok = render();
 
-    m_source->setSampleRate(AudioEngine::instance()->sampleRate());
-    m_source->setIsActive(false);
+    m_mixer->setSampleRate(AudioEngine::instance()->sampleRate());
+    m_mixer->setIsActive(false);
 
     AudioEngine::instance()->setMode(AudioEngine::Mode::RealTimeMode);
 
-    return true;
+    return ok;
 }
 
 encode::AbstractAudioEncoderPtr SoundTrackWriter::createEncoder(const SoundTrackType& type) const
@@ -99,27 +216,64 @@ encode::AbstractAudioEncoderPtr SoundTrackWriter::createEncoder(const SoundTrack
     }
 }
 
-bool SoundTrackWriter::prepareInputBuffer()
+bool SoundTrackWriter::render()
 {
-    size_t inputBufferOffset = 0;
-    size_t inputBufferMaxOffset = m_inputBuffer.size();
+    TRACEFUNC;
 
-    while (inputBufferOffset < inputBufferMaxOffset) {
-        m_source->process(m_intermBuffer.data(), SAMPLES_PER_CHANNEL);
+    size_t threadsCount = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<EncoderThread> threads(std::min(threadsCount, m_encoders.size()));
 
-        size_t samplesToCopy = std::min(INTERNAL_BUFFER_SIZE, inputBufferMaxOffset - inputBufferOffset);
+    std::map<const encode::AbstractAudioEncoder*, EncoderThread*> threadByEncoder;
+    for (size_t i = 0; i < m_encoders.size(); ++i) {
+        EncoderThread& thread = threads.at(i % threads.size());
+        thread.addEncoder(m_encoders.at(i).get());
+        threadByEncoder[m_encoders.at(i).get()] = &thread;
+    }
 
-        std::copy(m_intermBuffer.begin(),
-                  m_intermBuffer.begin() + samplesToCopy,
-                  m_inputBuffer.begin() + inputBufferOffset);
+    for (EncoderThread& thread : threads) {
+        thread.start();
+    }
 
-        inputBufferOffset += samplesToCopy;
+    std::map<TrackId, BlockPtr> stemBlocks;
+    if (!m_stemEncoders.empty()) {
+        m_mixer->setChannelOutputTap([this, &stemBlocks](const TrackId trackId, const float* buffer, samples_t samplesPerChannel) {
+            if (m_stemEncoders.find(trackId) != m_stemEncoders.end()) {
+                stemBlocks[trackId] = std::make_shared<Block>(buffer, buffer + samplesPerChannel * SUPPORTED_AUDIO_CHANNELS_COUNT);
+            }
+        });
     }
 
-    if (inputBufferOffset == 0) {
-        LOGI() << "No audio to export";
-        return false;
+    const BlockPtr silence = std::make_shared<Block>(INTERNAL_BUFFER_SIZE, 0.f);
+
+    auto pushBlock = [&threadByEncoder](const std::vector<encode::AbstractAudioEncoder*>& encoders, const BlockPtr& block,
+                                        samples_t samplesPerChannel) {
+        for (encode::AbstractAudioEncoder* encoder : encoders) {
+            threadByEncoder[encoder]->push({ encoder, block, samplesPerChannel });
+        }
+    };
+
+    for (samples_t offset = 0; offset < m_totalSamplesPerChannel; offset += SAMPLES_PER_CHANNEL) {
+        samples_t samplesPerChannel = std::min(SAMPLES_PER_CHANNEL, m_totalSamplesPerChannel - offset);
+
+        auto master = std::make_shared<Block>(INTERNAL_BUFFER_SIZE, 0.f);
+        m_mixer->process(master->data(), SAMPLES_PER_CHANNEL);
+
+        pushBlock(m_masterEncoders, master, samplesPerChannel);
+
+        for (const auto& pair : m_stemEncoders) {
+            auto it = stemBlocks.find(pair.first);
+            pushBlock(pair.second, it != stemBlocks.end() ? it->second : silence, samplesPerChannel);
+        }
+
+        stemBlocks.clear();
+    }
+
+    m_mixer->setChannelOutputTap(nullptr);
+
+    bool ok = true;
+    for (EncoderThread& thread : threads) {
+        ok &= thread.finish();
     }
 
-    return true;
+    return ok;
 }
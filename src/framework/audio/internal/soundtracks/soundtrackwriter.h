@@ -27,27 +27,34 @@
 #include <cstdio>
 
 #include "audiotypes.h"
-#include "iaudiosource.h"
+#include "internal/worker/mixer.h"
 #include "internal/encoders/abstractaudioencoder.h"
 
 namespace mu::audio::soundtrack {
+//! NOTE Renders the mixer once and streams the master bus into every destination
+//!      and the output of the mixer channels into the stem destinations;
+//!      the encoders run on their own threads and take the blocks from bounded queues,
+//!      so the used memory does not depend on the length of the score
 class SoundTrackWriter
 {
 public:
-    SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration, IAudioSourcePtr source);
+    SoundTrackWriter(const SoundTrackDestinationList& destinations, const SoundTrackStemDestinations& stemDestinations,
+                     const msecs_t totalDuration, MixerPtr mixer);
 
     bool write();
 
 private:
     encode::AbstractAudioEncoderPtr createEncoder(const SoundTrackType& type) const;
-    bool prepareInputBuffer();
+    bool render();
 
-    IAudioSourcePtr m_source = nullptr;
+    MixerPtr m_mixer = nullptr;
 
-    std::vector<float> m_inputBuffer;
-    std::vector<float> m_intermBuffer;
+    sample_rate_t m_sampleRate = 0;
+    samples_t m_totalSamplesPerChannel = 0;
 
-    encode::AbstractAudioEncoderPtr m_encoderPtr = nullptr;
+    std::vector<encode::AbstractAudioEncoderPtr> m_encoders;
+    std::map<TrackId, std::vector<encode::AbstractAudioEncoder*> > m_stemEncoders;
+    std::vector<encode::AbstractAudioEncoder*> m_masterEncoders;
 };
 }
 
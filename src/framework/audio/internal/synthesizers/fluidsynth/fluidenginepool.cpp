@@ -0,0 +1,394 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "fluidenginepool.h"
+
+#include <algorithm>
+#include <fluidsynth.h>
+
+#include "log.h"
+
+#include "sfcachedloader.h"
+#include "audioerrors.h"
+
+using namespace mu;
+using namespace mu::midi;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+
+static constexpr double FLUID_GLOBAL_VOLUME_GAIN = 4.8;
+static constexpr int MIN_NOTE_LENGTH = 25;
+static constexpr channel_t FLUID_MIDI_CHANNELS_COUNT = 16;
+
+/// @note
+///  Fluid has two effects channels per effects unit: reverb and chorus
+/// @see https://www.fluidsynth.org/api/settings_synth.html
+static constexpr int FLUID_EFFECTS_CHANNELS_COUNT = 2;
+
+// ========================
+// Fluid
+// ========================
+
+Fluid::Fluid(unsigned int sampleRate, channel_t audioGroupsCount)
+{
+    auto fluid_log_out = [](int level, const char* message, void*) {
+        switch (level) {
+        case FLUID_PANIC:
+        case FLUID_ERR:  {
+            LOGE() << message;
+        } break;
+        case FLUID_WARN: {
+            LOGW() << message;
+        } break;
+        case FLUID_INFO: {
+            LOGI() << message;
+        } break;
+        case FLUID_DBG:  {
+            LOGD() << message;
+        } break;
+        }
+    };
+
+    fluid_set_log_function(FLUID_PANIC, fluid_log_out, nullptr);
+    fluid_set_log_function(FLUID_ERR, fluid_log_out, nullptr);
+    fluid_set_log_function(FLUID_WARN, fluid_log_out, nullptr);
+    fluid_set_log_function(FLUID_INFO, fluid_log_out, nullptr);
+    fluid_set_log_function(FLUID_DBG, fluid_log_out, nullptr);
+
+    settings = new_fluid_settings();
+    fluid_settings_setnum(settings, "synth.gain", FLUID_GLOBAL_VOLUME_GAIN);
+    fluid_settings_setint(settings, "synth.audio-channels", audioGroupsCount); // pairs of audio channels
+    fluid_settings_setint(settings, "synth.audio-groups", audioGroupsCount);
+    fluid_settings_setint(settings, "synth.effects-groups", audioGroupsCount);
+    fluid_settings_setint(settings, "synth.lock-memory", 0);
+    fluid_settings_setint(settings, "synth.threadsafe-api", 0);
+    fluid_settings_setint(settings, "synth.midi-channels", FLUID_MIDI_CHANNELS_COUNT);
+    fluid_settings_setint(settings, "synth.dynamic-sample-loading", 1);
+    fluid_settings_setint(settings, "synth.polyphony", 512);
+
+    if (sampleRate > 0) {
+        fluid_settings_setnum(settings, "synth.sample-rate", static_cast<double>(sampleRate));
+    }
+
+    fluid_settings_setint(settings, "synth.min-note-length", MIN_NOTE_LENGTH);
+
+    fluid_settings_setint(settings, "synth.chorus.active", 0);
+    fluid_settings_setnum(settings, "synth.chorus.depth", 8);
+    fluid_settings_setnum(settings, "synth.chorus.level", 10);
+    fluid_settings_setint(settings, "synth.chorus.nr", 4);
+    fluid_settings_setnum(settings, "synth.chorus.speed", 1);
+
+    fluid_settings_setint(settings, "synth.reverb.active", 1);
+    fluid_settings_setnum(settings, "synth.reverb.room-size", 0.6);
+    fluid_settings_setnum(settings, "synth.reverb.damp", 0.8);
+    fluid_settings_setnum(settings, "synth.reverb.width", 10.0);
+    fluid_settings_setnum(settings, "synth.reverb.level", 0.5);
+
+    fluid_settings_setstr(settings, "audio.sample-format", "float");
+
+    createSynth();
+}
+
+Fluid::~Fluid()
+{
+    delete_fluid_synth(synth);
+    delete_fluid_settings(settings);
+}
+
+void Fluid::createSynth()
+{
+    synth = new_fluid_synth(settings);
+
+    fluid_sfloader_t* sfloader = new_fluid_sfloader(loadSoundFont, delete_fluid_sfloader);
+
+    fluid_sfloader_set_data(sfloader, settings);
+    fluid_synth_add_sfloader(synth, sfloader);
+}
+
+void Fluid::setSampleRate(unsigned int sampleRate)
+{
+    fluid_settings_setnum(settings, "synth.sample-rate", static_cast<double>(sampleRate));
+
+    if (synth) {
+        delete_fluid_synth(synth);
+    }
+
+    createSynth();
+    addSoundFonts(std::vector<io::path_t>(sfontPaths.cbegin(), sfontPaths.cend()));
+}
+
+Ret Fluid::addSoundFonts(const std::vector<io::path_t>& sfonts)
+{
+    IF_ASSERT_FAILED(synth) {
+        return make_ret(Err::SynthNotInited);
+    }
+
+    bool ok = true;
+    for (const io::path_t& sfont : sfonts) {
+        if (fluid_synth_sfload(synth, sfont.c_str(), 0) == FLUID_FAILED) {
+            LOGE() << "failed load soundfont: " << sfont;
+            ok = false;
+            continue;
+        }
+
+        LOGI() << "success load soundfont: " << sfont;
+        sfontPaths.insert(sfont);
+    }
+
+    return ok ? make_ret(Err::NoError) : make_ret(Err::SoundFontFailedLoad);
+}
+
+// ========================
+// FluidEnginePool
+// ========================
+
+struct FluidEnginePool::Engine {
+    FluidPtr fluid;
+    std::set<io::path_t> sfonts;
+    unsigned int sampleRate = 0;
+    channel_t groupsCount = 0;
+
+    std::vector<SlotPtr> slots; // by group, nullptr if the group is free
+    std::vector<std::vector<float>> buffers; // left and right output by group
+    std::vector<float*> outputs;
+    std::vector<float*> effects;
+    samples_t renderedSamplesCount = 0;
+    uint64_t renderedBlock = 0;
+
+    size_t freeGroup() const
+    {
+        auto it = std::find(slots.cbegin(), slots.cend(), nullptr);
+        return std::distance(slots.cbegin(), it);
+    }
+};
+
+const FluidPtr& FluidEnginePool::Slot::fluid() const
+{
+    return m_engine->fluid;
+}
+
+channel_t FluidEnginePool::Slot::channelsCount() const
+{
+    return m_channelsCount;
+}
+
+int FluidEnginePool::Slot::fluidChannel(channel_t channel) const
+{
+    return m_group + channel * m_engine->groupsCount;
+}
+
+FluidEnginePool::FluidEnginePool() = default;
+FluidEnginePool::~FluidEnginePool() = default;
+
+FluidEnginePool::SlotPtr FluidEnginePool::acquire(const std::set<io::path_t>& sfonts, unsigned int sampleRate, size_t channelsCount,
+                                                  const EventsProcessor& processEvents)
+{
+    if (channelsCount > FLUID_MIDI_CHANNELS_COUNT) {
+        LOGW() << "too many channels: " << channelsCount << ", only " << FLUID_MIDI_CHANNELS_COUNT << " are available";
+        channelsCount = FLUID_MIDI_CHANNELS_COUNT;
+    }
+
+    //! NOTE The channels of a group are "group + n * groupsCount", so all groups of an engine have the same size
+    channel_t channelsPerGroup = 1;
+    while (channelsPerGroup < channelsCount) {
+        channelsPerGroup *= 2;
+    }
+
+    const channel_t groupsCount = FLUID_MIDI_CHANNELS_COUNT / channelsPerGroup;
+
+    Engine* engine = nullptr;
+    for (const std::unique_ptr<Engine>& e : m_engines) {
+        if (e->groupsCount == groupsCount && e->sampleRate == sampleRate && e->sfonts == sfonts
+            && e->freeGroup() < e->slots.size()) {
+            engine = e.get();
+            break;
+        }
+    }
+
+    if (!engine) {
+        auto newEngine = std::make_unique<Engine>();
+        newEngine->fluid = std::make_shared<Fluid>(sampleRate, groupsCount);
+        newEngine->fluid->addSoundFonts(std::vector<io::path_t>(sfonts.cbegin(), sfonts.cend()));
+        newEngine->sfonts = sfonts;
+        newEngine->sampleRate = sampleRate;
+        newEngine->groupsCount = groupsCount;
+        newEngine->slots.resize(groupsCount);
+        newEngine->buffers.resize(groupsCount * 2);
+
+        engine = newEngine.get();
+        m_engines.push_back(std::move(newEngine));
+    }
+
+    const size_t group = engine->freeGroup();
+
+    SlotPtr slot = std::make_shared<Slot>();
+    slot->m_engine = engine;
+    slot->m_group = static_cast<channel_t>(group);
+    slot->m_channelsCount = static_cast<channel_t>(channelsCount);
+    slot->m_processEvents = processEvents;
+
+    //! NOTE The slots are acquired between the blocks, when the other slots have read the current block,
+    //! so the new slot starts with the next block too
+    slot->m_readBlock = engine->renderedBlock;
+
+    engine->slots[group] = slot;
+
+    return slot;
+}
+
+void FluidEnginePool::release(const SlotPtr& slot)
+{
+    if (!slot) {
+        return;
+    }
+
+    Engine* engine = slot->m_engine;
+    engine->slots[slot->m_group] = nullptr;
+
+    auto it = std::find_if(m_engines.begin(), m_engines.end(), [engine](const std::unique_ptr<Engine>& e) {
+        return e.get() == engine;
+    });
+
+    if (std::all_of(engine->slots.cbegin(), engine->slots.cend(), [](const SlotPtr& s) { return s == nullptr; })) {
+        m_engines.erase(it);
+        return;
+    }
+
+    //! NOTE Make the channels clean for the next track
+    for (channel_t ch = 0; ch < FLUID_MIDI_CHANNELS_COUNT / engine->groupsCount; ++ch) {
+        int channel = slot->fluidChannel(ch);
+        fluid_synth_all_sounds_off(engine->fluid->synth, channel);
+        fluid_synth_cc(engine->fluid->synth, channel, 121, 127);
+    }
+}
+
+//! NOTE A synth with a single voice and without effects, only to load the soundfont.
+//! The soundfont data stays in the SoundFontCache, the engines that load it later reuse it
+static bool loadSoundFontOnce(const io::path_t& sfont)
+{
+    fluid_settings_t* settings = new_fluid_settings();
+    fluid_settings_setint(settings, "synth.polyphony", 1);
+    fluid_settings_setint(settings, "synth.reverb.active", 0);
+    fluid_settings_setint(settings, "synth.chorus.active", 0);
+    fluid_settings_setint(settings, "synth.lock-memory", 0);
+    fluid_settings_setint(settings, "synth.dynamic-sample-loading", 1);
+
+    fluid_synth_t* synth = new_fluid_synth(settings);
+
+    fluid_sfloader_t* sfloader = new_fluid_sfloader(loadSoundFont, delete_fluid_sfloader);
+    fluid_sfloader_set_data(sfloader, settings);
+    fluid_synth_add_sfloader(synth, sfloader);
+
+    const bool ok = fluid_synth_sfload(synth, sfont.c_str(), 0) != FLUID_FAILED;
+    if (!ok) {
+        LOGE() << "failed load soundfont: " << sfont;
+    }
+
+    delete_fluid_synth(synth);
+    delete_fluid_settings(settings);
+
+    return ok;
+}
+
+Ret FluidEnginePool::checkSoundFonts(const std::vector<io::path_t>& sfonts)
+{
+    bool ok = true;
+    for (const io::path_t& sfont : sfonts) {
+        auto it = m_soundFontsLoaded.find(sfont);
+        if (it == m_soundFontsLoaded.end()) {
+            it = m_soundFontsLoaded.emplace(sfont, loadSoundFontOnce(sfont)).first;
+        }
+
+        ok = ok && it->second;
+    }
+
+    return ok ? make_ret(Err::NoError) : make_ret(Err::SoundFontFailedLoad);
+}
+
+samples_t FluidEnginePool::process(const SlotPtr& slot, float* buffer, samples_t samplesPerChannel)
+{
+    Engine& engine = *slot->m_engine;
+
+    if (slot->m_readBlock == engine.renderedBlock) {
+        render(engine, samplesPerChannel);
+    }
+
+    slot->m_readBlock = engine.renderedBlock;
+
+    if (engine.renderedSamplesCount == 0) {
+        return 0;
+    }
+
+    const float* left = engine.buffers[slot->m_group * 2].data();
+    const float* right = engine.buffers[slot->m_group * 2 + 1].data();
+
+    //! NOTE The block was rendered with the size asked by the first slot
+    const samples_t count = std::min(samplesPerChannel, engine.renderedSamplesCount);
+    for (samples_t i = 0; i < count; ++i) {
+        buffer[i * 2] = left[i];
+        buffer[i * 2 + 1] = right[i];
+    }
+
+    std::fill(buffer + count * 2, buffer + samplesPerChannel * 2, 0.f);
+
+    return samplesPerChannel;
+}
+
+void FluidEnginePool::render(Engine& engine, samples_t samplesPerChannel)
+{
+    for (const SlotPtr& slot : engine.slots) {
+        if (slot) {
+            slot->m_processEvents(samplesPerChannel);
+        }
+    }
+
+    const size_t buffersCount = engine.buffers.size();
+    engine.outputs.resize(buffersCount);
+    engine.effects.resize(buffersCount * FLUID_EFFECTS_CHANNELS_COUNT);
+
+    for (size_t i = 0; i < buffersCount; ++i) {
+        std::vector<float>& buf = engine.buffers[i];
+        buf.assign(samplesPerChannel, 0.f);
+        engine.outputs[i] = buf.data();
+    }
+
+    //! NOTE The effects of a group are mixed into the output of the same group
+    for (size_t group = 0; group < engine.groupsCount; ++group) {
+        for (int fx = 0; fx < FLUID_EFFECTS_CHANNELS_COUNT; ++fx) {
+            size_t idx = (group * FLUID_EFFECTS_CHANNELS_COUNT + fx) * 2;
+            engine.effects[idx] = engine.outputs[group * 2];
+            engine.effects[idx + 1] = engine.outputs[group * 2 + 1];
+        }
+    }
+
+    int result = fluid_synth_process(engine.fluid->synth, static_cast<int>(samplesPerChannel),
+                                     static_cast<int>(engine.effects.size()), engine.effects.data(),
+                                     static_cast<int>(engine.outputs.size()), engine.outputs.data());
+
+    engine.renderedSamplesCount = result == FLUID_OK ? samplesPerChannel : 0;
+    engine.renderedBlock++;
+}
+
+size_t FluidEnginePool::enginesCount() const
+{
+    return m_engines.size();
+}
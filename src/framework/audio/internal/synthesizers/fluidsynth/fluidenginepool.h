@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_FLUIDENGINEPOOL_H
+#define MU_AUDIO_FLUIDENGINEPOOL_H
+
+#include <memory>
+#include <vector>
+#include <set>
+#include <map>
+#include <functional>
+
+#include "types/ret.h"
+#include "io/path.h"
+#include "midi/midievent.h"
+
+#include "audiotypes.h"
+
+typedef struct _fluid_hashtable_t fluid_settings_t;
+typedef struct _fluid_synth_t fluid_synth_t;
+
+namespace mu::audio::synth {
+//! NOTE One fluid engine: settings, voice pool, reverb and chorus.
+//! Each audio group gets its own stereo output and effects unit,
+//! a MIDI channel is rendered to the group "channel % audioGroupsCount"
+struct Fluid {
+    fluid_settings_t* settings = nullptr;
+    fluid_synth_t* synth = nullptr;
+    std::set<io::path_t> sfontPaths;
+
+    Fluid(unsigned int sampleRate, midi::channel_t audioGroupsCount = 1);
+    ~Fluid();
+
+    void setSampleRate(unsigned int sampleRate);
+    Ret addSoundFonts(const std::vector<io::path_t>& sfonts);
+
+private:
+    void createSynth();
+};
+
+using FluidPtr = std::shared_ptr<Fluid>;
+
+//! NOTE Lets several tracks share one fluid engine instead of creating an engine per track.
+//! The 16 MIDI channels of an engine are split into audio groups of 1, 2, 4, 8 or 16 channels,
+//! every track takes one group, so its output stays separate for the mixer channel of the track
+class FluidEnginePool
+{
+    struct Engine;
+
+public:
+    //! NOTE Called before a shared engine renders the next block, so every track sends its events for that block
+    using EventsProcessor = std::function<void (samples_t samplesPerChannel)>;
+
+    class Slot
+    {
+    public:
+        const FluidPtr& fluid() const;
+        midi::channel_t channelsCount() const;
+
+        //! NOTE Maps a channel of the track to the channel of the shared engine
+        int fluidChannel(midi::channel_t channel) const;
+
+    private:
+        friend class FluidEnginePool;
+        Engine* m_engine = nullptr;
+        midi::channel_t m_group = 0;
+        midi::channel_t m_channelsCount = 0;
+        EventsProcessor m_processEvents;
+        uint64_t m_readBlock = 0;
+    };
+
+    using SlotPtr = std::shared_ptr<Slot>;
+
+    FluidEnginePool();
+    ~FluidEnginePool();
+
+    SlotPtr acquire(const std::set<io::path_t>& sfonts, unsigned int sampleRate, size_t channelsCount,
+                    const EventsProcessor& processEvents);
+    void release(const SlotPtr& slot);
+
+    //! NOTE Loads the soundfonts once to report their errors when a track adds them,
+    //! before the track takes a shared engine on setup. The results are kept by path
+    Ret checkSoundFonts(const std::vector<io::path_t>& sfonts);
+
+    //! NOTE Writes the output of the slot. The engine counts the blocks it renders and every slot
+    //! counts the blocks it reads: the first slot that asks for the next block renders it, the others read it.
+    //! Every slot is expected to be processed once per block (as the mixer processes all channels),
+    //! the order does not matter
+    samples_t process(const SlotPtr& slot, float* buffer, samples_t samplesPerChannel);
+
+    size_t enginesCount() const;
+
+private:
+    void render(Engine& engine, samples_t samplesPerChannel);
+
+    std::vector<std::unique_ptr<Engine>> m_engines;
+    std::map<io::path_t, bool> m_soundFontsLoaded;
+};
+
+using FluidEnginePoolPtr = std::shared_ptr<FluidEnginePool>;
+}
+
+#endif // MU_AUDIO_FLUIDENGINEPOOL_H
@@ -31,10 +31,14 @@ using namespace mu::audio::synth;
 
 static const AudioResourceVendor FLUID_VENDOR_NAME = "Fluid";
 
-FluidResolver::FluidResolver()
+FluidResolver::FluidResolver(bool useSharedEngines)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    if (useSharedEngines) {
+        m_enginePool = std::make_shared<FluidEnginePool>();
+    }
+
     refresh();
     soundFontRepository()->soundFontPathsChanged().onNotify(this, [this]() {
         refresh();
@@ -45,7 +49,7 @@ ISynthesizerPtr FluidResolver::resolveSynth(const TrackId /*trackId*/, const Aud
 {
     ONLY_AUDIO_WORKER_THREAD;
 
-    FluidSynthPtr synth = std::make_shared<FluidSynth>(params);
+    FluidSynthPtr synth = std::make_shared<FluidSynth>(params, m_enginePool);
 
     auto search = m_resourcesCache.find(params.resourceMeta.id);
 
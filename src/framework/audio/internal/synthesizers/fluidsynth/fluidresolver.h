@@ -31,13 +31,15 @@
 
 #include "isynthresolver.h"
 #include "fluidsynth.h"
+#include "fluidenginepool.h"
 
 namespace mu::audio::synth {
 class FluidResolver : public ISynthResolver::IResolver, public async::Asyncable
 {
     INJECT(audio, ISoundFontRepository, soundFontRepository)
 public:
-    explicit FluidResolver();
+    //! NOTE With shared engines the tracks of the same soundfont are multiplexed over the channels of a few engines
+    explicit FluidResolver(bool useSharedEngines = false);
 
     ISynthesizerPtr resolveSynth(const audio::TrackId trackId, const audio::AudioInputParams& params) const override;
     bool hasCompatibleResources(const audio::PlaybackSetupData& setup) const override;
@@ -50,6 +52,7 @@ private:
     FluidSynthPtr createSynth(const audio::AudioResourceId& resourceId) const;
 
     std::unordered_map<AudioResourceId, io::path_t> m_resourcesCache;
+    FluidEnginePoolPtr m_enginePool = nullptr;
 };
 }
 
@@ -31,7 +31,6 @@
 #include "log.h"
 #include "realfn.h"
 
-#include "sfcachedloader.h"
 #include "audioerrors.h"
 #include "audiotypes.h"
 
@@ -41,36 +40,39 @@ using namespace mu::audio;
 using namespace mu::audio::synth;
 using namespace mu::mpe;
 
-static constexpr double FLUID_GLOBAL_VOLUME_GAIN = 4.8;
 static constexpr int DEFAULT_MIDI_VOLUME = 100;
-static constexpr msecs_t MIN_NOTE_LENGTH = 25;
 
 /// @note
 ///  Fluid does not support MONO, so they start counting audio channels from 1, which means "1 pair of audio channels"
 /// @see https://www.fluidsynth.org/api/settings_synth.html
 static const audioch_t FLUID_AUDIO_CHANNELS_PAIR = 1;
 
-struct mu::audio::synth::Fluid {
-    fluid_settings_t* settings = nullptr;
-    fluid_synth_t* synth = nullptr;
-
-    ~Fluid()
-    {
-        delete_fluid_synth(synth);
-        delete_fluid_settings(settings);
+FluidSynth::FluidSynth(const AudioSourceParams& params, FluidEnginePoolPtr enginePool)
+    : AbstractSynthesizer(params), m_enginePool(enginePool)
+{
+    if (!m_enginePool) {
+        m_fluid = std::make_shared<Fluid>(m_sampleRate);
     }
-};
 
-FluidSynth::FluidSynth(const AudioSourceParams& params)
-    : AbstractSynthesizer(params)
-{
-    m_fluid = std::make_shared<Fluid>();
+    m_currentExpressionLevel = DEFAULT_MIDI_VOLUME;
 
-    init();
+    m_sequencer.flushedOffStreamEvents().onNotify(this, [this]() {
+        revokePlayingNotes();
+    });
+}
+
+FluidSynth::~FluidSynth()
+{
+    releaseSlot();
 }
 
 bool FluidSynth::isValid() const
 {
+    //! NOTE A shared engine is taken from the pool on setup
+    if (m_enginePool) {
+        return m_sfontsLoaded && (!m_slot || m_fluid->synth != nullptr);
+    }
+
     return m_fluid->synth != nullptr;
 }
 
@@ -79,114 +81,65 @@ SoundFontFormats FluidSynth::soundFontFormats() const
     return { SoundFontFormat::SF2, SoundFontFormat::SF3 };
 }
 
-Ret FluidSynth::init()
+void FluidSynth::acquireSlot()
 {
-    auto fluid_log_out = [](int level, const char* message, void*) {
-        switch (level) {
-        case FLUID_PANIC:
-        case FLUID_ERR:  {
-            LOGE() << message;
-        } break;
-        case FLUID_WARN: {
-            LOGW() << message;
-        } break;
-        case FLUID_INFO: {
-            LOGI() << message;
-        } break;
-        case FLUID_DBG:  {
-            LOGD() << message;
-        } break;
-        }
+    releaseSlot();
 
-        if (level < FLUID_DBG) {
-            bool debugme = true;
-            (void)debugme;
-        }
-    };
-
-    fluid_set_log_function(FLUID_PANIC, fluid_log_out, nullptr);
-    fluid_set_log_function(FLUID_ERR, fluid_log_out, nullptr);
-    fluid_set_log_function(FLUID_WARN, fluid_log_out, nullptr);
-    fluid_set_log_function(FLUID_INFO, fluid_log_out, nullptr);
-    fluid_set_log_function(FLUID_DBG, fluid_log_out, nullptr);
-
-    m_fluid->settings = new_fluid_settings();
-    fluid_settings_setnum(m_fluid->settings, "synth.gain", FLUID_GLOBAL_VOLUME_GAIN);
-    fluid_settings_setint(m_fluid->settings, "synth.audio-channels", FLUID_AUDIO_CHANNELS_PAIR); // 1 pair of audio channels
-    fluid_settings_setint(m_fluid->settings, "synth.lock-memory", 0);
-    fluid_settings_setint(m_fluid->settings, "synth.threadsafe-api", 0);
-    fluid_settings_setint(m_fluid->settings, "synth.midi-channels", 16);
-    fluid_settings_setint(m_fluid->settings, "synth.dynamic-sample-loading", 1);
-    fluid_settings_setint(m_fluid->settings, "synth.polyphony", 512);
-
-    if (m_sampleRate > 0) {
-        fluid_settings_setnum(m_fluid->settings, "synth.sample-rate", static_cast<double>(m_sampleRate));
+    if (m_sampleRate == 0 || m_channels.empty()) {
+        return;
     }
 
-    fluid_settings_setint(m_fluid->settings, "synth.min-note-length", MIN_NOTE_LENGTH);
-
-    fluid_settings_setint(m_fluid->settings, "synth.chorus.active", 0);
-    fluid_settings_setnum(m_fluid->settings, "synth.chorus.depth", 8);
-    fluid_settings_setnum(m_fluid->settings, "synth.chorus.level", 10);
-    fluid_settings_setint(m_fluid->settings, "synth.chorus.nr", 4);
-    fluid_settings_setnum(m_fluid->settings, "synth.chorus.speed", 1);
-
-    fluid_settings_setint(m_fluid->settings, "synth.reverb.active", 1);
-    fluid_settings_setnum(m_fluid->settings, "synth.reverb.room-size", 0.6);
-    fluid_settings_setnum(m_fluid->settings, "synth.reverb.damp", 0.8);
-    fluid_settings_setnum(m_fluid->settings, "synth.reverb.width", 10.0);
-    fluid_settings_setnum(m_fluid->settings, "synth.reverb.level", 0.5);
-
-    fluid_settings_setstr(m_fluid->settings, "audio.sample-format", "float");
-
-    createFluidInstance();
-
-    m_currentExpressionLevel = DEFAULT_MIDI_VOLUME;
-
-    m_sequencer.flushedOffStreamEvents().onNotify(this, [this]() {
-        revokePlayingNotes();
+    m_slot = m_enginePool->acquire(m_sfontPaths, m_sampleRate, m_channels.size(), [this](samples_t samplesPerChannel) {
+        processEvents(samplesPerChannel);
     });
 
-    LOGD() << "synth inited\n";
-    return true;
+    m_fluid = m_slot->fluid();
 }
 
-void FluidSynth::createFluidInstance()
+void FluidSynth::releaseSlot()
 {
-    m_fluid->synth = new_fluid_synth(m_fluid->settings);
+    if (!m_slot) {
+        return;
+    }
 
-    fluid_sfloader_t* sfloader = new_fluid_sfloader(loadSoundFont, delete_fluid_sfloader);
+    m_enginePool->release(m_slot);
+    m_slot = nullptr;
+    m_fluid = nullptr;
+}
 
-    fluid_sfloader_set_data(sfloader, m_fluid->settings);
-    fluid_synth_add_sfloader(m_fluid->synth, sfloader);
+int FluidSynth::fluidChannel(channel_t channel) const
+{
+    return m_slot ? m_slot->fluidChannel(channel) : channel;
 }
 
 bool FluidSynth::handleEvent(const midi::Event& event)
 {
+    const int channel = fluidChannel(event.channel());
+
     int ret = FLUID_OK;
     switch (event.opcode()) {
     case Event::Opcode::NoteOn: {
-        ret = fluid_synth_noteon(m_fluid->synth, event.channel(), event.note(), event.velocity());
+        ret = fluid_synth_noteon(m_fluid->synth, channel, event.note(), event.velocity());
     } break;
     case Event::Opcode::NoteOff: {
-        ret = fluid_synth_noteoff(m_fluid->synth, event.channel(), event.note());
+        ret = fluid_synth_noteoff(m_fluid->synth, channel, event.note());
     } break;
     case Event::Opcode::ControlChange: {
         int currentValue = 0;
-        fluid_synth_get_cc(m_fluid->synth, event.channel(), event.index(), &currentValue);
+        fluid_synth_get_cc(m_fluid->synth, channel, event.index(), &currentValue);
 
         if (event.data() == static_cast<uint32_t>(currentValue)) {
             break;
         }
 
-        ret = fluid_synth_cc(m_fluid->synth, event.channel(), event.index(), event.data());
+        ret = fluid_synth_cc(m_fluid->synth, channel, event.index(), event.data());
         updateCurrentExpressionLevel(event);
     } break;
     case Event::Opcode::ProgramChange: {
-        fluid_synth_program_change(m_fluid->synth, event.channel(), event.program());
+        fluid_synth_program_change(m_fluid->synth, channel, event.program());
     } break;
     case Event::Opcode::PitchBend: {
-        ret = fluid_synth_pitch_bend(m_fluid->synth, event.channel(), event.data());
+        ret = fluid_synth_pitch_bend(m_fluid->synth, channel, event.data());
     } break;
     default: {
         LOGD() << "not supported event type: " << event.opcodeString();
@@ -213,38 +166,35 @@ void FluidSynth::setSampleRate(unsigned int sampleRate)
     }
 
     m_sampleRate = sampleRate;
-    if (m_fluid->settings) {
-        fluid_settings_setnum(m_fluid->settings, "synth.sample-rate", static_cast<double>(m_sampleRate));
-    }
 
-    if (m_fluid->synth) {
-        delete_fluid_synth(m_fluid->synth);
+    if (m_enginePool) {
+        //! NOTE Tracks share engines of the same sample rate only
+        acquireSlot();
+        setupChannels();
+        return;
     }
 
-    createFluidInstance();
-    addSoundFonts(std::vector<io::path_t>(m_sfontPaths.cbegin(), m_sfontPaths.cend()));
+    m_fluid->setSampleRate(m_sampleRate);
     setupSound(m_setupData);
 }
 
 Ret FluidSynth::addSoundFonts(const std::vector<io::path_t>& sfonts)
 {
-    IF_ASSERT_FAILED(m_fluid->synth) {
-        return make_ret(Err::SynthNotInited);
+    if (!m_enginePool) {
+        return m_fluid->addSoundFonts(sfonts);
     }
 
-    bool ok = true;
-    for (const io::path_t& sfont : sfonts) {
-        if (fluid_synth_sfload(m_fluid->synth, sfont.c_str(), 0) == FLUID_FAILED) {
-            LOGE() << "failed load soundfont: " << sfont;
-            ok = false;
-            continue;
-        }
+    //! NOTE The shared engine with these soundfonts is taken on setup
+    Ret ret = m_enginePool->checkSoundFonts(sfonts);
+    m_sfontsLoaded = m_sfontsLoaded && ret.success();
+    m_sfontPaths.insert(sfonts.cbegin(), sfonts.cend());
 
-        LOGI() << "success load soundfont: " << sfont;
-        m_sfontPaths.insert(sfont);
+    if (m_slot) {
+        acquireSlot();
+        setupChannels();
     }
 
-    return ok ? make_ret(Err::NoError) : make_ret(Err::SoundFontFailedLoad);
+    return ret;
 }
 
 std::string FluidSynth::name() const
@@ -259,10 +209,6 @@ AudioSourceType FluidSynth::type() const
 
 void FluidSynth::setupSound(const PlaybackSetupData& setupData)
 {
-    IF_ASSERT_FAILED(m_fluid->synth) {
-        return;
-    }
-
     m_channels.clear();
     m_articulationMapping.clear();
 
@@ -276,21 +222,41 @@ void FluidSynth::setupSound(const PlaybackSetupData& setupData)
         m_channels.emplace(static_cast<int>(m_channels.size()), pair.second);
     }
 
-    for (const auto& pair : m_channels) {
-        fluid_synth_set_interp_method(m_fluid->synth, pair.first, FLUID_INTERP_DEFAULT);
-        fluid_synth_pitch_wheel_sens(m_fluid->synth, pair.first, 12);
-        fluid_synth_bank_select(m_fluid->synth, pair.first, pair.second.bank);
-        fluid_synth_program_change(m_fluid->synth, pair.first, pair.second.program);
-        fluid_synth_cc(m_fluid->synth, pair.first, 7, m_currentExpressionLevel);
-        fluid_synth_cc(m_fluid->synth, pair.first, 74, 0);
-        fluid_synth_set_portamento_mode(m_fluid->synth, pair.first, FLUID_CHANNEL_PORTAMENTO_MODE_EACH_NOTE);
-        fluid_synth_set_legato_mode(m_fluid->synth, pair.first, FLUID_CHANNEL_LEGATO_MODE_RETRIGGER);
-        fluid_synth_activate_tuning(m_fluid->synth, pair.first, 0, 0, 0);
+    if (m_enginePool) {
+        //! NOTE The number of channels defines the group size in the shared engine
+        acquireSlot();
     }
 
+    setupChannels();
+
     m_sequencer.init(m_articulationMapping, m_channels);
 }
 
+void FluidSynth::setupChannels()
+{
+    if (!m_fluid) {
+        return;
+    }
+
+    IF_ASSERT_FAILED(m_fluid->synth) {
+        return;
+    }
+
+    for (const auto& pair : m_channels) {
+        const int channel = fluidChannel(pair.first);
+
+        fluid_synth_set_interp_method(m_fluid->synth, channel, FLUID_INTERP_DEFAULT);
+        fluid_synth_pitch_wheel_sens(m_fluid->synth, channel, 12);
+        fluid_synth_bank_select(m_fluid->synth, channel, pair.second.bank);
+        fluid_synth_program_change(m_fluid->synth, channel, pair.second.program);
+        fluid_synth_cc(m_fluid->synth, channel, 7, m_currentExpressionLevel);
+        fluid_synth_cc(m_fluid->synth, channel, 74, 0);
+        fluid_synth_set_portamento_mode(m_fluid->synth, channel, FLUID_CHANNEL_PORTAMENTO_MODE_EACH_NOTE);
+        fluid_synth_set_legato_mode(m_fluid->synth, channel, FLUID_CHANNEL_LEGATO_MODE_RETRIGGER);
+        fluid_synth_activate_tuning(m_fluid->synth, channel, 0, 0, 0);
+    }
+}
+
 void FluidSynth::setupEvents(const mpe::PlaybackData& playbackData)
 {
     m_sequencer.load(playbackData);
@@ -298,6 +264,18 @@ void FluidSynth::setupEvents(const mpe::PlaybackData& playbackData)
 
 void FluidSynth::revokePlayingNotes()
 {
+    if (m_enginePool) {
+        //! NOTE Only the channels of this track in the shared engine
+        if (!m_slot) {
+            return;
+        }
+
+        for (const auto& pair : m_channels) {
+            fluid_synth_all_notes_off(m_fluid->synth, fluidChannel(pair.first));
+        }
+        return;
+    }
+
     IF_ASSERT_FAILED(m_fluid->synth) {
         return;
     }
@@ -307,6 +285,20 @@ void FluidSynth::revokePlayingNotes()
 
 void FluidSynth::flushSound()
 {
+    if (m_enginePool) {
+        if (!m_slot) {
+            return;
+        }
+
+        revokePlayingNotes();
+
+        for (const auto& pair : m_channels) {
+            fluid_synth_all_sounds_off(m_fluid->synth, fluidChannel(pair.first));
+            fluid_synth_cc(m_fluid->synth, fluidChannel(pair.first), 121, 127);
+        }
+        return;
+    }
+
     IF_ASSERT_FAILED(m_fluid->synth) {
         return;
     }
@@ -343,12 +335,8 @@ unsigned int FluidSynth::audioChannelsCount() const
     return FLUID_AUDIO_CHANNELS_PAIR * 2;
 }
 
-samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
+void FluidSynth::processEvents(samples_t samplesPerChannel)
 {
-    IF_ASSERT_FAILED(samplesPerChannel > 0) {
-        return 0;
-    }
-
     msecs_t nextMsecs = samplesToMsecs(samplesPerChannel, m_sampleRate);
 
     const FluidSequencer::EventSequence& sequence = m_sequencer.eventsToBePlayed(nextMsecs);
@@ -356,6 +344,24 @@ samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
     for (const FluidSequencer::EventType& event : sequence) {
         handleEvent(std::get<midi::Event>(event));
     }
+}
+
+samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
+{
+    IF_ASSERT_FAILED(samplesPerChannel > 0) {
+        return 0;
+    }
+
+    if (m_enginePool) {
+        //! NOTE The shared engine asks every track for its events before rendering
+        if (!m_slot) {
+            return 0;
+        }
+
+        return m_enginePool->process(m_slot, buffer, samplesPerChannel);
+    }
+
+    processEvents(samplesPerChannel);
 
     int result = fluid_synth_write_float(m_fluid->synth, samplesPerChannel,
                                          buffer, 0, audioChannelsCount(),
@@ -375,6 +381,10 @@ async::Channel<unsigned int> FluidSynth::audioChannelsCountChanged() const
 
 void FluidSynth::toggleExpressionController()
 {
+    if (!m_fluid) {
+        return;
+    }
+
     int volume = DEFAULT_MIDI_VOLUME;
 
     if (isActive()) {
@@ -382,6 +392,6 @@ void FluidSynth::toggleExpressionController()
     }
 
     for (const auto& pair : m_channels) {
-        fluid_synth_cc(m_fluid->synth, pair.first, 11, volume);
+        fluid_synth_cc(m_fluid->synth, fluidChannel(pair.first), 11, volume);
     }
 }
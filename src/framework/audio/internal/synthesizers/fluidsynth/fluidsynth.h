@@ -35,15 +35,17 @@
 
 #include "abstractsynthesizer.h"
 #include "fluidsequencer.h"
+#include "fluidenginepool.h"
 #include "soundmapping.h"
 
 namespace mu::audio::synth {
-struct Fluid;
 class FluidSynth : public AbstractSynthesizer
 {
     INJECT(audio, midi::IMidiOutPort, midiOutPort)
 public:
-    FluidSynth(const audio::AudioSourceParams& params);
+    //! NOTE With an engine pool the synth takes its channels in a shared engine instead of creating an own one
+    FluidSynth(const audio::AudioSourceParams& params, FluidEnginePoolPtr enginePool = nullptr);
+    ~FluidSynth() override;
 
     SoundFontFormats soundFontFormats() const;
     Ret addSoundFonts(const std::vector<io::path_t>& sfonts);
@@ -70,15 +72,20 @@ public:
     bool isValid() const override;
 
 private:
-    Ret init();
-    void createFluidInstance();
+    void setupChannels();
+    void acquireSlot();
+    void releaseSlot();
+    int fluidChannel(midi::channel_t channel) const;
 
+    void processEvents(samples_t samplesPerChannel);
     bool handleEvent(const midi::Event& event);
 
     void updateCurrentExpressionLevel(const midi::Event& event);
     void toggleExpressionController();
 
-    std::shared_ptr<Fluid> m_fluid = nullptr;
+    FluidPtr m_fluid = nullptr;
+    FluidEnginePoolPtr m_enginePool = nullptr;
+    FluidEnginePool::SlotPtr m_slot = nullptr;
 
     std::unordered_map<midi::channel_t, midi::Program> m_channels;
     ArticulationMapping m_articulationMapping;
@@ -89,6 +96,7 @@ private:
 
     FluidSequencer m_sequencer;
     std::set<io::path_t> m_sfontPaths;
+    bool m_sfontsLoaded = true;
 };
 
 using FluidSynthPtr = std::shared_ptr<FluidSynth>;
@@ -171,7 +171,50 @@ Promise<AudioSignalChanges> AudioOutputHandler::masterSignalChanges() const
 Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                                  const SoundTrackFormat& format)
 {
-    return Promise<bool>([this, sequenceId, destination, format](auto resolve, auto reject) {
+    return saveSoundTracks(sequenceId, { { destination, format } });
+}
+
+Promise<bool> AudioOutputHandler::saveSoundTracks(const TrackSequenceId sequenceId, const SoundTrackDestinationList& destinations)
+{
+    return doSaveSoundTracks(sequenceId, destinations, false /*withStems*/);
+}
+
+Promise<bool> AudioOutputHandler::saveSoundTrackStems(const TrackSequenceId sequenceId, const SoundTrackDestinationList& destinations)
+{
+    return doSaveSoundTracks(sequenceId, destinations, true /*withStems*/);
+}
+
+#ifdef ENABLE_AUDIO_EXPORT
+static SoundTrackStemDestinations stemDestinations(const ITrackSequencePtr s, const SoundTrackDestinationList& destinations)
+{
+    SoundTrackStemDestinations result;
+    std::set<mu::io::path_t> usedNames;
+
+    for (const TrackId trackId : s->trackIdList()) {
+        mu::io::path_t name = mu::io::escapeFileName(s->trackName(trackId));
+        if (name.empty()) {
+            name = "track-" + std::to_string(trackId);
+        } else if (usedNames.count(name) > 0) {
+            name = name + "-" + std::to_string(trackId);
+        }
+        usedNames.insert(name);
+
+        for (const SoundTrackDestination& destination : destinations) {
+            mu::io::path_t path = mu::io::dirpath(destination.path) + "/" + mu::io::completeBasename(destination.path)
+                                  + "-" + name + "." + mu::io::suffix(destination.path);
+            result[trackId].push_back({ path, destination.format });
+        }
+    }
+
+    return result;
+}
+
+#endif
+
+Promise<bool> AudioOutputHandler::doSaveSoundTracks(const TrackSequenceId sequenceId, const SoundTrackDestinationList& destinations,
+                                                    bool withStems)
+{
+    return Promise<bool>([this, sequenceId, destinations, withStems](auto resolve, auto reject) {
         ONLY_AUDIO_WORKER_THREAD;
 
         IF_ASSERT_FAILED(mixer()) {
@@ -184,9 +227,14 @@ Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceI
         }
 
 #ifdef ENABLE_AUDIO_EXPORT
+        SoundTrackStemDestinations stems;
+        if (withStems) {
+            stems = stemDestinations(s, destinations);
+        }
+
         s->player()->seek(0);
         msecs_t totalDuration = s->player()->duration();
-        SoundTrackWriter writer(destination, format, totalDuration, mixer());
+        SoundTrackWriter writer(destinations, stems, totalDuration, mixer());
 
         bool ok = writer.write();
         s->player()->seek(0);
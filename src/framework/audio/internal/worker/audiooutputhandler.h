@@ -54,8 +54,13 @@ public:
 
     async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                         const SoundTrackFormat& format) override;
+    async::Promise<bool> saveSoundTracks(const TrackSequenceId sequenceId, const SoundTrackDestinationList& destinations) override;
+    async::Promise<bool> saveSoundTrackStems(const TrackSequenceId sequenceId, const SoundTrackDestinationList& destinations) override;
 
 private:
+    async::Promise<bool> doSaveSoundTracks(const TrackSequenceId sequenceId, const SoundTrackDestinationList& destinations,
+                                           bool withStems);
+
     std::shared_ptr<Mixer> mixer() const;
     ITrackSequencePtr sequence(const TrackSequenceId id) const;
     void ensureSeqSubscriptions(const ITrackSequencePtr s) const;
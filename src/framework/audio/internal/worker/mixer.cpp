@@ -130,6 +130,10 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
 
     for (auto& channel : m_mixerChannels) {
         samples_t processedSamplesCount = channel.second->process(m_writeCacheBuff.data(), samplesPerChannel);
+        if (m_channelOutputTap) {
+            m_channelOutputTap(channel.first, m_writeCacheBuff.data(), samplesPerChannel);
+        }
+
         mixOutputFromChannel(outBuffer, m_writeCacheBuff.data(), processedSamplesCount);
         std::fill(m_writeCacheBuff.begin(), m_writeCacheBuff.end(), 0.f);
 
@@ -220,6 +224,13 @@ async::Channel<audioch_t, AudioSignalVal> Mixer::masterAudioSignalChanges() cons
     return m_audioSignalNotifier.audioSignalChanges;
 }
 
+void Mixer::setChannelOutputTap(ChannelOutputTap tap)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_channelOutputTap = std::move(tap);
+}
+
 void Mixer::mixOutputFromChannel(float* outBuffer, float* inBuffer, unsigned int samplesCount)
 {
     IF_ASSERT_FAILED(outBuffer && inBuffer) {
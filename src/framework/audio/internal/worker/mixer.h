@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <map>
+#include <functional>
 
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
@@ -58,6 +59,10 @@ public:
 
     async::Channel<audioch_t, AudioSignalVal> masterAudioSignalChanges() const;
 
+    //! NOTE Receives the output of every channel after its fx, before it is mixed into the master bus
+    using ChannelOutputTap = std::function<void (const TrackId trackId, const float* buffer, samples_t samplesPerChannel)>;
+    void setChannelOutputTap(ChannelOutputTap tap);
+
     // IAudioSource
     void setSampleRate(unsigned int sampleRate) override;
     unsigned int audioChannelsCount() const override;
@@ -76,6 +81,7 @@ private:
     std::vector<IFxProcessorPtr> m_masterFxProcessors = {};
 
     std::map<TrackId, MixerChannelPtr> m_mixerChannels = {};
+    ChannelOutputTap m_channelOutputTap = nullptr;
     dsp::LimiterPtr m_limiter = nullptr;
 
     std::set<IClockPtr> m_clocks;
@@ -20,32 +20,92 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "samplerateconvertor.h"
-#include "log.h"
+
+#include <algorithm>
 #include <cmath>
+#include <numeric>
+
+#include "log.h"
 
 using namespace mu::audio;
 
+struct QualityPreset {
+    unsigned int tapsCount = 0;    //!< taps per phase when upsampling, multiple of 4
+    double kaiserBeta = 0.0;       //!< stopband attenuation
+    double passband = 0.0;         //!< part of the Nyquist band that is kept
+};
+
+static QualityPreset qualityPreset(SampleRateConvertor::Quality quality)
+{
+    switch (quality) {
+    case SampleRateConvertor::Quality::Low: return { 8, 6.0, 0.85 };       // ~60 dB
+    case SampleRateConvertor::Quality::Medium: return { 16, 8.6, 0.9 };    // ~85 dB
+    case SampleRateConvertor::Quality::High: return { 32, 10.0, 0.94 };    // ~100 dB
+    }
+
+    return { 16, 8.6, 0.9 };
+}
+
+static double zeroBessel(double x)
+{
+    double s = 1.0;
+    double y = 1.0;
+    double m = 0.0;
+
+    do {
+        m += 1.0;
+        y *= (x * x) / (4.0 * m * m);
+        s += y;
+    } while (y > s * 1e-12);
+
+    return s;
+}
+
+static double sinc(double x)
+{
+    if (x == 0.0) {
+        return 1.0;
+    }
+
+    return std::sin(M_PI * x) / (M_PI * x);
+}
+
+//! NOTE Independent partial sums let the compiler vectorize the loop, size is a multiple of 4
+static inline float dotProduct(const float* a, const float* b, unsigned int size)
+{
+    float s0 = 0.f;
+    float s1 = 0.f;
+    float s2 = 0.f;
+    float s3 = 0.f;
+
+    for (unsigned int i = 0; i < size; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+
+    return (s0 + s1) + (s2 + s3);
+}
+
 SampleRateConvertor::SampleRateConvertor(const std::vector<float>& data,
                                          unsigned int channelsCount,
                                          unsigned int sampleRateIn,
-                                         unsigned int sampleRateOut)
-    : m_data(data), m_fir(), m_channelsCount(channelsCount), m_sampleRateIn(sampleRateIn), m_sampleRateOut(sampleRateOut)
+                                         unsigned int sampleRateOut,
+                                         Quality quality)
+    : m_data(data), m_channelsCount(channelsCount), m_sampleRateIn(sampleRateIn), m_sampleRateOut(sampleRateOut), m_quality(quality)
 {
-    m_fir.resize(FIR_LENGTH, 0);
-    m_y.resize(FIR_LENGTH, 0);
-    initWindow();
+    initFilterBank();
 }
 
 std::vector<float> SampleRateConvertor::convert()
 {
     std::vector<float> out;
-    auto resultSamples = m_data.size() * m_sampleRateOut / (m_channelsCount * m_sampleRateIn);
+    uint64_t resultSamples = outputFramesCount();
 
     out.resize(resultSamples * m_channelsCount);
-    for (unsigned sample = 0; sample < resultSamples; ++sample) {
-        for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
-            out[sample * m_channelsCount + channel] = y(sample, channel);
-        }
+    if (resultSamples > 0) {
+        process(out.data(), 0, static_cast<unsigned int>(resultSamples));
     }
 
     return out;
@@ -53,29 +113,15 @@ std::vector<float> SampleRateConvertor::convert()
 
 unsigned int SampleRateConvertor::convert(float* buffer, unsigned int from, unsigned int count)
 {
-    unsigned int sample = from;
-    unsigned int converted = 0;
-
-    for (converted = 0; converted < count; ++converted, ++sample) {
-        for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
-            if (!availableSamples(sample)) {
-                return converted;
-            }
-            buffer[converted * m_channelsCount + channel] = y(sample, channel);
-        }
+    uint64_t resultSamples = outputFramesCount();
+    if (from >= resultSamples) {
+        return 0;
     }
-    return converted;
-}
 
-float SampleRateConvertor::y(unsigned int sample, unsigned int channel) const
-{
-    switch (m_method) {
-    case SINC:
-        return ySinc(sample, channel);
-    case FIR:
-        return yFIR(sample, channel);
-    }
-    return 0.f;
+    count = static_cast<unsigned int>(std::min<uint64_t>(count, resultSamples - from));
+    process(buffer, from, count);
+
+    return count;
 }
 
 void SampleRateConvertor::setChannelCount(unsigned int count)
@@ -87,7 +133,7 @@ void SampleRateConvertor::setSampleRateIn(unsigned int sampleRate)
 {
     if (m_sampleRateIn != sampleRate) {
         m_sampleRateIn = sampleRate;
-        initWindow();
+        initFilterBank();
     }
 }
 
@@ -95,116 +141,126 @@ void SampleRateConvertor::setSampleRateOut(unsigned int sampleRate)
 {
     if (m_sampleRateOut != sampleRate) {
         m_sampleRateOut = sampleRate;
-        initWindow();
+        initFilterBank();
     }
 }
 
-float SampleRateConvertor::ySinc(unsigned int sample, unsigned int channel) const
+void SampleRateConvertor::setQuality(Quality quality)
 {
-    double currentOutputSampleTime = sample / static_cast<double>(m_sampleRateOut);
-    auto zeroInputSample = std::floor(currentOutputSampleTime * m_sampleRateIn);
-
-    float out = 0.f;
-    for (unsigned int i = 0; i < USE_SAMPLES; ++i) {
-        int currentSample = zeroInputSample + i - USE_SAMPLES / 2;
-        double currentInputSampleTime = currentSample / static_cast<double>(m_sampleRateIn);
-
-        if (currentSample < 0 || currentSample * m_channelsCount + channel >= m_data.size()) {
-            continue;
-        }
-        out += m_data.at(currentSample * m_channelsCount + channel) * sinc(currentOutputSampleTime - currentInputSampleTime);
+    if (m_quality != quality) {
+        m_quality = quality;
+        initFilterBank();
     }
-    return out;
 }
 
-float SampleRateConvertor::yFIR(unsigned int sample, unsigned int channel) const
+uint64_t SampleRateConvertor::outputFramesCount() const
 {
-    auto x = [this, &channel](int m) -> float {
-        int pos = m * m_M / m_L * m_channelsCount + channel;
-        if (pos >= 0 && pos < static_cast<int>(m_data.size())) {
-            return m_data.at(pos);
-        }
-        return 0.f;
-    };
-
-    float y = 0.f;
-    for (unsigned int i = 0; i < FIR_LENGTH; ++i) {
-        int t = sample - static_cast<int>(i);
-        y += x(t) * m_fir[i];
+    if (m_channelsCount == 0) {
+        return 0;
     }
-    return y;
+
+    uint64_t inputFrames = m_data.size() / m_channelsCount;
+    return inputFrames * m_L / m_M;
 }
 
-bool SampleRateConvertor::availableSamples(unsigned int sample) const
+void SampleRateConvertor::process(float* buffer, uint64_t from, unsigned int count)
 {
-    float currentOutputSampleTime = sample / static_cast<float>(m_sampleRateOut);
-    auto firstInputSample = std::floor(currentOutputSampleTime * m_sampleRateIn) - USE_SAMPLES / 2;
+    if (count == 0 || m_tapsCount == 0) {
+        return;
+    }
 
-    // first sample for conversion points out of the input buffer
-    if (firstInputSample * m_channelsCount >= m_data.size()) {
-        return false;
+    const int64_t inputFrames = static_cast<int64_t>(m_data.size() / m_channelsCount);
+    const int64_t half = m_tapsCount / 2;
+
+    //! NOTE The output frame n is computed from the input frames [pos - half + 1, pos + half], pos = n * M / L
+    const uint64_t firstPos = from * m_M / m_L;
+    const uint64_t lastPos = (from + count - 1) * m_M / m_L;
+    const int64_t windowStart = static_cast<int64_t>(firstPos) - half + 1;
+
+    m_window.resize(static_cast<size_t>(lastPos - firstPos) + m_tapsCount);
+
+    for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
+        for (size_t i = 0; i < m_window.size(); ++i) {
+            int64_t frame = windowStart + static_cast<int64_t>(i);
+            m_window[i] = (frame >= 0 && frame < inputFrames) ? m_data[frame * m_channelsCount + channel] : 0.f;
+        }
+
+        for (unsigned int i = 0; i < count; ++i) {
+            uint64_t position = (from + i) * m_M;
+            const float* input = m_window.data() + (position / m_L - firstPos);
+            buffer[i * m_channelsCount + channel] = filter(input, position % m_L);
+        }
     }
-    return true;
 }
 
-inline double zeroBessel(double x)
+float SampleRateConvertor::filter(const float* input, uint64_t phase) const
 {
-    //return std::cyl_bessel_i(0, x);
+    if (!m_interpolatePhases) {
+        return dotProduct(m_filterBank.data() + phase * m_tapsCount, input, m_tapsCount);
+    }
 
-    double s = 1, y = 1;
-    int m = 1;
+    //! NOTE The phase is between two precomputed phases, interpolate linearly between them
+    double position = static_cast<double>(phase) * m_phasesCount / m_L;
+    size_t phase0 = static_cast<size_t>(position);
+    float t = static_cast<float>(position - phase0);
 
-    while (y > std::numeric_limits<float>::min()) {
-        m += 2;
-        y *= x * x / (4 * m * m);
-        s += s * y;
-    }
+    float y0 = dotProduct(m_filterBank.data() + phase0 * m_tapsCount, input, m_tapsCount);
+    float y1 = dotProduct(m_filterBank.data() + (phase0 + 1) * m_tapsCount, input, m_tapsCount);
 
-    return s;
+    return y0 + (y1 - y0) * t;
 }
 
-void SampleRateConvertor::initWindow()
+void SampleRateConvertor::initFilterBank()
 {
-    int max = std::max(m_sampleRateIn, m_sampleRateOut), min = std::min(m_sampleRateIn, m_sampleRateOut);
-    int maxCommonDivider = 1;
-    while (max % min != 0) {
-        maxCommonDivider = max % min;
-        max = min;
-        min = maxCommonDivider;
-    }
-    m_M = m_sampleRateIn / maxCommonDivider;
-    m_L = m_sampleRateOut / maxCommonDivider;
-    double fStop = std::min(m_sampleRateIn, m_sampleRateOut) / 2,
-           fIntermediateSampleRate = m_sampleRateIn * m_M,
-           attenuation = 96 /*dB*/;
-    int M = FIR_LENGTH;
-    int Np = (M - 1) / 2;
-
-    double alpha = 0.1102 * (attenuation - 8.7);
-    double A[FIR_LENGTH];
-
-    A[0] = 2 * fStop / fIntermediateSampleRate;
-    for (int j = 1; j <= Np; j++) {
-        A[j]  = std::sin(2 * j * M_PI * fStop / fIntermediateSampleRate) / j * M_PI;
+    if (m_sampleRateIn == 0 || m_sampleRateOut == 0) {
+        return;
     }
 
-    for (int j = 0; j <= Np; j++) {
-        m_fir[Np + j]  = A[j];
-        m_fir[Np + j] *= zeroBessel(alpha * std::sqrt(1 - (j * j / (Np * Np))));
-        m_fir[Np + j] /= zeroBessel(alpha);
-    }
+    uint64_t gcd = std::gcd(m_sampleRateIn, m_sampleRateOut);
+    m_L = m_sampleRateOut / gcd;
+    m_M = m_sampleRateIn / gcd;
 
-    for (int j = 0; j < Np; j++) {
-        m_fir[j] = m_fir[M - 1 - j];
-    }
-}
+    const QualityPreset preset = qualityPreset(m_quality);
 
-double SampleRateConvertor::sinc(double value) const
-{
-    if (value == 0) {
-        return 1.f;
+    //! NOTE When downsampling, the cutoff moves to the output Nyquist frequency
+    //! and the filter gets longer to keep the same transition band
+    const double ratio = std::min(1.0, static_cast<double>(m_L) / static_cast<double>(m_M));
+    const double cutoff = ratio * preset.passband;
+
+    m_tapsCount = static_cast<unsigned int>(std::ceil(preset.tapsCount / ratio));
+    m_tapsCount = (m_tapsCount + 3) / 4 * 4;
+
+    m_interpolatePhases = m_L > MAX_PHASES_COUNT;
+    m_phasesCount = m_interpolatePhases ? MAX_PHASES_COUNT : static_cast<unsigned int>(m_L);
+
+    //! NOTE One more phase for the interpolation of the last one
+    const unsigned int banksCount = m_interpolatePhases ? m_phasesCount + 1 : m_phasesCount;
+    m_filterBank.assign(static_cast<size_t>(banksCount) * m_tapsCount, 0.f);
+
+    const double half = m_tapsCount / 2;
+    const double besselBeta = zeroBessel(preset.kaiserBeta);
+
+    for (unsigned int phase = 0; phase < banksCount; ++phase) {
+        const double fraction = static_cast<double>(phase) / m_phasesCount;
+        float* coefficients = m_filterBank.data() + static_cast<size_t>(phase) * m_tapsCount;
+
+        double sum = 0.0;
+        std::vector<double> values(m_tapsCount, 0.0);
+        for (unsigned int tap = 0; tap < m_tapsCount; ++tap) {
+            double t = (tap - half + 1) - fraction;
+            double r = t / half;
+            if (std::abs(r) > 1.0) {
+                continue;
+            }
+
+            double window = zeroBessel(preset.kaiserBeta * std::sqrt(1.0 - r * r)) / besselBeta;
+            values[tap] = cutoff * sinc(cutoff * t) * window;
+            sum += values[tap];
+        }
+
+        //! NOTE Unity gain for every phase
+        for (unsigned int tap = 0; tap < m_tapsCount; ++tap) {
+            coefficients[tap] = static_cast<float>(sum != 0.0 ? values[tap] / sum : 0.0);
+        }
     }
-    double sincArg = M_PI * value * m_sampleRateIn;
-    double gain = std::min(1.0, m_sampleRateOut / static_cast<double>(m_sampleRateIn));
-    return gain * std::sin(sincArg) / sincArg;
 }
@@ -22,57 +22,66 @@
 #ifndef MU_AUDIO_SAMPLERATECONVERTOR_H
 #define MU_AUDIO_SAMPLERATECONVERTOR_H
 
+#include <cstdint>
 #include <vector>
-#include <deque>
+
 namespace mu::audio {
+//! NOTE Polyphase resampler: the output sample at the fractional input position
+//! is a windowed sinc interpolation of the nearest input samples,
+//! the filter coefficients for all the positions are precomputed (filter bank)
 class SampleRateConvertor
 {
 public:
-    enum Method {
-        SINC, FIR
+    enum class Quality {
+        Low,
+        Medium,
+        High
     };
+
     explicit SampleRateConvertor(const std::vector<float>& data, unsigned int channelsCount, unsigned int sampleRateIn,
-                                 unsigned int sampleRateOut);
+                                 unsigned int sampleRateOut, Quality quality = Quality::Medium);
 
     //! offline convert full data set
     std::vector<float> convert();
 
-    //! online convert
+    //! online convert, from and count are frames of the converted data
     unsigned int convert(float* buffer, unsigned int from, unsigned int count);
 
     void setChannelCount(unsigned int count);
     void setSampleRateIn(unsigned int sampleRate);
     void setSampleRateOut(unsigned int sampleRate);
+    void setQuality(Quality quality);
 
 private:
+    //! calculate filter coefficients for all phases
+    void initFilterBank();
 
-    //! return value of sinc function (LPF) with consideration of used sampleRates
-    double sinc(double value) const;
-
-    //! output sample value
-    float y(unsigned int sample, unsigned int channel) const;
-    float ySinc(unsigned int sample, unsigned int channel) const;
-    float yFIR(unsigned int sample, unsigned int channel) const;
+    uint64_t outputFramesCount() const;
 
-    //! return true if there are samples in input buffer for conversion
-    bool availableSamples(unsigned int sample) const;
+    void process(float* buffer, uint64_t from, unsigned int count);
+    float filter(const float* input, uint64_t phase) const;
 
-    //! calculate window function values
-    void initWindow();
+    //! the filter bank is interpolated if the phases count is greater
+    const static unsigned int MAX_PHASES_COUNT = 256;
 
-    const static unsigned int USE_SAMPLES = 16; //!< this value defines the quality and complexity of SRC.
     const std::vector<float>& m_data;
 
-    //! values of window function for USE_SAMPLES
-    const static unsigned int FIR_LENGTH = 33;
-    unsigned int m_M = 1, m_L = 1;
-    std::vector<float> m_fir;
-    mutable std::deque<float> m_y;
+    unsigned int m_channelsCount = 0;
+    unsigned int m_sampleRateIn = 0;
+    unsigned int m_sampleRateOut = 0;
+    Quality m_quality = Quality::Medium;
+
+    //! the output frame n is at the input position n * m_M / m_L
+    uint64_t m_L = 1;
+    uint64_t m_M = 1;
+
+    unsigned int m_tapsCount = 0;
+    unsigned int m_phasesCount = 0;
+    bool m_interpolatePhases = false;
+    std::vector<float> m_filterBank;
 
-    unsigned int m_channelsCount;
-    unsigned int m_sampleRateIn;
-    unsigned int m_sampleRateOut;
-    Method m_method = FIR;
+    //! one channel of the input for the current block, zero padded at the borders
+    std::vector<float> m_window;
 };
 }
 
@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "FLAC++/decoder.h"
+
+#include "audio/internal/encoders/flacencoder.h"
+#include "audio/internal/dsp/audiomathutils.h"
+
+using namespace mu::audio;
+using namespace mu::audio::encode;
+
+class Audio_FlacEncoderTests : public ::testing::Test
+{
+public:
+    struct Decoder : public FLAC::Decoder::File
+    {
+        std::vector<int32_t> samples;
+        unsigned channels = 0;
+        unsigned sampleRate = 0;
+        unsigned bitsPerSample = 0;
+        int errors = 0;
+
+        FLAC__StreamDecoderWriteStatus write_callback(const FLAC__Frame* frame, const FLAC__int32* const buffer[]) override
+        {
+            for (unsigned s = 0; s < frame->header.blocksize; ++s) {
+                for (unsigned ch = 0; ch < frame->header.channels; ++ch) {
+                    samples.push_back(buffer[ch][s]);
+                }
+            }
+
+            return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+        }
+
+        void metadata_callback(const FLAC__StreamMetadata* metadata) override
+        {
+            if (metadata->type == FLAC__METADATA_TYPE_STREAMINFO) {
+                channels = metadata->data.stream_info.channels;
+                sampleRate = metadata->data.stream_info.sample_rate;
+                bitsPerSample = metadata->data.stream_info.bits_per_sample;
+            }
+        }
+
+        void error_callback(FLAC__StreamDecoderErrorStatus) override
+        {
+            ++errors;
+        }
+    };
+};
+
+TEST_F(Audio_FlacEncoderTests, RoundTrip)
+{
+    const std::string path = "flacencoder_roundtrip.flac";
+    const SoundTrackFormat format { SoundTrackType::FLAC, 44100, 2, 0 };
+    const samples_t samplesPerChannel = 10000;
+
+    std::vector<float> samples(samplesPerChannel * 2);
+    for (samples_t s = 0; s < samplesPerChannel; ++s) {
+        samples[2 * s] = 0.5f * std::sin(2.f * static_cast<float>(M_PI) * 440.f * s / 44100.f);
+        samples[2 * s + 1] = 0.25f * std::sin(2.f * static_cast<float>(M_PI) * 660.f * s / 44100.f);
+    }
+
+    {
+        FlacEncoder encoder;
+        ASSERT_TRUE(encoder.init(path, format, samplesPerChannel));
+
+        //! NOTE The samples come in blocks of different sizes, as they do from the sound track writer
+        EXPECT_EQ(encoder.encode(4096, samples.data()), 8192u);
+        EXPECT_EQ(encoder.encode(samplesPerChannel - 4096, samples.data() + 8192), samples.size() - 8192);
+        encoder.flush();
+    }
+
+    Decoder decoder;
+    ASSERT_EQ(decoder.init(path), FLAC__STREAM_DECODER_INIT_STATUS_OK);
+    EXPECT_TRUE(decoder.process_until_end_of_stream());
+    decoder.finish();
+    std::remove(path.c_str());
+
+    EXPECT_EQ(decoder.errors, 0);
+    EXPECT_EQ(decoder.channels, 2u);
+    EXPECT_EQ(decoder.sampleRate, 44100u);
+    EXPECT_EQ(decoder.bitsPerSample, 16u);
+
+    //! NOTE FLAC is lossless, so the decoded data is exactly the 16 bit input
+    ASSERT_EQ(decoder.samples.size(), samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        EXPECT_EQ(decoder.samples[i], dsp::convertFloatSamples<FLAC__int16>(samples[i]));
+    }
+}
@@ -0,0 +1,179 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+
+#include "audio/internal/synthesizers/fluidsynth/fluidenginepool.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+
+class Audio_FluidEnginePoolTests : public ::testing::Test
+{
+public:
+    static constexpr unsigned int SAMPLE_RATE = 44100;
+    static constexpr samples_t BLOCK_SIZE = 512;
+
+    static FluidEnginePool::SlotPtr acquire(FluidEnginePool& pool, size_t channelsCount, int* processedBlocks = nullptr)
+    {
+        return pool.acquire({}, SAMPLE_RATE, channelsCount, [processedBlocks](samples_t) {
+            if (processedBlocks) {
+                ++(*processedBlocks);
+            }
+        });
+    }
+};
+
+TEST_F(Audio_FluidEnginePoolTests, ChannelsOfSharedEngine)
+{
+    FluidEnginePool pool;
+
+    //! NOTE Tracks of 3 and 4 channels take groups of four channels, a track of 2 channels takes a group of two in another engine
+    std::vector<FluidEnginePool::SlotPtr> slots;
+    slots.push_back(acquire(pool, 3));
+    slots.push_back(acquire(pool, 4));
+    slots.push_back(acquire(pool, 2));
+    EXPECT_EQ(pool.enginesCount(), 2u);
+
+    slots.push_back(acquire(pool, 4));
+    slots.push_back(acquire(pool, 3));
+    EXPECT_EQ(pool.enginesCount(), 2u);
+
+    //! NOTE The fifth track with 3-4 channels does not fit into 16 channels
+    slots.push_back(acquire(pool, 4));
+    EXPECT_EQ(pool.enginesCount(), 3u);
+
+    std::map<Fluid*, std::set<int>> usedChannels;
+    for (const FluidEnginePool::SlotPtr& slot : slots) {
+        for (midi::channel_t ch = 0; ch < slot->channelsCount(); ++ch) {
+            int channel = slot->fluidChannel(ch);
+            EXPECT_GE(channel, 0);
+            EXPECT_LT(channel, 16);
+            EXPECT_TRUE(usedChannels[slot->fluid().get()].insert(channel).second);
+        }
+    }
+
+    //! NOTE A track can not have more than 16 channels
+    FluidEnginePool::SlotPtr big = acquire(pool, 20);
+    EXPECT_EQ(big->channelsCount(), 16);
+
+    pool.release(big);
+    for (const FluidEnginePool::SlotPtr& slot : slots) {
+        pool.release(slot);
+    }
+    EXPECT_EQ(pool.enginesCount(), 0u);
+}
+
+TEST_F(Audio_FluidEnginePoolTests, RenderOncePerBlock)
+{
+    FluidEnginePool pool;
+
+    int blocks1 = 0;
+    int blocks2 = 0;
+    FluidEnginePool::SlotPtr slot1 = acquire(pool, 1, &blocks1);
+    FluidEnginePool::SlotPtr slot2 = acquire(pool, 1, &blocks2);
+    ASSERT_EQ(slot1->fluid(), slot2->fluid());
+
+    std::vector<float> buffer(BLOCK_SIZE * 2, 1.f);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(pool.process(slot1, buffer.data(), BLOCK_SIZE), BLOCK_SIZE);
+        EXPECT_EQ(pool.process(slot2, buffer.data(), BLOCK_SIZE), BLOCK_SIZE);
+    }
+
+    //! NOTE Both tracks send their events for every block rendered by the shared engine
+    EXPECT_EQ(blocks1, 10);
+    EXPECT_EQ(blocks2, 10);
+
+    //! NOTE No soundfont, no sound
+    for (float sample : buffer) {
+        EXPECT_NEAR(sample, 0.f, 1e-6f);
+    }
+}
+
+TEST_F(Audio_FluidEnginePoolTests, NewSlotReadsTheNextBlock)
+{
+    FluidEnginePool pool;
+
+    int blocks1 = 0;
+    FluidEnginePool::SlotPtr slot1 = acquire(pool, 1, &blocks1);
+
+    std::vector<float> buffer(BLOCK_SIZE * 2, 1.f);
+    for (int i = 0; i < 3; ++i) {
+        pool.process(slot1, buffer.data(), BLOCK_SIZE);
+    }
+    EXPECT_EQ(blocks1, 3);
+
+    //! NOTE The new slot is processed first: it renders the next block instead of reading the previous one,
+    //! and the other slot reads that block in the same round
+    int blocks2 = 0;
+    FluidEnginePool::SlotPtr slot2 = acquire(pool, 1, &blocks2);
+    ASSERT_EQ(slot1->fluid(), slot2->fluid());
+
+    for (int i = 1; i <= 5; ++i) {
+        pool.process(slot2, buffer.data(), BLOCK_SIZE);
+        EXPECT_EQ(blocks2, i);
+
+        pool.process(slot1, buffer.data(), BLOCK_SIZE);
+        EXPECT_EQ(blocks1, 3 + i);
+    }
+
+    //! NOTE The order of the slots may change from block to block
+    pool.process(slot1, buffer.data(), BLOCK_SIZE);
+    pool.process(slot2, buffer.data(), BLOCK_SIZE);
+    EXPECT_EQ(blocks1, 9);
+    EXPECT_EQ(blocks2, 6);
+}
+
+TEST_F(Audio_FluidEnginePoolTests, EnginesCountForManyTracks)
+{
+    constexpr size_t TRACKS_COUNT = 64;
+
+    auto enginesCount = [](size_t channelsPerTrack) {
+        FluidEnginePool pool;
+        std::vector<FluidEnginePool::SlotPtr> slots;
+        for (size_t i = 0; i < TRACKS_COUNT; ++i) {
+            slots.push_back(acquire(pool, channelsPerTrack));
+        }
+        return pool.enginesCount();
+    };
+
+    //! NOTE A track with 16 channels takes a whole engine, like a separate synth per track,
+    //! tracks with 2 channels share an engine by 8
+    EXPECT_EQ(enginesCount(16), TRACKS_COUNT);
+    EXPECT_EQ(enginesCount(2), TRACKS_COUNT / 8);
+}
+
+TEST_F(Audio_FluidEnginePoolTests, CheckSoundFonts)
+{
+    FluidEnginePool pool;
+
+    //! NOTE No soundfonts, nothing to fail
+    EXPECT_TRUE(pool.checkSoundFonts({}));
+
+    //! NOTE A soundfont that can't be loaded is reported, also when it is checked again
+    EXPECT_FALSE(pool.checkSoundFonts({ "not_existing_soundfont.sf2" }));
+    EXPECT_FALSE(pool.checkSoundFonts({ "not_existing_soundfont.sf2" }));
+    EXPECT_EQ(pool.enginesCount(), 0u);
+}
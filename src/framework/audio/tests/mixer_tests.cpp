@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+#include "audio/internal/worker/mixer.h"
+#include "audio/internal/audiosanitizer.h"
+
+using namespace mu::audio;
+
+class Audio_MixerTests : public ::testing::Test
+{
+public:
+    //! NOTE Fills every sample of the stereo output with the same value
+    class ConstantSource : public AbstractAudioSource
+    {
+    public:
+        ConstantSource(float value)
+            : m_value(value) {}
+
+        unsigned int audioChannelsCount() const override
+        {
+            return 2;
+        }
+
+        samples_t process(float* buffer, samples_t samplesPerChannel) override
+        {
+            std::fill(buffer, buffer + samplesPerChannel * audioChannelsCount(), m_value);
+            return samplesPerChannel;
+        }
+
+    private:
+        float m_value = 0.f;
+    };
+
+    void SetUp() override
+    {
+        //! NOTE The mixer works only on the audio worker thread
+        AudioSanitizer::setupWorkerThread();
+    }
+};
+
+TEST_F(Audio_MixerTests, ChannelOutputTap)
+{
+    const samples_t samplesPerChannel = 64;
+
+    MixerPtr mixer = std::make_shared<Mixer>();
+    mixer->setSampleRate(44100);
+    mixer->setAudioChannelsCount(2);
+
+    ASSERT_TRUE(mixer->addChannel(1, std::make_shared<ConstantSource>(0.2f)).ret);
+    ASSERT_TRUE(mixer->addChannel(2, std::make_shared<ConstantSource>(0.4f)).ret);
+
+    std::map<TrackId, std::vector<float> > tapped;
+    mixer->setChannelOutputTap([&tapped](const TrackId trackId, const float* buffer, samples_t samplesCount) {
+        //! NOTE The buffer is reused for the next channel, so it is copied
+        tapped[trackId].assign(buffer, buffer + samplesCount * 2);
+    });
+
+    std::vector<float> output(samplesPerChannel * 2);
+    EXPECT_EQ(mixer->process(output.data(), samplesPerChannel), samplesPerChannel);
+
+    //! NOTE Every channel gets the default balance gain of its output params, and the master bus gets it again
+    ASSERT_EQ(tapped.size(), 2u);
+    ASSERT_EQ(tapped[1].size(), output.size());
+    ASSERT_EQ(tapped[2].size(), output.size());
+
+    for (size_t i = 0; i < output.size(); ++i) {
+        EXPECT_FLOAT_EQ(tapped[1][i], 0.2f * 0.5f);
+        EXPECT_FLOAT_EQ(tapped[2][i], 0.4f * 0.5f);
+        EXPECT_FLOAT_EQ(output[i], (tapped[1][i] + tapped[2][i]) * 0.5f);
+    }
+
+    //! NOTE Without the tap the output is the same
+    mixer->setChannelOutputTap(nullptr);
+    tapped.clear();
+
+    std::vector<float> untappedOutput(samplesPerChannel * 2);
+    EXPECT_EQ(mixer->process(untappedOutput.data(), samplesPerChannel), samplesPerChannel);
+    EXPECT_TRUE(tapped.empty());
+    EXPECT_EQ(untappedOutput, output);
+}
@@ -0,0 +1,128 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "lame.h"
+
+#include "audio/internal/encoders/mp3encoder.h"
+
+using namespace mu::audio;
+using namespace mu::audio::encode;
+
+class Audio_Mp3EncoderTests : public ::testing::Test
+{
+public:
+    struct Decoded {
+        std::vector<short> left;
+        std::vector<short> right;
+        int channels = 0;
+        int sampleRate = 0;
+    };
+
+    static Decoded decode(const std::string& path)
+    {
+        std::ifstream file(path, std::ios_base::binary);
+        std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        Decoded result;
+        hip_t hip = hip_decode_init();
+
+        std::vector<short> left(1152 * 2);
+        std::vector<short> right(1152 * 2);
+        mp3data_struct mp3data {};
+
+        //! NOTE The whole stream goes in with the first call, it only parses the header of the first frame.
+        //! The next calls return the buffered frames one by one
+        hip_decode1_headers(hip, data.data(), data.size(), left.data(), right.data(), &mp3data);
+
+        int samples = 0;
+        while ((samples = hip_decode1_headers(hip, nullptr, 0, left.data(), right.data(), &mp3data)) > 0) {
+            result.left.insert(result.left.end(), left.begin(), left.begin() + samples);
+            result.right.insert(result.right.end(), right.begin(), right.begin() + samples);
+        }
+
+        if (mp3data.header_parsed) {
+            result.channels = mp3data.stereo;
+            result.sampleRate = mp3data.samplerate;
+        }
+
+        hip_decode_exit(hip);
+
+        return result;
+    }
+
+    static float rms(const std::vector<short>& samples, size_t from, size_t to)
+    {
+        double sum = 0.0;
+        for (size_t i = from; i < to; ++i) {
+            double value = samples[i] / 32768.0;
+            sum += value * value;
+        }
+
+        return static_cast<float>(std::sqrt(sum / (to - from)));
+    }
+};
+
+TEST_F(Audio_Mp3EncoderTests, RoundTrip)
+{
+    const std::string path = "mp3encoder_roundtrip.mp3";
+    const SoundTrackFormat format { SoundTrackType::MP3, 44100, 2, 128 };
+    const samples_t samplesPerChannel = 44100;
+
+    std::vector<float> samples(samplesPerChannel * 2);
+    for (samples_t s = 0; s < samplesPerChannel; ++s) {
+        samples[2 * s] = 0.5f * std::sin(2.f * static_cast<float>(M_PI) * 440.f * s / 44100.f);
+        samples[2 * s + 1] = 0.25f * std::sin(2.f * static_cast<float>(M_PI) * 660.f * s / 44100.f);
+    }
+
+    {
+        Mp3Encoder encoder;
+        ASSERT_TRUE(encoder.init(path, format, samplesPerChannel));
+
+        //! NOTE The samples come in blocks, lame keeps the rest of a frame until the next block or flush()
+        for (samples_t offset = 0; offset < samplesPerChannel; offset += 4096) {
+            samples_t block = std::min<samples_t>(4096, samplesPerChannel - offset);
+            EXPECT_EQ(encoder.encode(block, samples.data() + offset * 2), block * 2);
+        }
+        encoder.flush();
+    }
+
+    Decoded decoded = decode(path);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(decoded.channels, 2);
+    EXPECT_EQ(decoded.sampleRate, 44100);
+
+    //! NOTE The decoded stream also has the encoder delay and the padding of the last frame
+    ASSERT_GE(decoded.left.size(), samplesPerChannel);
+    ASSERT_EQ(decoded.left.size(), decoded.right.size());
+
+    //! NOTE MP3 is lossy, so compare the level of each channel away from the edges
+    EXPECT_NEAR(rms(decoded.left, 4410, 39690), 0.5f / std::sqrt(2.f), 0.02f);
+    EXPECT_NEAR(rms(decoded.right, 4410, 39690), 0.25f / std::sqrt(2.f), 0.02f);
+}
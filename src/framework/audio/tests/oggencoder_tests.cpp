@@ -0,0 +1,153 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "opus.h"
+
+#include "audio/internal/encoders/oggencoder.h"
+
+using namespace mu::audio;
+using namespace mu::audio::encode;
+
+class Audio_OggEncoderTests : public ::testing::Test
+{
+public:
+    using Packet = std::vector<unsigned char>;
+
+    //! NOTE Splits the Ogg pages of the file into the packets of the stream, see RFC 3533
+    static std::vector<Packet> readPackets(const std::string& path)
+    {
+        std::ifstream file(path, std::ios_base::binary);
+        std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        std::vector<Packet> packets;
+        Packet packet;
+        size_t pos = 0;
+
+        while (pos + 27 <= data.size()) {
+            if (std::string(reinterpret_cast<const char*>(data.data() + pos), 4) != "OggS") {
+                return {};
+            }
+
+            size_t segmentsCount = data[pos + 26];
+            size_t segmentPos = pos + 27 + segmentsCount;
+
+            for (size_t i = 0; i < segmentsCount; ++i) {
+                size_t segmentSize = data[pos + 27 + i];
+                packet.insert(packet.end(), data.begin() + segmentPos, data.begin() + segmentPos + segmentSize);
+                segmentPos += segmentSize;
+
+                //! NOTE A packet continues in the next segment, maybe of the next page, while the segment is full
+                if (segmentSize < 255) {
+                    packets.push_back(std::move(packet));
+                    packet.clear();
+                }
+            }
+
+            pos = segmentPos;
+        }
+
+        return packets;
+    }
+
+    static float rms(const std::vector<float>& samples, size_t channels, size_t channel, size_t from, size_t to)
+    {
+        double sum = 0.0;
+        for (size_t s = from; s < to; ++s) {
+            double value = samples[s * channels + channel];
+            sum += value * value;
+        }
+
+        return static_cast<float>(std::sqrt(sum / (to - from)));
+    }
+};
+
+TEST_F(Audio_OggEncoderTests, RoundTrip)
+{
+    const std::string path = "oggencoder_roundtrip.opus";
+    const SoundTrackFormat format { SoundTrackType::OGG, 44100, 2, 128 };
+    const samples_t samplesPerChannel = 44100;
+
+    std::vector<float> samples(samplesPerChannel * 2);
+    for (samples_t s = 0; s < samplesPerChannel; ++s) {
+        samples[2 * s] = 0.5f * std::sin(2.f * static_cast<float>(M_PI) * 440.f * s / 44100.f);
+        samples[2 * s + 1] = 0.25f * std::sin(2.f * static_cast<float>(M_PI) * 660.f * s / 44100.f);
+    }
+
+    {
+        OggEncoder encoder;
+        ASSERT_TRUE(encoder.init(path, format, samplesPerChannel));
+
+        //! NOTE The samples come in blocks, the encoder keeps the rest of a frame until the next block or flush()
+        for (samples_t offset = 0; offset < samplesPerChannel; offset += 4096) {
+            samples_t block = std::min<samples_t>(4096, samplesPerChannel - offset);
+            EXPECT_EQ(encoder.encode(block, samples.data() + offset * 2), block * 2);
+        }
+        EXPECT_EQ(encoder.flush(), 1u);
+    }
+
+    std::vector<Packet> packets = readPackets(path);
+    std::remove(path.c_str());
+
+    //! NOTE The identification header, the comment header and at least one audio packet
+    ASSERT_GT(packets.size(), 2u);
+    ASSERT_GE(packets[0].size(), 19u);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(packets[0].data()), 8), "OpusHead");
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(packets[1].data()), 8), "OpusTags");
+
+    const int channels = packets[0][9];
+    const size_t preSkip = packets[0][10] | (packets[0][11] << 8);
+    const uint32_t inputSampleRate = packets[0][12] | (packets[0][13] << 8) | (packets[0][14] << 16) | (packets[0][15] << 24);
+    EXPECT_EQ(channels, 2);
+    EXPECT_EQ(inputSampleRate, 44100u);
+
+    //! NOTE Opus always decodes at 48 kHz, the encoder resamples the input
+    int error = 0;
+    OpusDecoder* decoder = opus_decoder_create(48000, channels, &error);
+    ASSERT_EQ(error, OPUS_OK);
+
+    std::vector<float> decoded;
+    std::vector<float> frame(5760 * channels);
+    for (size_t i = 2; i < packets.size(); ++i) {
+        int frameSamples = opus_decode_float(decoder, packets[i].data(), static_cast<opus_int32>(packets[i].size()),
+                                             frame.data(), 5760, 0);
+        ASSERT_GT(frameSamples, 0);
+        decoded.insert(decoded.end(), frame.begin(), frame.begin() + frameSamples * channels);
+    }
+
+    opus_decoder_destroy(decoder);
+
+    const size_t expectedSamples = samplesPerChannel * 48000 / 44100;
+    ASSERT_GE(decoded.size() / channels, preSkip + expectedSamples);
+
+    //! NOTE Opus is lossy, so compare the level of each channel away from the edges
+    const size_t from = preSkip + expectedSamples / 10;
+    const size_t to = preSkip + expectedSamples * 9 / 10;
+    EXPECT_NEAR(rms(decoded, channels, 0, from, to), 0.5f / std::sqrt(2.f), 0.02f);
+    EXPECT_NEAR(rms(decoded, channels, 1, from, to), 0.25f / std::sqrt(2.f), 0.02f);
+}
@@ -0,0 +1,150 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+
+#include "audio/internal/worker/samplerateconvertor.h"
+
+#include "log.h"
+
+using namespace mu::audio;
+
+class Audio_SampleRateConvertorTests : public ::testing::Test
+{
+public:
+    static std::vector<float> sine(double frequency, unsigned int sampleRate, size_t frames, unsigned int channels)
+    {
+        std::vector<float> data(frames * channels);
+        for (size_t i = 0; i < frames; ++i) {
+            float value = static_cast<float>(0.5 * std::sin(2.0 * M_PI * frequency * i / sampleRate));
+            for (unsigned int c = 0; c < channels; ++c) {
+                // the second channel is inverted, to check that the channels are not mixed
+                data[i * channels + c] = c % 2 ? -value : value;
+            }
+        }
+        return data;
+    }
+
+    //! signal to noise ratio of the converted sine against the exact one, without the borders
+    static double snr(const std::vector<float>& converted, const std::vector<float>& reference, unsigned int channels)
+    {
+        const size_t frames = std::min(converted.size(), reference.size()) / channels;
+        const size_t border = 256;
+
+        double signal = 0.0;
+        double noise = 0.0;
+        for (size_t i = border; i + border < frames; ++i) {
+            for (unsigned int c = 0; c < channels; ++c) {
+                double ref = reference[i * channels + c];
+                double diff = converted[i * channels + c] - ref;
+                signal += ref * ref;
+                noise += diff * diff;
+            }
+        }
+
+        return 10.0 * std::log10(signal / std::max(noise, 1e-30));
+    }
+};
+
+TEST_F(Audio_SampleRateConvertorTests, Accuracy)
+{
+    struct Case {
+        unsigned int rateIn;
+        unsigned int rateOut;
+        SampleRateConvertor::Quality quality;
+        double minSnr;
+    };
+
+    const std::vector<Case> cases {
+        { 44100, 48000, SampleRateConvertor::Quality::Low, 40.0 },
+        { 44100, 48000, SampleRateConvertor::Quality::Medium, 60.0 },
+        { 44100, 48000, SampleRateConvertor::Quality::High, 75.0 },
+        { 48000, 44100, SampleRateConvertor::Quality::Medium, 60.0 },
+        { 22050, 48000, SampleRateConvertor::Quality::Medium, 60.0 },
+        { 96000, 44100, SampleRateConvertor::Quality::Medium, 60.0 },
+        { 44100, 47999, SampleRateConvertor::Quality::Medium, 55.0 }, // interpolated filter bank
+    };
+
+    const double frequency = 1000.0;
+    const unsigned int channels = 2;
+
+    for (const Case& c : cases) {
+        std::vector<float> input = sine(frequency, c.rateIn, c.rateIn / 2, channels);
+
+        SampleRateConvertor src(input, channels, c.rateIn, c.rateOut, c.quality);
+        std::vector<float> output = src.convert();
+
+        EXPECT_EQ(output.size() / channels, input.size() / channels * c.rateOut / c.rateIn);
+
+        std::vector<float> reference = sine(frequency, c.rateOut, output.size() / channels, channels);
+        double result = snr(output, reference, channels);
+
+        LOGI() << c.rateIn << " -> " << c.rateOut << ", quality: " << int(c.quality) << ", snr: " << result << " dB";
+        EXPECT_GT(result, c.minSnr) << c.rateIn << " -> " << c.rateOut;
+    }
+}
+
+TEST_F(Audio_SampleRateConvertorTests, BlocksMatchFullConversion)
+{
+    const unsigned int channels = 2;
+    std::vector<float> input = sine(440.0, 44100, 20000, channels);
+
+    SampleRateConvertor src(input, channels, 44100, 48000);
+    std::vector<float> full = src.convert();
+
+    std::vector<float> blocks(full.size());
+    const unsigned int blockSize = 512;
+    unsigned int from = 0;
+    while (unsigned int converted = src.convert(blocks.data() + from * channels, from, blockSize)) {
+        from += converted;
+    }
+
+    EXPECT_EQ(from, full.size() / channels);
+    for (size_t i = 0; i < full.size(); ++i) {
+        ASSERT_FLOAT_EQ(blocks[i], full[i]) << i;
+    }
+}
+
+TEST_F(Audio_SampleRateConvertorTests, Throughput)
+{
+    const unsigned int channels = 2;
+    const unsigned int seconds = 10;
+    std::vector<float> input = sine(1000.0, 44100, 44100 * seconds, channels);
+
+    for (SampleRateConvertor::Quality quality : { SampleRateConvertor::Quality::Low,
+                                                  SampleRateConvertor::Quality::Medium,
+                                                  SampleRateConvertor::Quality::High }) {
+        SampleRateConvertor src(input, channels, 44100, 48000, quality);
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<float> output = src.convert();
+        auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        EXPECT_FALSE(output.empty());
+
+        double realtime = seconds * 1e6 / std::max<int64_t>(elapsedUs, 1);
+        LOGI() << "quality: " << int(quality) << ", " << seconds << " s stereo 44100 -> 48000: " << elapsedUs << " us"
+               << " (x" << realtime << " realtime)";
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "audio/internal/encoders/wavencoder.h"
+
+using namespace mu::audio;
+using namespace mu::audio::encode;
+
+class Audio_WavEncoderTests : public ::testing::Test
+{
+public:
+    static std::vector<char> readFile(const std::string& path)
+    {
+        std::ifstream file(path, std::ios_base::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    template<typename T>
+    static T value(const std::vector<char>& data, size_t offset)
+    {
+        T v;
+        std::memcpy(&v, data.data() + offset, sizeof(T));
+        return v;
+    }
+};
+
+TEST_F(Audio_WavEncoderTests, StreamedBlocks)
+{
+    const std::string path = "wavencoder_streamed.wav";
+    const SoundTrackFormat format { SoundTrackType::WAV, 44100, 2, 0 };
+
+    std::vector<float> samples(2 * 1000);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = static_cast<float>(i) / samples.size();
+    }
+
+    {
+        WavEncoder encoder;
+        ASSERT_TRUE(encoder.init(path, format, 1000));
+
+        //! NOTE The samples come in blocks, the length of the data is written by flush()
+        EXPECT_EQ(encoder.encode(600, samples.data()), 1200);
+        EXPECT_EQ(encoder.encode(400, samples.data() + 1200), 800);
+        encoder.flush();
+    }
+
+    std::vector<char> data = readFile(path);
+    std::remove(path.c_str());
+
+    const size_t headerSize = 46;
+    const size_t dataSize = samples.size() * sizeof(float);
+    ASSERT_EQ(data.size(), headerSize + dataSize);
+
+    EXPECT_EQ(std::string(data.data(), 4), "RIFF");
+    EXPECT_EQ(value<uint32_t>(data, 4), data.size() - 8);
+    EXPECT_EQ(std::string(data.data() + 38, 4), "data");
+    EXPECT_EQ(value<uint32_t>(data, 42), dataSize);
+
+    for (size_t i = 0; i < samples.size(); ++i) {
+        EXPECT_FLOAT_EQ(value<float>(data, headerSize + i * sizeof(float)), samples[i]);
+    }
+}
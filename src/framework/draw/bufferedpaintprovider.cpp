@@ -21,6 +21,8 @@
  */
 #include "bufferedpaintprovider.h"
 
+#include <iterator>
+
 #include "utils/drawlogger.h"
 #include "log.h"
 #include "config.h"
@@ -107,8 +109,34 @@ const DrawData::State& BufferedPaintProvider::currentState() const
     return currentData().state;
 }
 
-DrawData::Data& BufferedPaintProvider::editableData()
+//! NOTE A data is painted kind by kind (see PrimitiveKind), so if a primitive is drawn
+//! after primitives of a later kind, a new data is started to keep the painting order
+DrawData::Data& BufferedPaintProvider::editableData(PrimitiveKind kind)
 {
+    DrawData::Data& data = m_currentObjects.top().datas.back();
+    const size_t counts[] = {
+        data.paths.size(),
+        data.polygons.size(),
+        data.texts.size(),
+        data.rectTexts.size(),
+        data.pixmaps.size(),
+        data.tiledPixmap.size()
+    };
+
+    bool hasLaterKind = false;
+    for (size_t k = static_cast<size_t>(kind) + 1; k < std::size(counts); ++k) {
+        hasLaterKind = hasLaterKind || counts[k] > 0;
+    }
+
+    if (!hasLaterKind) {
+        return data;
+    }
+
+    {
+        DrawData::Data newData;
+        newData.state = data.state;
+        m_currentObjects.top().datas.push_back(std::move(newData));
+    }
     return m_currentObjects.top().datas.back();
 }
 
@@ -174,10 +202,18 @@ const Brush& BufferedPaintProvider::brush() const
 
 void BufferedPaintProvider::save()
 {
+    m_savedStates.push(currentState());
 }
 
 void BufferedPaintProvider::restore()
 {
+    if (m_savedStates.empty()) {
+        return;
+    }
+
+    DrawData::State st = m_savedStates.top();
+    m_savedStates.pop();
+    editableState() = std::move(st);
 }
 
 void BufferedPaintProvider::setTransform(const Transform& transform)
@@ -202,7 +238,7 @@ void BufferedPaintProvider::drawPath(const PainterPath& path)
     } else if (st.brush.style() == BrushStyle::NoBrush) {
         mode = DrawMode::Stroke;
     }
-    editableData().paths.push_back({ path, st.pen, st.brush, mode });
+    editableData(PrimitiveKind::Path).paths.push_back({ path, st.pen, st.brush, mode });
 }
 
 void BufferedPaintProvider::drawPolygon(const PointF* points, size_t pointCount, PolygonMode mode)
@@ -211,17 +247,17 @@ void BufferedPaintProvider::drawPolygon(const PointF* points, size_t pointCount,
     for (size_t i = 0; i < pointCount; ++i) {
         pol[i] = PointF(points[i].x(), points[i].y());
     }
-    editableData().polygons.push_back(DrawPolygon { pol, mode });
+    editableData(PrimitiveKind::Polygon).polygons.push_back(DrawPolygon { pol, mode });
 }
 
 void BufferedPaintProvider::drawText(const PointF& point, const String& text)
 {
-    editableData().texts.push_back(DrawText { point, text });
+    editableData(PrimitiveKind::Text).texts.push_back(DrawText { point, text });
 }
 
 void BufferedPaintProvider::drawText(const RectF& rect, int flags, const String& text)
 {
-    editableData().rectTexts.push_back(DrawRectText { rect, flags, text });
+    editableData(PrimitiveKind::RectText).rectTexts.push_back(DrawRectText { rect, flags, text });
 }
 
 void BufferedPaintProvider::drawTextWorkaround(const Font& f, const PointF& pos, const String& text)
@@ -237,23 +273,23 @@ void BufferedPaintProvider::drawSymbol(const PointF& point, char32_t ucs4Code)
 
 void BufferedPaintProvider::drawPixmap(const PointF& p, const Pixmap& pm)
 {
-    editableData().pixmaps.push_back(DrawPixmap { p, pm });
+    editableData(PrimitiveKind::Pixmap).pixmaps.push_back(DrawPixmap { p, pm });
 }
 
 void BufferedPaintProvider::drawTiledPixmap(const RectF& rect, const Pixmap& pm, const PointF& offset)
 {
-    editableData().tiledPixmap.push_back(DrawTiledPixmap { rect, pm, offset });
+    editableData(PrimitiveKind::TiledPixmap).tiledPixmap.push_back(DrawTiledPixmap { rect, pm, offset });
 }
 
 #ifndef NO_QT_SUPPORT
 void BufferedPaintProvider::drawPixmap(const PointF& p, const QPixmap& pm)
 {
-    editableData().pixmaps.push_back(DrawPixmap { p, Pixmap::fromQPixmap(pm) });
+    editableData(PrimitiveKind::Pixmap).pixmaps.push_back(DrawPixmap { p, Pixmap::fromQPixmap(pm) });
 }
 
 void BufferedPaintProvider::drawTiledPixmap(const RectF& rect, const QPixmap& pm, const PointF& offset)
 {
-    editableData().tiledPixmap.push_back(DrawTiledPixmap { rect, Pixmap::fromQPixmap(pm), offset });
+    editableData(PrimitiveKind::TiledPixmap).tiledPixmap.push_back(DrawTiledPixmap { rect, Pixmap::fromQPixmap(pm), offset });
 }
 
 #endif
@@ -278,4 +314,5 @@ void BufferedPaintProvider::clear()
     m_buf = DrawData();
     std::stack<DrawData::Object> empty;
     m_currentObjects.swap(empty);
+    m_savedStates = std::stack<DrawData::State>();
 }
@@ -93,14 +93,25 @@ public:
 
 private:
 
+    //! NOTE The order of the kinds is the order in which a data is painted
+    enum class PrimitiveKind {
+        Path = 0,
+        Polygon,
+        Text,
+        RectText,
+        Pixmap,
+        TiledPixmap
+    };
+
     const DrawData::Data& currentData() const;
-    DrawData::Data& editableData();
+    DrawData::Data& editableData(PrimitiveKind kind);
 
     const DrawData::State& currentState() const;
     DrawData::State& editableState();
 
     DrawData m_buf;
     std::stack<DrawData::Object> m_currentObjects;
+    std::stack<DrawData::State> m_savedStates;
     bool m_isActive = false;
     DrawObjectsLogger* m_drawObjectsLogger = nullptr;
 };
@@ -34,6 +34,7 @@ bool Font::operator ==(const Font& other) const
 {
     return m_family == other.m_family
            && RealIsEqual(m_pointSizeF, other.m_pointSizeF)
+           && m_pixelSize == other.m_pixelSize
            && m_weight == other.m_weight
            && m_style == other.m_style
            && m_noFontMerging == other.m_noFontMerging
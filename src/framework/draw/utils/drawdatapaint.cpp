@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "drawdatapaint.h"
+
+#include "../painter.h"
+
+using namespace mu;
+using namespace mu::draw;
+
+static void paintPolygon(Painter& painter, const DrawPolygon& polygon)
+{
+    switch (polygon.mode) {
+    case PolygonMode::OddEven:
+        painter.drawPolygon(polygon.polygon, FillRule::OddEvenFill);
+        break;
+    case PolygonMode::Winding:
+        painter.drawPolygon(polygon.polygon, FillRule::WindingFill);
+        break;
+    case PolygonMode::Convex:
+        painter.drawConvexPolygon(polygon.polygon);
+        break;
+    case PolygonMode::Polyline:
+        painter.drawPolyline(polygon.polygon);
+        break;
+    }
+}
+
+void DrawDataPaint::paint(Painter& painter, const DrawData& data)
+{
+    for (const DrawData::Object& obj : data.objects) {
+        paint(painter, obj);
+    }
+}
+
+void DrawDataPaint::paint(Painter& painter, const DrawData::Object& obj)
+{
+    if (obj.datas.empty()) {
+        return;
+    }
+
+    const Transform baseTransform = painter.worldTransform();
+
+    painter.save();
+
+    for (const DrawData::Data& data : obj.datas) {
+        const DrawData::State& st = data.state;
+        painter.setAntialiasing(st.isAntialiasing);
+        painter.setCompositionMode(st.compositionMode);
+        painter.setFont(st.font);
+        painter.setWorldTransform(st.transform * baseTransform);
+
+        for (const DrawPath& path : data.paths) {
+            painter.setPen(path.mode == DrawMode::Fill ? Pen(PenStyle::NoPen) : path.pen);
+            painter.setBrush(path.mode == DrawMode::Stroke ? Brush(BrushStyle::NoBrush) : path.brush);
+            painter.drawPath(path.path);
+        }
+
+        painter.setPen(st.pen);
+        painter.setBrush(st.brush);
+
+        for (const DrawPolygon& polygon : data.polygons) {
+            paintPolygon(painter, polygon);
+        }
+
+        for (const DrawText& text : data.texts) {
+            painter.drawText(text.pos, text.text);
+        }
+
+        for (const DrawRectText& text : data.rectTexts) {
+            painter.drawText(text.rect, text.flags, text.text);
+        }
+
+        for (const DrawPixmap& pixmap : data.pixmaps) {
+            painter.drawPixmap(pixmap.pos, pixmap.pm);
+        }
+
+        for (const DrawTiledPixmap& pixmap : data.tiledPixmap) {
+            painter.drawTiledPixmap(pixmap.rect, pixmap.pm, pixmap.offset);
+        }
+    }
+
+    painter.restore();
+    painter.setWorldTransform(baseTransform);
+}
@@ -126,21 +126,31 @@ void ObjectAllocator::cleanup()
         }
     }
 
-    for (size_t bi = 0; bi < m_blocks.size(); ++bi) {
-        const Block& b = m_blocks.at(bi);
+    // Destroy the objects first, the chunks are chained again only afterwards:
+    // a destructor may delete other objects of this allocator, they are pushed
+    // to the free list and must not be destroyed a second time
+    for (const Block& b : m_blocks) {
         Chunk* chunk = b.begin;
-        for (size_t i = 0; i < b.chunkCount - 1; ++i) {
-            // if not free chunk, then destroy object
+        for (size_t i = 0; i < b.chunkCount; ++i) {
             if (freeChunks.find(chunk) == freeChunks.cend()) {
+                Chunk* head = m_free;
                 m_dtor(reinterpret_cast<void*>(chunk));
+
+                for (Chunk* free = m_free; free && free != head; free = free->next) {
+                    freeChunks.insert(free);
+                }
             }
 
-            chunk->next = reinterpret_cast<Chunk*>(reinterpret_cast<uint8_t*>(chunk) + b.chunkSize);
-            chunk = chunk->next;
+            chunk = reinterpret_cast<Chunk*>(reinterpret_cast<uint8_t*>(chunk) + b.chunkSize);
         }
+    }
 
-        if (freeChunks.find(chunk) == freeChunks.cend()) {
-            m_dtor(reinterpret_cast<void*>(chunk));
+    for (size_t bi = 0; bi < m_blocks.size(); ++bi) {
+        const Block& b = m_blocks.at(bi);
+        Chunk* chunk = b.begin;
+        for (size_t i = 0; i < b.chunkCount - 1; ++i) {
+            chunk->next = reinterpret_cast<Chunk*>(reinterpret_cast<uint8_t*>(chunk) + b.chunkSize);
+            chunk = chunk->next;
         }
 
         if (bi < (m_blocks.size() - 1)) {
@@ -20,15 +20,19 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "textstream.h"
+
+#include <charconv>
+#include <cstring>
 #include <sstream>
 
 using namespace mu;
 
-static constexpr int TEXTSTREAM_BUFFERSIZE = 16384;
+static constexpr size_t TEXTSTREAM_BUFFERSIZE = 16384;
 
 TextStream::TextStream(io::IODevice* device)
     : m_device(device)
 {
+    m_buf.reserve(TEXTSTREAM_BUFFERSIZE * 2);
 }
 
 TextStream::~TextStream()
@@ -39,12 +43,15 @@ TextStream::~TextStream()
 void TextStream::setDevice(io::IODevice* device)
 {
     m_device = device;
+    m_buf.reserve(TEXTSTREAM_BUFFERSIZE * 2);
 }
 
 void TextStream::flush()
 {
     if (m_device && m_device->isOpen()) {
-        m_device->write(m_buf);
+        if (!m_buf.empty()) {
+            m_device->write(m_buf.data(), m_buf.size());
+        }
         m_buf.clear();
     }
 }
@@ -55,59 +62,67 @@ TextStream& TextStream::operator<<(char ch)
     return *this;
 }
 
+template<typename T>
+void TextStream::writeInteger(T val)
+{
+    char buf[24];
+    std::to_chars_result res = std::to_chars(buf, buf + sizeof(buf), val);
+    write(buf, static_cast<size_t>(res.ptr - buf));
+}
+
 TextStream& TextStream::operator<<(int val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    writeInteger(val);
     return *this;
 }
 
 TextStream& TextStream::operator<<(unsigned int val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    writeInteger(val);
     return *this;
 }
 
+//! NOTE The output must stay the same as of `std::ostream << double` (`%g` with precision 6).
+//! libc++ marks floating point std::to_chars unavailable on older macOS targets,
+//! there and where it is missing a reused stream is the fallback
 TextStream& TextStream::operator<<(double val)
 {
-    std::stringstream ss;
+#if defined(__cpp_lib_to_chars) && !defined(_LIBCPP_VERSION)
+    char buf[32];
+    std::to_chars_result res = std::to_chars(buf, buf + sizeof(buf), val, std::chars_format::general, 6);
+    write(buf, static_cast<size_t>(res.ptr - buf));
+#else
+    thread_local std::ostringstream ss;
+    ss.str(std::string());
+    ss.clear();
     ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    const std::string str = ss.str();
+    write(str.c_str(), str.size());
+#endif
     return *this;
 }
 
 TextStream& TextStream::operator<<(signed long int val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    writeInteger(val);
     return *this;
 }
 
 TextStream& TextStream::operator<<(unsigned long int val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    writeInteger(val);
     return *this;
 }
 
 TextStream& TextStream::operator<<(signed long long val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    writeInteger(val);
     return *this;
 }
 
 TextStream& TextStream::operator<<(unsigned long long val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    writeInteger(val);
     return *this;
 }
 
@@ -147,14 +162,38 @@ TextStream& TextStream::operator<<(const AsciiStringView& s)
 
 TextStream& TextStream::operator<<(const String& s)
 {
-    ByteArray b = s.toUtf8();
-    write(reinterpret_cast<const char*>(b.constData()), b.size());
+    // ASCII strings (names, most values) are written without the UTF-8 conversion
+    const size_t size = s.size();
+    const size_t start = m_buf.size();
+    m_buf.resize(start + size);
+    for (size_t i = 0; i < size; ++i) {
+        const char16_t c = s.at(i).unicode();
+        if (c >= 0x80) {
+            m_buf.resize(start);
+            ByteArray b = s.toUtf8();
+            write(reinterpret_cast<const char*>(b.constData()), b.size());
+            return *this;
+        }
+        m_buf[start + i] = static_cast<uint8_t>(c);
+    }
+
+    if (m_device && m_buf.size() > TEXTSTREAM_BUFFERSIZE) {
+        flush();
+    }
     return *this;
 }
 
 void TextStream::write(const char* ch, size_t len)
 {
-    m_buf.push_back(reinterpret_cast<const uint8_t*>(ch), len);
+    m_buf.insert(m_buf.end(), reinterpret_cast<const uint8_t*>(ch), reinterpret_cast<const uint8_t*>(ch) + len);
+    if (m_device && m_buf.size() > TEXTSTREAM_BUFFERSIZE) {
+        flush();
+    }
+}
+
+void TextStream::writeRepeated(char ch, size_t count)
+{
+    m_buf.insert(m_buf.end(), count, static_cast<uint8_t>(ch));
     if (m_device && m_buf.size() > TEXTSTREAM_BUFFERSIZE) {
         flush();
     }
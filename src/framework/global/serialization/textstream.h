@@ -22,6 +22,8 @@
 #ifndef MU_GLOBAL_TEXTSTREAM_H
 #define MU_GLOBAL_TEXTSTREAM_H
 
+#include <vector>
+
 #include "io/iodevice.h"
 #include "types/bytearray.h"
 #include "types/string.h"
@@ -60,10 +62,15 @@ public:
     TextStream& operator<<(const QString& s);
 #endif
 
-private:
     void write(const char* ch, size_t len);
+    void writeRepeated(char ch, size_t count);
+
+private:
+    template<typename T>
+    void writeInteger(T val);
+
     io::IODevice* m_device = nullptr;
-    ByteArray m_buf;
+    std::vector<uint8_t> m_buf;
 };
 }
 
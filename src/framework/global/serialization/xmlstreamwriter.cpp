@@ -21,6 +21,8 @@
  */
 #include "xmlstreamwriter.h"
 
+#include <cstring>
+
 #include "containers.h"
 #include "textstream.h"
 
@@ -34,10 +36,59 @@ struct XmlStreamWriter::Impl {
 
     void putLevel()
     {
-        size_t level = stack.size();
-        for (size_t i = 0; i < level * 2; ++i) {
-            stream << ' ';
+        stream.writeRepeated(' ', stack.size() * 2);
+    }
+
+    //! NOTE Writes the text escaped as String::toXmlEscaped would do,
+    //! but without the conversion to String when nothing needs escaping
+    void writeEscaped(const char* s, size_t len)
+    {
+        size_t begin = 0;
+        for (size_t i = 0; i < len; ++i) {
+            const unsigned char c = static_cast<unsigned char>(s[i]);
+            const char* replacement = nullptr;
+            switch (c) {
+            case '<': replacement = "&lt;";
+                break;
+            case '>': replacement = "&gt;";
+                break;
+            case '&': replacement = "&amp;";
+                break;
+            case '\"': replacement = "&quot;";
+                break;
+            default:
+                if (c >= 0x80) {
+                    // not ASCII, let String handle the UTF-8
+                    stream.write(s + begin, i - begin);
+                    stream << String::toXmlEscaped(String::fromUtf8(std::string(s + i, len - i).c_str()));
+                    return;
+                }
+                // ignore invalid characters in xml 1.0
+                if (c < 0x20 && c != 0x09 && c != 0x0A && c != 0x0D) {
+                    replacement = "";
+                }
+                break;
+            }
+
+            if (replacement) {
+                stream.write(s + begin, i - begin);
+                stream << replacement;
+                begin = i + 1;
+            }
+        }
+        stream.write(s + begin, len - begin);
+    }
+
+    void writeEscaped(const String& s)
+    {
+        for (size_t i = 0; i < s.size(); ++i) {
+            const char16_t c = s.at(i).unicode();
+            if (c == u'<' || c == u'>' || c == u'&' || c == u'\"' || c < 0x20) {
+                stream << String::toXmlEscaped(s);
+                return;
+            }
         }
+        stream << s;
     }
 };
 
@@ -114,11 +165,15 @@ void XmlStreamWriter::writeValue(const Value& v)
         break;
     case 7: m_impl->stream << std::get<double>(v);
         break;
-    case 8: m_impl->stream << escapeString(AsciiStringView(std::get<const char*>(v)));
-        break;
-    case 9: m_impl->stream << escapeString(std::get<AsciiStringView>(v));
-        break;
-    case 10: m_impl->stream << escapeString(std::get<String>(v));
+    case 8: {
+        const char* str = std::get<const char*>(v);
+        m_impl->writeEscaped(str, std::strlen(str));
+    } break;
+    case 9: {
+        const AsciiStringView& str = std::get<AsciiStringView>(v);
+        m_impl->writeEscaped(str.ascii(), str.size());
+    } break;
+    case 10: m_impl->writeEscaped(std::get<String>(v));
         break;
     default:
         LOGI() << "index: " << v.index();
@@ -160,7 +215,12 @@ void XmlStreamWriter::endElement()
 {
     m_impl->putLevel();
     m_impl->stream << "</" << mu::takeLast(m_impl->stack) << '>' << '\n';
-    flush();
+
+    //! NOTE The stream flushes itself when its buffer is full,
+    //! here only the completed document is pushed to the device
+    if (m_impl->stack.empty()) {
+        flush();
+    }
 }
 
 // <element attr="value" />
@@ -45,6 +45,9 @@ public:
     using Attribute = std::pair<AsciiStringView, Value>;
     using Attributes = std::vector<Attribute>;
 
+    //! NOTE The output is buffered. It is written to the device when the buffer is full,
+    //! when the outermost element is closed, on flush() and when the writer is destroyed.
+    //! So a device that is read while an element is still open must be flushed first
     void setDevice(io::IODevice* dev);
     void flush();
 
@@ -80,6 +80,29 @@ DECLARE_ITEM(3)
 DECLARE_ITEM(8)
 DECLARE_ITEM(13)
 DECLARE_ITEM(131)
+
+class OwnerItem
+{
+    OBJECT_ALLOCATOR(test, OwnerItem)
+
+public:
+    OwnerItem(OwnerItem* child = nullptr)
+        : child(child)
+    {
+    }
+
+    ~OwnerItem()
+    {
+        delete child;
+        destroyedCount++;
+    }
+
+    OwnerItem* child = nullptr;
+
+    static int destroyedCount;
+};
+
+int OwnerItem::destroyedCount = 0;
 }
 
 class Global_AllocatorTests : public ::testing::Test
@@ -202,3 +225,24 @@ TEST_F(Global_AllocatorTests, Many_NewCleanup)
     EXPECT_EQ(info.totalChunks, 12); // DEFAULT_BLOCK_SIZE * 3
     EXPECT_EQ(info.freeChunks, 12);
 }
+
+TEST_F(Global_AllocatorTests, Owner_NewCleanup)
+{
+    //! GIVEN an item that deletes its child when it is destroyed, the child is after it in the block
+    OwnerItem* owner = new OwnerItem();
+    owner->child = new OwnerItem();
+    new OwnerItem();
+
+    ObjectAllocator::Info info = OwnerItem::allocator().stateInfo();
+    EXPECT_EQ(info.usedChunks(), 3);
+
+    //! DO Allocator cleanup
+    OwnerItem::allocator().cleanup();
+
+    //! CHECK The child is destroyed by its owner only
+    EXPECT_EQ(OwnerItem::destroyedCount, 3);
+
+    //! CHECK Allocator state
+    info = OwnerItem::allocator().stateInfo();
+    EXPECT_EQ(info.usedChunks(), 0);
+}
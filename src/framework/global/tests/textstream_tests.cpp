@@ -0,0 +1,202 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+#include "io/buffer.h"
+#include "serialization/textstream.h"
+#include "serialization/xmlstreamwriter.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::io;
+
+class Global_Ser_TextStreamTests : public ::testing::Test
+{
+public:
+};
+
+template<typename T>
+static std::string streamed(const std::vector<T>& values)
+{
+    Buffer buf;
+    buf.open(IODevice::WriteOnly);
+    {
+        TextStream stream(&buf);
+        for (const T& v : values) {
+            stream << v << ' ';
+        }
+    }
+    return std::string(reinterpret_cast<const char*>(buf.data().constData()), buf.data().size());
+}
+
+template<typename T>
+static std::string reference(const std::vector<T>& values)
+{
+    std::ostringstream ss;
+    for (const T& v : values) {
+        ss << v << ' ';
+    }
+    return ss.str();
+}
+
+TEST_F(Global_Ser_TextStreamTests, Numbers_SameAsStdStream)
+{
+    //! GIVEN Values around the interesting ranges of every type
+    std::vector<int> ints = { 0, 1, -1, 9, 10, -10, 123456, std::numeric_limits<int>::min(), std::numeric_limits<int>::max() };
+    std::vector<unsigned int> uints = { 0, 1, 4294967295u };
+    std::vector<long long> longs = { 0, -1, std::numeric_limits<long long>::min(), std::numeric_limits<long long>::max() };
+    std::vector<unsigned long long> ulongs = { 0, std::numeric_limits<unsigned long long>::max() };
+    std::vector<double> doubles = { 0.0, -0.0, 1.0, -1.5, 0.1, 0.5, 1.0 / 3.0, 2.0 / 3.0, 100.0, 123456.0, 1234567.0, 1e-5, 1.5e-7,
+                                    3.14159265358979, 12.3456789, 1e21, -2.5e-300, 0.000123456789 };
+    for (int i = -1000; i <= 1000; ++i) {
+        doubles.push_back(i * 0.037);
+        doubles.push_back(std::pow(10.0, i % 40) * 1.0000005);
+    }
+
+    //! CHECK The output is byte identical to std::ostream
+    EXPECT_EQ(streamed(ints), reference(ints));
+    EXPECT_EQ(streamed(uints), reference(uints));
+    EXPECT_EQ(streamed(longs), reference(longs));
+    EXPECT_EQ(streamed(ulongs), reference(ulongs));
+    EXPECT_EQ(streamed(doubles), reference(doubles));
+}
+
+TEST_F(Global_Ser_TextStreamTests, String_NonAscii)
+{
+    std::vector<String> strings = { String(u"ascii"), String(u"äöü"), String(u"mixed ♭ ♯"), String() };
+
+    std::string ref;
+    for (const String& s : strings) {
+        ByteArray ba = s.toUtf8();
+        ref += std::string(reinterpret_cast<const char*>(ba.constData()), ba.size()) + ' ';
+    }
+
+    EXPECT_EQ(streamed(strings), ref);
+}
+
+TEST_F(Global_Ser_TextStreamTests, Xml_Escaping)
+{
+    //! GIVEN Document with values that need escaping and that don't
+    Buffer buf;
+    buf.open(IODevice::WriteOnly);
+    {
+        XmlStreamWriter xml(&buf);
+        xml.startDocument();
+        xml.startElement("museScore", { { "version", "4.00" } });
+        xml.element("plain", String(u"text"));
+        xml.element("escaped", String(u"a < b & \"c\" > d"));
+        xml.element("ascii", "x<y");
+        xml.element("utf8", "ä&ö");
+        xml.element("numbers", { { "i", 42 }, { "d", 0.5 } }, 1.0 / 3.0);
+        xml.startElement("nested");
+        xml.element("empty");
+        xml.endElement();
+        xml.endElement();
+    }
+
+    std::string ref = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                      "<museScore version=\"4.00\">\n"
+                      "  <plain>text</plain>\n"
+                      "  <escaped>a &lt; b &amp; &quot;c&quot; &gt; d</escaped>\n"
+                      "  <ascii>x&lt;y</ascii>\n"
+                      "  <utf8>ä&amp;ö</utf8>\n"
+                      "  <numbers i=\"42\" d=\"0.5\">0.333333</numbers>\n"
+                      "  <nested>\n"
+                      "    <empty/>\n"
+                      "    </nested>\n"
+                      "  </museScore>\n";
+
+    //! CHECK
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(buf.data().constData()), buf.data().size()), ref);
+}
+
+TEST_F(Global_Ser_TextStreamTests, Xml_Flushing)
+{
+    auto written = [](const Buffer& buf) {
+        return std::string(reinterpret_cast<const char*>(buf.data().constData()), buf.data().size());
+    };
+
+    Buffer buf;
+    buf.open(IODevice::WriteOnly);
+
+    {
+        XmlStreamWriter xml(&buf);
+        xml.startElement("museScore");
+        xml.startElement("Score");
+        xml.element("nested", 1);
+        xml.endElement();
+
+        //! CHECK Closing a nested element doesn't write to the device
+        EXPECT_TRUE(written(buf).empty());
+
+        //! CHECK flush() writes what is buffered, with the document still open
+        xml.flush();
+        EXPECT_EQ(written(buf), "<museScore>\n  <Score>\n    <nested>1</nested>\n    </Score>\n");
+
+        //! CHECK Closing the outermost element writes the document
+        xml.endElement();
+        EXPECT_EQ(written(buf), "<museScore>\n  <Score>\n    <nested>1</nested>\n    </Score>\n  </museScore>\n");
+
+        //! CHECK A document that is left open is written when the writer is destroyed
+        xml.startElement("open");
+        xml.element("value", 2);
+    }
+
+    EXPECT_EQ(written(buf), "<museScore>\n  <Score>\n    <nested>1</nested>\n    </Score>\n  </museScore>\n"
+                            "<open>\n  <value>2</value>\n");
+}
+
+TEST_F(Global_Ser_TextStreamTests, Xml_Throughput)
+{
+    //! GIVEN A document of the size of a large score
+    constexpr int NOTES = 200000;
+
+    Buffer buf;
+    buf.open(IODevice::WriteOnly);
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        XmlStreamWriter xml(&buf);
+        xml.startDocument();
+        xml.startElement("museScore", { { "version", "4.00" } });
+        for (int i = 0; i < NOTES; ++i) {
+            xml.startElement("Note");
+            xml.element("pitch", 60 + i % 12);
+            xml.element("tpc", 14 + i % 7);
+            xml.element("offset", { { "x", i * 0.25 }, { "y", -1.5 } });
+            xml.endElement();
+        }
+        xml.endElement();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    //! CHECK Everything was written
+    EXPECT_GT(buf.data().size(), static_cast<size_t>(NOTES * 50));
+
+    LOGI() << "written " << buf.data().size() << " bytes in " << elapsed << " ms";
+}
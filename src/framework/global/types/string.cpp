@@ -957,10 +957,30 @@ String String::toXmlEscaped(char16_t c)
 String String::toXmlEscaped(const String& s)
 {
     String escaped;
-    escaped.reserve(s.size());
-    for (size_t i = 0; i < s.size(); ++i) {
-        char16_t c = s.at(i).unicode();
-        escaped += toXmlEscaped(c);
+    std::u16string& data = escaped.mutStr();
+    data.reserve(s.size());
+    for (char16_t c : s.constStr()) {
+        switch (c) {
+        case u'<':
+            data += u"&lt;";
+            break;
+        case u'>':
+            data += u"&gt;";
+            break;
+        case u'&':
+            data += u"&amp;";
+            break;
+        case u'\"':
+            data += u"&quot;";
+            break;
+        default:
+            // ignore invalid characters in xml 1.0
+            if ((c < 0x0020 && c != 0x0009 && c != 0x000A && c != 0x000D)) {
+                break;
+            }
+            data += c;
+            break;
+        }
     }
     return escaped;
 }
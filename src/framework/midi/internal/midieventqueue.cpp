@@ -0,0 +1,50 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "midieventqueue.h"
+
+using namespace mu::midi;
+
+bool MidiEventQueue::push(const Item& item)
+{
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) == CAPACITY) {
+        return false;
+    }
+
+    m_items[tail & (CAPACITY - 1)] = item;
+    m_tail.store(tail + 1, std::memory_order_release);
+
+    return true;
+}
+
+bool MidiEventQueue::pop(Item& item)
+{
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    item = m_items[head & (CAPACITY - 1)];
+    m_head.store(head + 1, std::memory_order_release);
+
+    return true;
+}
@@ -0,0 +1,59 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_MIDI_MIDIEVENTQUEUE_H
+#define MU_MIDI_MIDIEVENTQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+
+#include "miditypes.h"
+
+namespace mu::midi {
+//! NOTE Lock-free queue of the received events between a port input thread (the only producer)
+//! and the main thread (the only consumer), the input thread never waits for the main thread
+class MidiEventQueue
+{
+public:
+    struct Item {
+        tick_t tick = 0;
+        Event event;
+        std::chrono::steady_clock::time_point receivedTime;
+    };
+
+    //! NOTE Only from the producer thread, false if the queue is full
+    bool push(const Item& item);
+
+    //! NOTE Only from the consumer thread, false if the queue is empty
+    bool pop(Item& item);
+
+private:
+    static constexpr size_t CAPACITY = 1024;
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "capacity must be a power of two");
+
+    std::array<Item, CAPACITY> m_items;
+    std::atomic<size_t> m_head { 0 };
+    std::atomic<size_t> m_tail { 0 };
+};
+}
+
+#endif // MU_MIDI_MIDIEVENTQUEUE_H
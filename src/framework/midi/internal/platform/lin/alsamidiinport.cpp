@@ -24,6 +24,9 @@
 #include <alsa/asoundlib.h>
 #include <alsa/seq.h>
 #include <alsa/seq_midi_event.h>
+#include <poll.h>
+
+#include "midiinputlatency.h"
 
 #include "midierrors.h"
 #include "stringutils.h"
@@ -39,6 +42,9 @@ struct mu::midi::AlsaMidiInPort::Alsa {
 
 using namespace mu::midi;
 
+//! NOTE Only lets the input thread notice stop(), the events wake it up at once
+static constexpr int POLL_TIMEOUT_MS = 100;
+
 AlsaMidiInPort::~AlsaMidiInPort()
 {
     if (isConnected()) {
@@ -50,6 +56,10 @@ void AlsaMidiInPort::init()
 {
     m_alsa = std::make_shared<Alsa>();
 
+    m_eventsQueued.onNotify(this, [this]() {
+        deliverEvents();
+    });
+
     m_devicesListener.startWithCallback([this]() {
         return availableDevices();
     });
@@ -197,11 +207,12 @@ void AlsaMidiInPort::disconnect()
         return;
     }
 
+    //! NOTE The input thread reads from the sequencer, so it is stopped before closing
+    stop();
+
     snd_seq_disconnect_to(m_alsa->midiIn, 0, m_alsa->client, m_alsa->port);
     snd_seq_close(m_alsa->midiIn);
 
-    stop();
-
     LOGD() << "Disconnected from " << m_deviceID;
 
     m_alsa->client = -1;
@@ -270,78 +281,116 @@ void AlsaMidiInPort::doProcess()
     uint32_t value = 0;
     Event e;
 
-    while (m_running.load() && isConnected()) {
-        snd_seq_event_input(m_alsa->midiIn, &ev);
-
-        auto sleep = []() {
-            std::this_thread::sleep_for(std::chrono::milliseconds(2));
-        };
+    std::vector<pollfd> fds(snd_seq_poll_descriptors_count(m_alsa->midiIn, POLLIN));
+    snd_seq_poll_descriptors(m_alsa->midiIn, fds.data(), static_cast<unsigned int>(fds.size()), POLLIN);
 
-        if (!ev) {
-            sleep();
+    while (m_running.load() && isConnected()) {
+        if (poll(fds.data(), fds.size(), POLL_TIMEOUT_MS) <= 0) {
             continue;
         }
 
-        switch (ev->type) {
-        case SND_SEQ_EVENT_SYSEX:
-        {
-            NOT_SUPPORTED << "event type: SND_SEQ_EVENT_SYSEX";
-            continue;
+        //! NOTE Read all the events that came together (a chord, for example),
+        //! the main thread is woken up once for them
+        bool received = false;
+
+        while (true) {
+            int err = snd_seq_event_input(m_alsa->midiIn, &ev);
+            if (err == -ENOSPC) {
+                LOGW() << "input buffer overrun, events are lost";
+                continue;
+            }
+
+            if (err < 0 || !ev) {
+                break;
+            }
+
+            switch (ev->type) {
+            case SND_SEQ_EVENT_SYSEX:
+            {
+                NOT_SUPPORTED << "event type: SND_SEQ_EVENT_SYSEX";
+                continue;
+            }
+            case SND_SEQ_EVENT_NOTEOFF:
+                data = 0x80
+                       | (ev->data.note.channel & 0x0F)
+                       | ((ev->data.note.note & 0x7F) << 8)
+                       | ((ev->data.note.velocity & 0x7F) << 16);
+                break;
+            case SND_SEQ_EVENT_NOTEON:
+                data = 0x90
+                       | (ev->data.note.channel & 0x0F)
+                       | ((ev->data.note.note & 0x7F) << 8)
+                       | ((ev->data.note.velocity & 0x7F) << 16);
+                break;
+            case SND_SEQ_EVENT_KEYPRESS:
+                data = 0xA0
+                       | (ev->data.note.channel & 0x0F)
+                       | ((ev->data.note.note & 0x7F) << 8)
+                       | ((ev->data.note.velocity & 0x7F) << 16);
+                break;
+            case SND_SEQ_EVENT_CONTROLLER:
+                data = 0xB0
+                       | (ev->data.control.channel & 0x0F)
+                       | ((ev->data.control.param & 0x7F) << 8)
+                       | ((ev->data.control.value & 0x7F) << 16);
+                break;
+            case SND_SEQ_EVENT_PGMCHANGE:
+                data = 0xC0
+                       | (ev->data.control.channel & 0x0F)
+                       | ((ev->data.control.value & 0x7F) << 8);
+                break;
+            case SND_SEQ_EVENT_CHANPRESS:
+                data = 0xD0
+                       | (ev->data.control.channel & 0x0F)
+                       | ((ev->data.control.value & 0x7F) << 8);
+                break;
+            case SND_SEQ_EVENT_PITCHBEND:
+                value = ev->data.control.value + 8192;
+                data = 0xE0
+                       | (ev->data.note.channel & 0x0F)
+                       | ((value & 0x7F) << 8)
+                       | (((value >> 7) & 0x7F) << 16);
+                break;
+            default:
+                NOT_SUPPORTED << "event type: " << ev->type;
+                continue;
+            }
+
+            e = Event::fromMIDI10Package(data);
+
+            e = e.toMIDI20();
+            if (!e) {
+                continue;
+            }
+
+            if (!m_eventsQueue.push({ static_cast<tick_t>(ev->time.tick), e, std::chrono::steady_clock::now() })) {
+                LOGW() << "events queue is full, event is lost";
+                continue;
+            }
+
+            received = true;
         }
-        case SND_SEQ_EVENT_NOTEOFF:
-            data = 0x80
-                   | (ev->data.note.channel & 0x0F)
-                   | ((ev->data.note.note & 0x7F) << 8)
-                   | ((ev->data.note.velocity & 0x7F) << 16);
-            break;
-        case SND_SEQ_EVENT_NOTEON:
-            data = 0x90
-                   | (ev->data.note.channel & 0x0F)
-                   | ((ev->data.note.note & 0x7F) << 8)
-                   | ((ev->data.note.velocity & 0x7F) << 16);
-            break;
-        case SND_SEQ_EVENT_KEYPRESS:
-            data = 0xA0
-                   | (ev->data.note.channel & 0x0F)
-                   | ((ev->data.note.note & 0x7F) << 8)
-                   | ((ev->data.note.velocity & 0x7F) << 16);
-            break;
-        case SND_SEQ_EVENT_CONTROLLER:
-            data = 0xB0
-                   | (ev->data.control.channel & 0x0F)
-                   | ((ev->data.control.param & 0x7F) << 8)
-                   | ((ev->data.control.value & 0x7F) << 16);
-            break;
-        case SND_SEQ_EVENT_PGMCHANGE:
-            data = 0xC0
-                   | (ev->data.control.channel & 0x0F)
-                   | ((ev->data.control.value & 0x7F) << 8);
-            break;
-        case SND_SEQ_EVENT_CHANPRESS:
-            data = 0xD0
-                   | (ev->data.control.channel & 0x0F)
-                   | ((ev->data.control.value & 0x7F) << 8);
-            break;
-        case SND_SEQ_EVENT_PITCHBEND:
-            value = ev->data.control.value + 8192;
-            data = 0xE0
-                   | (ev->data.note.channel & 0x0F)
-                   | ((value & 0x7F) << 8)
-                   | (((value >> 7) & 0x7F) << 16);
-            break;
-        default:
-            NOT_SUPPORTED << "event type: " << ev->type;
-            continue;
+
+        if (received && !m_eventsPending.exchange(true)) {
+            m_eventsQueued.notify();
         }
+    }
+}
+
+void AlsaMidiInPort::deliverEvents()
+{
+    //! NOTE Reset before reading, so that the events queued meanwhile wake up the main thread again
+    m_eventsPending.store(false);
 
-        e = Event::fromMIDI10Package(data);
+    MidiInputLatency* latency = MidiInputLatency::instance();
+    MidiEventQueue::Item item;
 
-        e = e.toMIDI20();
-        if (e) {
-            m_eventReceived.send(static_cast<tick_t>(ev->time.tick), e);
-        }
+    while (m_eventsQueue.pop(item)) {
+        latency->addSample(MidiInputLatency::Stage::Delivered, item.receivedTime);
 
-        sleep();
+        latency->beginEvent(item.receivedTime);
+        m_eventReceived.send(item.tick, item.event);
+        latency->endEvent();
     }
 }
 
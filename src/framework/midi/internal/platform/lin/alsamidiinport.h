@@ -29,6 +29,7 @@
 
 #include "imidiinport.h"
 #include "internal/midideviceslistener.h"
+#include "internal/midieventqueue.h"
 
 namespace mu::midi {
 class AlsaMidiInPort : public IMidiInPort, public async::Asyncable
@@ -56,6 +57,7 @@ private:
 
     static void process(AlsaMidiInPort* self);
     void doProcess();
+    void deliverEvents();
 
     bool deviceExists(const MidiDeviceID& deviceId) const;
 
@@ -72,6 +74,10 @@ private:
     mutable std::mutex m_devicesMutex;
 
     async::Channel<tick_t, Event > m_eventReceived;
+
+    MidiEventQueue m_eventsQueue;
+    std::atomic<bool> m_eventsPending { false };
+    async::Notification m_eventsQueued;
 };
 }
 
@@ -0,0 +1,73 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "midiinputlatency.h"
+
+#include <algorithm>
+
+using namespace mu::midi;
+
+MidiInputLatency* MidiInputLatency::instance()
+{
+    static MidiInputLatency s;
+    return &s;
+}
+
+void MidiInputLatency::beginEvent(Clock::time_point receivedTime)
+{
+    m_eventTime = receivedTime;
+}
+
+void MidiInputLatency::endEvent()
+{
+    m_eventTime.reset();
+}
+
+MidiInputLatency::Clock::time_point MidiInputLatency::eventTime() const
+{
+    return m_eventTime ? m_eventTime.value() : Clock::now();
+}
+
+void MidiInputLatency::addSample(Stage stage, Clock::time_point eventTime)
+{
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - eventTime).count();
+
+    Samples& samples = m_samples[static_cast<size_t>(stage)];
+    ++samples.count;
+    samples.sumMs += ms;
+    samples.maxMs = std::max(samples.maxMs, ms);
+}
+
+MidiInputLatency::Stats MidiInputLatency::stats(Stage stage) const
+{
+    const Samples& samples = m_samples[static_cast<size_t>(stage)];
+
+    Stats s;
+    s.count = samples.count;
+    s.meanMs = samples.count > 0 ? samples.sumMs / samples.count : 0.0;
+    s.maxMs = samples.maxMs;
+    return s;
+}
+
+void MidiInputLatency::clear()
+{
+    m_samples = {};
+}
@@ -0,0 +1,77 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_MIDI_MIDIINPUTLATENCY_H
+#define MU_MIDI_MIDIINPUTLATENCY_H
+
+#include <array>
+#include <chrono>
+#include <optional>
+
+namespace mu::midi {
+//! NOTE Latency of the MIDI input, from the time an event was read from the device
+//! to the time it was handled at each stage. Used on the main thread only
+class MidiInputLatency
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Stage {
+        Delivered = 0,  // the event is handled on the main thread
+        Previewed,      // the note is sent to the audio worker
+        Inserted,       // the note is added to the score
+
+        Count
+    };
+
+    struct Stats {
+        size_t count = 0;
+        double meanMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    static MidiInputLatency* instance();
+
+    //! NOTE A port sets the time the event was read from the device while the event is delivered,
+    //! the events that do not come from a device (the piano keyboard panel) are timed from now
+    void beginEvent(Clock::time_point receivedTime);
+    void endEvent();
+    Clock::time_point eventTime() const;
+
+    void addSample(Stage stage, Clock::time_point eventTime);
+    Stats stats(Stage stage) const;
+    void clear();
+
+private:
+    MidiInputLatency() = default;
+
+    struct Samples {
+        size_t count = 0;
+        double sumMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    std::array<Samples, static_cast<size_t>(Stage::Count)> m_samples;
+    std::optional<Clock::time_point> m_eventTime;
+};
+}
+
+#endif // MU_MIDI_MIDIINPUTLATENCY_H
@@ -0,0 +1,374 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "chunkedupload.h"
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QEventLoop>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+#include <QUrlQuery>
+
+#include "networkerrors.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::network;
+using namespace mu::framework;
+
+static const QByteArray UPLOAD_LENGTH_HEADER("Upload-Length");
+static const QByteArray CONTENT_RANGE_HEADER("Content-Range");
+static const QByteArray CONTENT_ENCODING_HEADER("Content-Encoding");
+
+//! NOTE The zlib stream, what HTTP calls deflate. qCompress adds the uncompressed size in 4 bytes before it
+static QByteArray deflate(const QByteArray& data)
+{
+    QByteArray compressed = qCompress(data);
+    return compressed.size() > 4 ? compressed.mid(4) : QByteArray();
+}
+
+//! NOTE The network manager reports the client errors (except 404) as successful requests,
+//! so a request is only successful when its reply is the expected one.
+//! Such an error is repeated by every retry of the same request
+static Ret invalidReplyError(const std::string& what)
+{
+    Ret ret = make_ret(Err::UnknownError);
+    ret.setText("invalid reply of the upload session: " + what);
+    return ret;
+}
+
+static QByteArray contentHash(QIODevice* source)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!source->seek(0) || !hash.addData(source)) {
+        return QByteArray();
+    }
+
+    return hash.result();
+}
+
+//! NOTE Waits with the event loop running, like the network manager does for a request
+static void wait(int msec)
+{
+    QEventLoop loop;
+    QTimer::singleShot(msec, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+ChunkedUpload::ChunkedUpload(const Options& options)
+    : m_options(options)
+{
+    IF_ASSERT_FAILED(m_options.chunkSize > 0) {
+        m_options.chunkSize = Options().chunkSize;
+    }
+}
+
+void ChunkedUpload::setUrl(const QUrl& url)
+{
+    m_url = url;
+}
+
+void ChunkedUpload::setHeaders(const RequestHeaders& headers)
+{
+    m_headers = headers;
+}
+
+bool ChunkedUpload::hasSession() const
+{
+    return m_session.isValid();
+}
+
+int ChunkedUpload::chunksCount() const
+{
+    return static_cast<int>((m_sessionSize + m_options.chunkSize - 1) / m_options.chunkSize);
+}
+
+Progress ChunkedUpload::progress() const
+{
+    return m_progress;
+}
+
+void ChunkedUpload::abort()
+{
+    m_aborted = true;
+
+    if (m_manager) {
+        m_manager->abort();
+    }
+}
+
+Ret ChunkedUpload::upload(INetworkManagerPtr manager, QIODevice* source, const QByteArray& completeData, IncomingDevice* completeReply)
+{
+    TRACEFUNC;
+
+    IF_ASSERT_FAILED(manager && source) {
+        return make_ret(Err::UnknownError);
+    }
+
+    if (!source->isOpen() && !source->open(QIODevice::ReadOnly)) {
+        return make_ret(Err::FiledOpenIODeviceRead);
+    }
+
+    const int64_t totalSize = source->size();
+    const QByteArray hash = contentHash(source);
+    if (hash.isEmpty()) {
+        return make_ret(Err::FiledOpenIODeviceRead);
+    }
+
+    m_manager = manager;
+    m_aborted = false;
+    m_progress.started.notify();
+
+    Ret ret = make_ok();
+
+    //! NOTE The chunks stored by the server are of the content the session was started for
+    if (hasSession() && (m_sessionSize != totalSize || m_sessionHash != hash)) {
+        resetSession();
+    }
+
+    if (hasSession()) {
+        ret = syncSession();
+
+        //! NOTE The server doesn't know the session anymore, start from zero
+        if (ret.code() == static_cast<int>(Err::ResourceNotFound)) {
+            LOGW() << "upload session expired: " << m_session.toString();
+            resetSession();
+            ret = make_ok();
+        }
+    }
+
+    if (ret && !hasSession()) {
+        ret = startSession(totalSize, hash);
+    }
+
+    if (ret) {
+        ret = uploadChunks(source, totalSize);
+    }
+
+    if (ret) {
+        ret = completeSession(completeData, completeReply);
+    }
+
+    //! NOTE A failed session is kept, the next call resumes it
+    if (ret) {
+        resetSession();
+    }
+
+    m_manager = nullptr;
+
+    m_progress.finished.send(ret);
+    return ret;
+}
+
+QUrl ChunkedUpload::sessionUrl(const QString& subPath) const
+{
+    QUrl url = m_session;
+    if (!subPath.isEmpty()) {
+        url.setPath(url.path() + "/" + subPath);
+    }
+
+    QUrlQuery query(url);
+    for (const auto& item : QUrlQuery(m_url).queryItems()) {
+        query.removeAllQueryItems(item.first);
+        query.addQueryItem(item.first, item.second);
+    }
+    url.setQuery(query);
+
+    return url;
+}
+
+Ret ChunkedUpload::startSession(int64_t totalSize, const QByteArray& contentHash)
+{
+    QByteArray emptyData;
+    QBuffer body(&emptyData);
+    OutgoingDevice device(&body);
+    QBuffer reply;
+
+    RequestHeaders headers = m_headers;
+    headers.knownHeaders[QNetworkRequest::ContentTypeHeader] = QVariant("application/octet-stream");
+    headers.rawHeaders[UPLOAD_LENGTH_HEADER] = QByteArray::number(static_cast<qint64>(totalSize));
+
+    Ret ret = m_manager->post(m_url, &device, &reply, headers);
+    if (!ret) {
+        return ret;
+    }
+
+    QString session = QJsonDocument::fromJson(reply.data()).object().value("session").toString();
+    if (session.isEmpty()) {
+        return invalidReplyError("no session");
+    }
+
+    m_session = m_url.resolved(QUrl(session));
+    m_sessionSize = totalSize;
+    m_sessionHash = contentHash;
+    m_received.clear();
+
+    return make_ok();
+}
+
+Ret ChunkedUpload::syncSession()
+{
+    QBuffer reply;
+    Ret ret = m_manager->get(sessionUrl(), &reply, m_headers);
+    if (!ret) {
+        return ret;
+    }
+
+    QJsonObject status = QJsonDocument::fromJson(reply.data()).object();
+    if (!status.contains("received")) {
+        return invalidReplyError("no received chunks");
+    }
+
+    m_received.clear();
+    for (const QJsonValue& index : status.value("received").toArray()) {
+        m_received.insert(index.toInt());
+    }
+
+    return make_ok();
+}
+
+Ret ChunkedUpload::completeSession(const QByteArray& completeData, IncomingDevice* completeReply)
+{
+    QByteArray data = completeData;
+    QBuffer body(&data);
+    OutgoingDevice device(&body);
+
+    RequestHeaders headers = m_headers;
+    headers.knownHeaders[QNetworkRequest::ContentTypeHeader] = QVariant("application/json");
+
+    return m_manager->post(sessionUrl("complete"), &device, completeReply, headers);
+}
+
+void ChunkedUpload::resetSession()
+{
+    m_session = QUrl();
+    m_sessionSize = 0;
+    m_sessionHash.clear();
+    m_received.clear();
+}
+
+Ret ChunkedUpload::uploadChunks(QIODevice* source, int64_t totalSize)
+{
+    int64_t uploadedBytes = 0;
+    for (int index : m_received) {
+        uploadedBytes += std::min(m_options.chunkSize, totalSize - index * m_options.chunkSize);
+    }
+
+    m_progress.progressChanged.send(uploadedBytes, totalSize, "");
+
+    for (int index = 0; index < chunksCount(); ++index) {
+        if (m_received.find(index) != m_received.end()) {
+            continue;
+        }
+
+        if (m_aborted) {
+            return make_ret(Err::Abort);
+        }
+
+        QByteArray chunk = readChunk(source, index, totalSize);
+        if (chunk.isEmpty()) {
+            return make_ret(Err::FiledOpenIODeviceRead);
+        }
+
+        Ret ret = uploadChunk(index, chunk, totalSize);
+        if (!ret) {
+            return ret;
+        }
+
+        m_received.insert(index);
+        uploadedBytes += chunk.size();
+        m_progress.progressChanged.send(uploadedBytes, totalSize, "");
+    }
+
+    return make_ok();
+}
+
+QByteArray ChunkedUpload::readChunk(QIODevice* source, int index, int64_t totalSize)
+{
+    int64_t pos = index * m_options.chunkSize;
+    if (!source->seek(pos)) {
+        return QByteArray();
+    }
+
+    return source->read(std::min(m_options.chunkSize, totalSize - pos));
+}
+
+Ret ChunkedUpload::uploadChunk(int index, const QByteArray& chunk, int64_t totalSize)
+{
+    QByteArray body = chunk;
+    bool deflated = false;
+    if (m_options.compress) {
+        QByteArray compressed = deflate(chunk);
+        if (!compressed.isEmpty() && compressed.size() < chunk.size()) {
+            body = compressed;
+            deflated = true;
+        }
+    }
+
+    const qint64 first = index * m_options.chunkSize;
+    const qint64 last = first + chunk.size() - 1;
+
+    RequestHeaders headers = m_headers;
+    headers.knownHeaders[QNetworkRequest::ContentTypeHeader] = QVariant("application/octet-stream");
+    headers.rawHeaders[CONTENT_RANGE_HEADER] = QString("bytes %1-%2/%3").arg(first).arg(last).arg(totalSize).toLatin1();
+    if (deflated) {
+        headers.rawHeaders[CONTENT_ENCODING_HEADER] = "deflate";
+    }
+
+    const QUrl url = sessionUrl(QString::number(index));
+
+    Ret ret;
+    int delayMs = m_options.retryDelayMs;
+    for (int attempt = 0; attempt <= m_options.maxRetries; ++attempt) {
+        if (attempt > 0) {
+            LOGW() << "retry chunk: " << index << ", attempt: " << attempt << ", err: " << ret.toString();
+            wait(delayMs);
+            delayMs *= 2;
+        }
+
+        if (m_aborted) {
+            return make_ret(Err::Abort);
+        }
+
+        QBuffer data(&body);
+        OutgoingDevice device(&data);
+        QBuffer reply;
+
+        ret = m_manager->put(url, &device, &reply, headers);
+        if (!ret) {
+            continue;
+        }
+
+        //! NOTE The server answered, but didn't store the chunk
+        QJsonValue received = QJsonDocument::fromJson(reply.data()).object().value("received");
+        if (!received.isDouble() || received.toInt() != index) {
+            return invalidReplyError("chunk " + std::to_string(index) + " is not received");
+        }
+
+        return make_ok();
+    }
+
+    return ret;
+}
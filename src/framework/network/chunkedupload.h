@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NETWORK_CHUNKEDUPLOAD_H
+#define MU_NETWORK_CHUNKEDUPLOAD_H
+
+#include <set>
+
+#include <QUrl>
+
+#include "types/ret.h"
+#include "global/progress.h"
+#include "inetworkmanager.h"
+#include "networktypes.h"
+
+namespace mu::network {
+//! NOTE Uploads a large device in chunks, retrying the failed ones.
+//! If the upload fails, calling upload() again resumes it: only the chunks the server
+//! doesn't have yet are sent. A session is resumed only for the same content (by its hash).
+//! The requests are made one at a time through the given network manager, on the calling thread.
+//! A request the server answers without the expected reply (e.g. a client error) is not retried.
+//!
+//! Protocol:
+//!   POST <url>                    starts a session, header Upload-Length: <total bytes>,
+//!                                 replies {"session": "<session url>"}
+//!   GET <session>                 replies {"received": [<indexes of the stored chunks>]}
+//!   PUT <session>/<index>         a chunk, header Content-Range: bytes <first>-<last>/<total>,
+//!                                 deflated (Content-Encoding: deflate) when that makes it smaller,
+//!                                 replies {"received": <index>}
+//!   POST <session>/complete       assembles the file, the body and the reply are of the caller
+//!
+//! The query of the url (e.g. an access token) is added to all the requests of the session.
+class ChunkedUpload
+{
+public:
+    struct Options
+    {
+        int64_t chunkSize = 1024 * 1024;
+        int maxRetries = 3; // per chunk
+        int retryDelayMs = 500; // doubled on each retry
+        bool compress = true;
+    };
+
+    ChunkedUpload(const Options& options = Options());
+
+    void setUrl(const QUrl& url);
+    void setHeaders(const RequestHeaders& headers);
+
+    Ret upload(INetworkManagerPtr manager, QIODevice* source, const QByteArray& completeData, IncomingDevice* completeReply);
+    void abort();
+
+    bool hasSession() const;
+    int chunksCount() const;
+
+    framework::Progress progress() const;
+
+private:
+    Ret startSession(int64_t totalSize, const QByteArray& contentHash);
+    Ret syncSession();
+    Ret completeSession(const QByteArray& completeData, IncomingDevice* completeReply);
+    void resetSession();
+
+    QUrl sessionUrl(const QString& subPath = QString()) const;
+
+    Ret uploadChunks(QIODevice* source, int64_t totalSize);
+    QByteArray readChunk(QIODevice* source, int index, int64_t totalSize);
+    Ret uploadChunk(int index, const QByteArray& chunk, int64_t totalSize);
+
+    Options m_options;
+    QUrl m_url;
+    RequestHeaders m_headers;
+    INetworkManagerPtr m_manager;
+
+    QUrl m_session;
+    int64_t m_sessionSize = 0;
+    QByteArray m_sessionHash;
+    std::set<int> m_received;
+
+    bool m_aborted = false;
+
+    framework::Progress m_progress;
+};
+}
+
+#endif // MU_NETWORK_CHUNKEDUPLOAD_H
@@ -0,0 +1,224 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <QBuffer>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "network/chunkedupload.h"
+#include "network/internal/networkmanager.h"
+
+#include "uploadstandinserver.h"
+
+using namespace mu;
+using namespace mu::network;
+
+class Network_ChunkedUploadTests : public ::testing::Test
+{
+public:
+    static constexpr int CHUNK_SIZE = 16 * 1024;
+
+    //! NOTE Even chunks are text, odd ones are random bytes, so only the even ones are worth deflating
+    static QByteArray makeData(int chunksCount, int tailSize)
+    {
+        std::mt19937 random(42);
+        QByteArray data;
+        for (int i = 0; i < chunksCount; ++i) {
+            for (int j = 0; j < CHUNK_SIZE; ++j) {
+                data.append(i % 2 == 0 ? char('a' + j % 26) : char(random() & 0xff));
+            }
+        }
+        data.append(QByteArray(tailSize, 'z'));
+        return data;
+    }
+
+    static ChunkedUpload::Options options()
+    {
+        ChunkedUpload::Options opt;
+        opt.chunkSize = CHUNK_SIZE;
+        opt.maxRetries = 2;
+        opt.retryDelayMs = 10;
+        return opt;
+    }
+
+    static INetworkManagerPtr manager()
+    {
+        return std::make_shared<NetworkManager>();
+    }
+};
+
+TEST_F(Network_ChunkedUploadTests, UploadsAllChunks)
+{
+    UploadStandInServer server;
+
+    QByteArray data = makeData(10, 100);
+    QBuffer source(&data);
+
+    ChunkedUpload upload(options());
+    upload.setUrl(server.url());
+
+    int64_t lastProgress = 0;
+    upload.progress().progressChanged.onReceive(nullptr, [&lastProgress](int64_t current, int64_t, const std::string&) {
+        lastProgress = current;
+    });
+
+    QBuffer reply;
+    Ret ret = upload.upload(manager(), &source, "{\"title\": \"test\"}", &reply);
+    ASSERT_TRUE(ret) << ret.toString();
+
+    EXPECT_EQ(server.uploadedData(), data);
+    EXPECT_EQ(server.completeData(), QByteArray("{\"title\": \"test\"}"));
+    EXPECT_EQ(QJsonDocument::fromJson(reply.data()).object().value("permalink").toString(), "https://example.com/score/1");
+
+    UploadStandInServer::Stats stats = server.stats();
+    EXPECT_EQ(stats.chunkRequests, 11);
+    EXPECT_EQ(stats.deflatedChunks, 6); // 5 text chunks and the tail
+    EXPECT_EQ(stats.resentChunks, 0);
+    EXPECT_EQ(stats.completeRequests, 1);
+
+    EXPECT_EQ(lastProgress, data.size());
+    EXPECT_FALSE(upload.hasSession());
+}
+
+TEST_F(Network_ChunkedUploadTests, RetriesFailedChunks)
+{
+    UploadStandInServer server;
+    server.failChunkRequests(2);
+
+    QByteArray data = makeData(4, 0);
+    QBuffer source(&data);
+
+    ChunkedUpload upload(options());
+    upload.setUrl(server.url());
+
+    Ret ret = upload.upload(manager(), &source, QByteArray(), nullptr);
+    ASSERT_TRUE(ret) << ret.toString();
+
+    EXPECT_EQ(server.uploadedData(), data);
+    EXPECT_EQ(server.stats().chunkRequests, 4 + 2);
+}
+
+TEST_F(Network_ChunkedUploadTests, ResumesFailedUpload)
+{
+    UploadStandInServer server;
+
+    QByteArray data = makeData(8, 0);
+    QBuffer source(&data);
+
+    ChunkedUpload::Options opt = options();
+    opt.maxRetries = 0;
+
+    ChunkedUpload upload(opt);
+    upload.setUrl(server.url());
+
+    //! NOTE The fourth chunk fails without retries, the upload stops but keeps its session
+    server.failChunkRequests(1, 3);
+    Ret ret = upload.upload(manager(), &source, QByteArray(), nullptr);
+    EXPECT_FALSE(ret);
+    EXPECT_TRUE(upload.hasSession());
+    EXPECT_EQ(server.stats().completeRequests, 0);
+
+    //! NOTE Resumed, the chunks stored by the server are not sent again
+    ret = upload.upload(manager(), &source, QByteArray(), nullptr);
+    ASSERT_TRUE(ret) << ret.toString();
+
+    EXPECT_EQ(server.uploadedData(), data);
+    EXPECT_EQ(server.stats().resentChunks, 0);
+    EXPECT_EQ(server.stats().chunkRequests, 3 + 1 + 5);
+}
+
+TEST_F(Network_ChunkedUploadTests, RestartsExpiredSession)
+{
+    UploadStandInServer server;
+
+    QByteArray data = makeData(4, 10);
+    QBuffer source(&data);
+
+    ChunkedUpload::Options opt = options();
+    opt.maxRetries = 0;
+
+    ChunkedUpload upload(opt);
+    upload.setUrl(server.url());
+
+    server.failChunkRequests(1);
+    EXPECT_FALSE(upload.upload(manager(), &source, QByteArray(), nullptr));
+    EXPECT_TRUE(upload.hasSession());
+
+    //! NOTE The server forgot the session, the upload starts from zero
+    server.dropSessions();
+    Ret ret = upload.upload(manager(), &source, QByteArray(), nullptr);
+    ASSERT_TRUE(ret) << ret.toString();
+
+    EXPECT_EQ(server.uploadedData(), data);
+}
+
+TEST_F(Network_ChunkedUploadTests, DoesNotRetryClientErrors)
+{
+    UploadStandInServer server;
+    server.failChunkRequests(1, 0, 401);
+
+    QByteArray data = makeData(4, 0);
+    QBuffer source(&data);
+
+    ChunkedUpload::Options opt = options();
+
+    ChunkedUpload upload(opt);
+    upload.setUrl(server.url());
+
+    //! NOTE The expired access token fails the upload at once
+    Ret ret = upload.upload(manager(), &source, QByteArray(), nullptr);
+    EXPECT_FALSE(ret);
+    EXPECT_EQ(server.stats().chunkRequests, 1);
+    EXPECT_EQ(server.stats().completeRequests, 0);
+}
+
+TEST_F(Network_ChunkedUploadTests, RestartsSessionForOtherContent)
+{
+    UploadStandInServer server;
+
+    QByteArray data = makeData(4, 0);
+    QBuffer source(&data);
+
+    ChunkedUpload::Options opt = options();
+    opt.maxRetries = 0;
+
+    ChunkedUpload upload(opt);
+    upload.setUrl(server.url());
+
+    server.failChunkRequests(1, 2);
+    EXPECT_FALSE(upload.upload(manager(), &source, QByteArray(), nullptr));
+    EXPECT_TRUE(upload.hasSession());
+
+    //! NOTE The same size, but other content: the stored chunks must not be reused
+    QByteArray otherData = data;
+    otherData[0] = 'X';
+    QBuffer otherSource(&otherData);
+
+    Ret ret = upload.upload(manager(), &otherSource, QByteArray(), nullptr);
+    ASSERT_TRUE(ret) << ret.toString();
+
+    EXPECT_EQ(server.uploadedData(), otherData);
+    EXPECT_EQ(server.stats().chunkRequests, 2 + 1 + 4);
+}
@@ -0,0 +1,285 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "uploadstandinserver.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+using namespace mu::network;
+
+static const QString UPLOAD_PATH("/upload");
+
+UploadStandInServer::UploadStandInServer()
+{
+    m_context = new QObject();
+    m_context->moveToThread(&m_thread);
+    m_thread.start();
+
+    QMetaObject::invokeMethod(m_context, [this]() {
+        m_server = new QTcpServer(m_context);
+        QObject::connect(m_server, &QTcpServer::newConnection, m_context, [this]() { onNewConnection(); });
+        m_server->listen(QHostAddress::LocalHost, 0);
+        m_port = m_server->serverPort();
+    }, Qt::BlockingQueuedConnection);
+}
+
+UploadStandInServer::~UploadStandInServer()
+{
+    QMetaObject::invokeMethod(m_context, [this]() {
+        qDeleteAll(m_context->children());
+    }, Qt::BlockingQueuedConnection);
+
+    m_thread.quit();
+    m_thread.wait();
+    delete m_context;
+}
+
+QUrl UploadStandInServer::url() const
+{
+    return QUrl(QString("http://127.0.0.1:%1%2").arg(m_port).arg(UPLOAD_PATH));
+}
+
+void UploadStandInServer::failChunkRequests(int count, int skip, int status)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_failChunkRequests = count;
+    m_skipChunkRequests = skip;
+    m_failChunkStatus = status;
+}
+
+void UploadStandInServer::dropSessions()
+{
+    QMetaObject::invokeMethod(m_context, [this]() {
+        m_sessions.clear();
+    }, Qt::BlockingQueuedConnection);
+}
+
+UploadStandInServer::Stats UploadStandInServer::stats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+QByteArray UploadStandInServer::uploadedData() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_uploadedData;
+}
+
+QByteArray UploadStandInServer::completeData() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_completeData;
+}
+
+void UploadStandInServer::onNewConnection()
+{
+    while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+        QObject::connect(socket, &QTcpSocket::readyRead, m_context, [this, socket]() { onReadyRead(socket); });
+        QObject::connect(socket, &QTcpSocket::disconnected, m_context, [this, socket]() {
+            m_buffers.erase(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void UploadStandInServer::onReadyRead(QTcpSocket* socket)
+{
+    QByteArray& buffer = m_buffers[socket];
+    buffer += socket->readAll();
+
+    int headerEnd = buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+        return;
+    }
+
+    Request request;
+    QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+    QList<QByteArray> requestLine = lines.takeFirst().trimmed().split(' ');
+    if (requestLine.size() < 2) {
+        reply(socket, 400);
+        return;
+    }
+
+    request.method = requestLine.at(0);
+    request.path = QUrl(QString::fromLatin1(requestLine.at(1))).path();
+
+    for (const QByteArray& line : lines) {
+        int colon = line.indexOf(':');
+        if (colon > 0) {
+            request.headers[line.left(colon).trimmed().toLower()] = line.mid(colon + 1).trimmed();
+        }
+    }
+
+    int contentLength = request.header("content-length").toInt();
+    if (buffer.size() < headerEnd + 4 + contentLength) {
+        return;
+    }
+
+    request.body = buffer.mid(headerEnd + 4, contentLength);
+    m_buffers.erase(socket);
+
+    handle(socket, request);
+}
+
+void UploadStandInServer::handle(QTcpSocket* socket, const Request& request)
+{
+    QStringList parts = request.path.mid(UPLOAD_PATH.size()).split('/', Qt::SkipEmptyParts);
+
+    // POST /upload
+    if (parts.isEmpty() && request.method == "POST") {
+        QString id = QString("s%1").arg(++m_lastSessionId);
+        m_sessions[id].size = request.header("upload-length").toLongLong();
+
+        QJsonObject obj;
+        obj["session"] = UPLOAD_PATH + "/" + id;
+        reply(socket, 201, QJsonDocument(obj).toJson());
+        return;
+    }
+
+    auto session = parts.isEmpty() ? m_sessions.end() : m_sessions.find(parts.first());
+    if (session == m_sessions.end()) {
+        reply(socket, 404);
+        return;
+    }
+
+    // GET /upload/<session>
+    if (parts.size() == 1 && request.method == "GET") {
+        QJsonArray received;
+        for (const auto& chunk : session->second.chunks) {
+            received.append(chunk.first);
+        }
+
+        QJsonObject obj;
+        obj["received"] = received;
+        reply(socket, 200, QJsonDocument(obj).toJson());
+        return;
+    }
+
+    // POST /upload/<session>/complete
+    if (parts.size() == 2 && parts.at(1) == "complete" && request.method == "POST") {
+        QByteArray data;
+        for (const auto& chunk : session->second.chunks) {
+            data += chunk.second;
+        }
+
+        if (data.size() != session->second.size) {
+            reply(socket, 400);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.completeRequests++;
+            m_uploadedData = data;
+            m_completeData = request.body;
+        }
+
+        m_sessions.erase(session);
+
+        QJsonObject obj;
+        obj["permalink"] = "https://example.com/score/1";
+        reply(socket, 200, QJsonDocument(obj).toJson());
+        return;
+    }
+
+    // PUT /upload/<session>/<index>
+    if (parts.size() == 2 && request.method == "PUT") {
+        handleChunk(socket, session->second, parts.at(1).toInt(), request);
+        return;
+    }
+
+    reply(socket, 400);
+}
+
+void UploadStandInServer::handleChunk(QTcpSocket* socket, Session& session, int index, const Request& request)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.chunkRequests++;
+
+        //! NOTE 503 is a network error for the client, a connection closed by the server may be retried by Qt itself
+        if (m_skipChunkRequests > 0) {
+            m_skipChunkRequests--;
+        } else if (m_failChunkRequests > 0) {
+            m_failChunkRequests--;
+            reply(socket, m_failChunkStatus);
+            return;
+        }
+    }
+
+    static const QRegularExpression rangeRe("bytes (\\d+)-(\\d+)/(\\d+)");
+    QRegularExpressionMatch range = rangeRe.match(QString::fromLatin1(request.header("content-range")));
+    if (!range.hasMatch()) {
+        reply(socket, 400);
+        return;
+    }
+
+    const qint64 first = range.captured(1).toLongLong();
+    const qint64 last = range.captured(2).toLongLong();
+
+    QByteArray data = request.body;
+    bool deflated = request.header("content-encoding") == "deflate";
+    if (deflated) {
+        //! NOTE qUncompress wants the uncompressed size before the zlib stream
+        const quint32 size = static_cast<quint32>(last - first + 1);
+        QByteArray prefix;
+        prefix.append(char((size >> 24) & 0xff));
+        prefix.append(char((size >> 16) & 0xff));
+        prefix.append(char((size >> 8) & 0xff));
+        prefix.append(char(size & 0xff));
+        data = qUncompress(prefix + data);
+    }
+
+    if (data.size() != last - first + 1) {
+        reply(socket, 400);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.deflatedChunks += deflated ? 1 : 0;
+        m_stats.resentChunks += session.chunks.count(index) ? 1 : 0;
+    }
+
+    session.chunks[index] = data;
+
+    QJsonObject obj;
+    obj["received"] = index;
+    reply(socket, 200, QJsonDocument(obj).toJson());
+}
+
+void UploadStandInServer::reply(QTcpSocket* socket, int status, const QByteArray& body)
+{
+    QByteArray response = "HTTP/1.1 " + QByteArray::number(status) + " Status\r\n";
+    response += "Content-Type: application/json\r\n";
+    response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    response += "Connection: close\r\n\r\n";
+    response += body;
+
+    socket->write(response);
+    socket->disconnectFromHost();
+}
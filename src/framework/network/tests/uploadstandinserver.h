@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NETWORK_UPLOADSTANDINSERVER_H
+#define MU_NETWORK_UPLOADSTANDINSERVER_H
+
+#include <map>
+#include <mutex>
+
+#include <QByteArray>
+#include <QThread>
+#include <QUrl>
+
+class QTcpServer;
+class QTcpSocket;
+
+namespace mu::network {
+//! NOTE A local HTTP server speaking the protocol of ChunkedUpload,
+//! it runs in its own thread while the test waits for the upload
+class UploadStandInServer
+{
+public:
+    UploadStandInServer();
+    ~UploadStandInServer();
+
+    QUrl url() const;
+
+    //! NOTE Replies with the error status to `count` chunk requests after `skip` successful ones
+    void failChunkRequests(int count, int skip = 0, int status = 503);
+    void dropSessions();
+
+    struct Stats
+    {
+        int chunkRequests = 0;
+        int deflatedChunks = 0;
+        int resentChunks = 0;
+        int completeRequests = 0;
+    };
+
+    Stats stats() const;
+    QByteArray uploadedData() const;
+    QByteArray completeData() const;
+
+private:
+    struct Request
+    {
+        QByteArray method;
+        QString path;
+        std::map<QByteArray, QByteArray> headers; // lower case names
+        QByteArray body;
+
+        QByteArray header(const QByteArray& name) const
+        {
+            auto it = headers.find(name);
+            return it != headers.end() ? it->second : QByteArray();
+        }
+    };
+
+    struct Session
+    {
+        qint64 size = 0;
+        std::map<int, QByteArray> chunks;
+    };
+
+    void onNewConnection();
+    void onReadyRead(QTcpSocket* socket);
+    void handle(QTcpSocket* socket, const Request& request);
+    void handleChunk(QTcpSocket* socket, Session& session, int index, const Request& request);
+    void reply(QTcpSocket* socket, int status, const QByteArray& body = QByteArray());
+
+    QThread m_thread;
+    QObject* m_context = nullptr;
+    QTcpServer* m_server = nullptr;
+    quint16 m_port = 0;
+
+    std::map<QTcpSocket*, QByteArray> m_buffers;
+    std::map<QString, Session> m_sessions;
+    int m_lastSessionId = 0;
+
+    mutable std::mutex m_mutex;
+    int m_failChunkRequests = 0;
+    int m_skipChunkRequests = 0;
+    int m_failChunkStatus = 0;
+    Stats m_stats;
+    QByteArray m_uploadedData;
+    QByteArray m_completeData;
+};
+}
+
+#endif // MU_NETWORK_UPLOADSTANDINSERVER_H
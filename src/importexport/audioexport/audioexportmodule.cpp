@@ -30,6 +30,7 @@
 #include "internal/flacwriter.h"
 
 #include "internal/audioexportconfiguration.h"
+#include "internal/audioexportservice.h"
 
 #include "log.h"
 
@@ -38,6 +39,7 @@ using namespace mu::project;
 using namespace mu::modularity;
 
 static std::shared_ptr<AudioExportConfiguration> s_configuration = std::make_shared<AudioExportConfiguration>();
+static std::shared_ptr<AudioExportService> s_exportService = std::make_shared<AudioExportService>();
 
 std::string AudioExportModule::moduleName() const
 {
@@ -47,6 +49,7 @@ std::string AudioExportModule::moduleName() const
 void AudioExportModule::registerExports()
 {
     ioc()->registerExport<AudioExportConfiguration>(moduleName(), s_configuration);
+    ioc()->registerExport<IAudioExportService>(moduleName(), s_exportService);
 }
 
 void AudioExportModule::resolveImports()
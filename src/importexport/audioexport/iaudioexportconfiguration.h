@@ -41,6 +41,10 @@ public:
     virtual int exportSampleRate() const = 0;
     virtual void setExportSampleRate(int rate) = 0;
     virtual const std::vector<int>& availableSampleRates() const = 0;
+
+    //! NOTE Whether every track is written into its own file too, in the same pass as the mix
+    virtual bool exportStems() const = 0;
+    virtual void setExportStems(bool stems) = 0;
 };
 }
 
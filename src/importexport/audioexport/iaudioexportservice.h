@@ -0,0 +1,47 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_IMPORTEXPORT_IAUDIOEXPORTSERVICE_H
+#define MU_IMPORTEXPORT_IAUDIOEXPORTSERVICE_H
+
+#include <string>
+
+#include "modularity/imoduleexport.h"
+#include "types/ret.h"
+#include "io/path.h"
+
+namespace mu::iex::audioexport {
+class IAudioExportService : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(IAudioExportService)
+
+public:
+    virtual ~IAudioExportService() = default;
+
+    virtual bool isAudioSuffix(const std::string& suffix) const = 0;
+
+    //! NOTE Renders the playback of the current project once and encodes it into every file,
+    //!      the format is chosen by the file suffix
+    virtual Ret exportSoundTracks(const io::paths_t& destinations) = 0;
+};
+}
+
+#endif // MU_IMPORTEXPORT_IAUDIOEXPORTSERVICE_H
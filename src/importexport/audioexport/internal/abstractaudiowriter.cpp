@@ -86,7 +86,7 @@ mu::framework::Progress AbstractAudioWriter::progress() const
     return m_progress;
 }
 
-void AbstractAudioWriter::doWriteAndWait(QIODevice& destinationDevice, const audio::SoundTrackFormat& format)
+mu::Ret AbstractAudioWriter::doWriteAndWait(QIODevice& destinationDevice, const audio::SoundTrackFormat& format)
 {
     //!Note Temporary workaround, since QIODevice is the alias for QIODevice, which falls with SIGSEGV
     //!     on any call from background thread. Once we have our own implementation of QIODevice
@@ -96,33 +96,60 @@ void AbstractAudioWriter::doWriteAndWait(QIODevice& destinationDevice, const aud
     QFileInfo info(*file);
     QString path = info.absoluteFilePath();
 
+    return writeSoundTracks({ { io::path_t(path), format } });
+}
+
+mu::Ret AbstractAudioWriter::writeSoundTracks(const audio::SoundTrackDestinationList& destinations)
+{
     m_isCompleted = false;
+    m_writeRet = make_ok();
+
+    const bool withStems = configuration()->exportStems();
 
     playback()->sequenceIdList()
-    .onResolve(this, [this, path, &format](const audio::TrackSequenceIdList& sequenceIdList) {
+    .onResolve(this, [this, destinations, withStems](const audio::TrackSequenceIdList& sequenceIdList) {
         m_progress.started.notify();
 
+        if (sequenceIdList.empty()) {
+            m_isCompleted = true;
+            m_progress.finished.send(make_ok());
+            return;
+        }
+
         for (const audio::TrackSequenceId sequenceId : sequenceIdList) {
-            playback()->audioOutput()->saveSoundTrack(sequenceId, io::path_t(path), std::move(format))
-            .onResolve(this, [this, path](const bool /*result*/) {
-                LOGD() << "Successfully saved sound track by path: " << path;
+            async::Promise<bool> promise = withStems
+                                           ? playback()->audioOutput()->saveSoundTrackStems(sequenceId, destinations)
+                                           : playback()->audioOutput()->saveSoundTracks(sequenceId, destinations);
+
+            promise.onResolve(this, [this](const bool ok) {
+                if (ok) {
+                    LOGD() << "Successfully saved sound tracks";
+                } else {
+                    m_writeRet = make_ret(Ret::Code::InternalError);
+                }
+
                 m_isCompleted = true;
-                m_progress.finished.send(make_ok());
+                m_progress.finished.send(m_writeRet);
             })
             .onReject(this, [this](int errorCode, const std::string& msg) {
+                m_writeRet = make_ret(errorCode, msg);
                 m_isCompleted  = true;
-                m_progress.finished.send(make_ret(errorCode, msg));
+                m_progress.finished.send(m_writeRet);
             });
         }
     })
-    .onReject(this, [](int errorCode, const std::string& msg) {
+    .onReject(this, [this](int errorCode, const std::string& msg) {
         LOGE() << "errorCode: " << errorCode << ", " << msg;
+        m_writeRet = make_ret(errorCode, msg);
+        m_isCompleted = true;
     });
 
     while (!m_isCompleted) {
         QApplication::instance()->processEvents();
         QThread::yieldCurrentThread();
     }
+
+    return m_writeRet;
 }
 
 INotationWriter::UnitType AbstractAudioWriter::unitTypeFromOptions(const Options& options) const
@@ -47,12 +47,19 @@ public:
     framework::Progress progress() const override;
     void abort() override;
 
+    virtual audio::SoundTrackFormat soundTrackFormat() const = 0;
+
+    //! NOTE Renders the playback once and encodes it into all the destinations,
+    //!      and the tracks into their own files when the stems are exported
+    Ret writeSoundTracks(const audio::SoundTrackDestinationList& destinations);
+
 protected:
-    void doWriteAndWait(QIODevice& destinationDevice, const audio::SoundTrackFormat& format);
+    Ret doWriteAndWait(QIODevice& destinationDevice, const audio::SoundTrackFormat& format);
 
     UnitType unitTypeFromOptions(const Options& options) const;
     framework::Progress m_progress;
     bool m_isCompleted = false;
+    Ret m_writeRet;
 };
 }
 
@@ -67,3 +67,13 @@ const std::vector<int>& AudioExportConfiguration::availableSampleRates() const
     static const std::vector<int> rates { 32000, 44100, 48000 };
     return rates;
 }
+
+bool AudioExportConfiguration::exportStems() const
+{
+    return m_exportStems;
+}
+
+void AudioExportConfiguration::setExportStems(bool stems)
+{
+    m_exportStems = stems;
+}
@@ -38,8 +38,12 @@ public:
     void setExportSampleRate(int rate) override;
     const std::vector<int>& availableSampleRates() const override;
 
+    bool exportStems() const override;
+    void setExportStems(bool stems) override;
+
 private:
     std::optional<int> m_exportMp3Bitrate = std::nullopt;
+    bool m_exportStems = false;
 };
 }
 
@@ -0,0 +1,63 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audioexportservice.h"
+
+#include "abstractaudiowriter.h"
+
+#include "log.h"
+
+using namespace mu::iex::audioexport;
+
+bool AudioExportService::isAudioSuffix(const std::string& suffix) const
+{
+    return audioWriter(suffix) != nullptr;
+}
+
+mu::Ret AudioExportService::exportSoundTracks(const io::paths_t& destinations)
+{
+    TRACEFUNC;
+
+    if (destinations.empty()) {
+        return make_ok();
+    }
+
+    audio::SoundTrackDestinationList soundTracks;
+    std::shared_ptr<AbstractAudioWriter> writer;
+
+    for (const io::path_t& path : destinations) {
+        writer = audioWriter(io::suffix(path));
+        if (!writer) {
+            LOGE() << "not an audio file: " << path;
+            return make_ret(Ret::Code::NotSupported);
+        }
+
+        soundTracks.push_back({ path, writer->soundTrackFormat() });
+    }
+
+    //! NOTE Any of the writers renders the playback for all the formats
+    return writer->writeSoundTracks(soundTracks);
+}
+
+std::shared_ptr<AbstractAudioWriter> AudioExportService::audioWriter(const std::string& suffix) const
+{
+    return std::dynamic_pointer_cast<AbstractAudioWriter>(writers()->writer(suffix));
+}
@@ -0,0 +1,45 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_IMPORTEXPORT_AUDIOEXPORTSERVICE_H
+#define MU_IMPORTEXPORT_AUDIOEXPORTSERVICE_H
+
+#include "../iaudioexportservice.h"
+
+#include "modularity/ioc.h"
+#include "project/inotationwritersregister.h"
+
+namespace mu::iex::audioexport {
+class AbstractAudioWriter;
+class AudioExportService : public IAudioExportService
+{
+    INJECT(audioexport, project::INotationWritersRegister, writers)
+
+public:
+    bool isAudioSuffix(const std::string& suffix) const override;
+    Ret exportSoundTracks(const io::paths_t& destinations) override;
+
+private:
+    std::shared_ptr<AbstractAudioWriter> audioWriter(const std::string& suffix) const;
+};
+}
+
+#endif // MU_IMPORTEXPORT_AUDIOEXPORTSERVICE_H
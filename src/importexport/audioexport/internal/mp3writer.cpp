@@ -29,14 +29,15 @@ using namespace mu::framework;
 
 mu::Ret Mp3Writer::write(notation::INotationPtr, QIODevice& destinationDevice, const Options&)
 {
-    static const audio::SoundTrackFormat format {
+    return doWriteAndWait(destinationDevice, soundTrackFormat());
+}
+
+mu::audio::SoundTrackFormat Mp3Writer::soundTrackFormat() const
+{
+    return {
         audio::SoundTrackType::MP3,
         static_cast<audio::sample_rate_t>(configuration()->exportSampleRate()),
         2 /* audioChannelsNumber */,
         configuration()->exportMp3Bitrate()
     };
-
-    doWriteAndWait(destinationDevice, format);
-
-    return make_ret(Ret::Code::Ok);
 }
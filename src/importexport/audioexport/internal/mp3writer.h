@@ -30,6 +30,7 @@ class Mp3Writer : public AbstractAudioWriter
 {
 public:
     Ret write(notation::INotationPtr notation, QIODevice& destinationDevice, const Options& options = Options()) override;
+    audio::SoundTrackFormat soundTrackFormat() const override;
 };
 }
 
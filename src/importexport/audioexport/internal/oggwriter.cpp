@@ -29,14 +29,15 @@ using namespace mu::io;
 
 mu::Ret OggWriter::write(notation::INotationPtr, QIODevice& destinationDevice, const Options&)
 {
-    static const audio::SoundTrackFormat format {
+    return doWriteAndWait(destinationDevice, soundTrackFormat());
+}
+
+mu::audio::SoundTrackFormat OggWriter::soundTrackFormat() const
+{
+    return {
         audio::SoundTrackType::OGG,
         static_cast<audio::sample_rate_t>(configuration()->exportSampleRate()),
         2 /* audioChannelsNumber */,
         128 /* bitRate */
     };
-
-    doWriteAndWait(destinationDevice, format);
-
-    return make_ret(Ret::Code::Ok);
 }
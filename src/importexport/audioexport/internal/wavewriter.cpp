@@ -29,14 +29,15 @@ using namespace mu::framework;
 
 mu::Ret WaveWriter::write(notation::INotationPtr, QIODevice& destinationDevice, const Options&)
 {
-    static const audio::SoundTrackFormat format {
+    return doWriteAndWait(destinationDevice, soundTrackFormat());
+}
+
+mu::audio::SoundTrackFormat WaveWriter::soundTrackFormat() const
+{
+    return {
         audio::SoundTrackType::WAV,
         static_cast<audio::sample_rate_t>(configuration()->exportSampleRate()),
         2 /* audioChannelsNumber */,
         0 /* bitRate */
     };
-
-    doWriteAndWait(destinationDevice, format);
-
-    return make_ret(Ret::Code::Ok);
 }
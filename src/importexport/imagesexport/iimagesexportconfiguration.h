@@ -49,6 +49,11 @@ public:
 
     virtual int trimMarginPixelSize() const = 0;
     virtual void setTrimMarginPixelSize(std::optional<int> pixelSize) = 0;
+
+    //! NOTE Number of threads used to encode the pages of a multi-page export, 0 means the number of cores.
+    //! Maybe set from command line
+    virtual int exportImageThreadCount() const = 0;
+    virtual void setExportImageThreadCount(std::optional<int> count) = 0;
 };
 }
 
@@ -21,6 +21,8 @@
  */
 #include "abstractimagewriter.h"
 
+#include <QBuffer>
+
 #include "log.h"
 
 using namespace mu::iex::imagesexport;
@@ -68,6 +70,41 @@ mu::Ret AbstractImageWriter::writeList(const INotationPtrList&, QIODevice&, cons
     return Ret(Ret::Code::NotSupported);
 }
 
+mu::Ret AbstractImageWriter::writePages(INotationPtr notation, const PageDataHandler& handler, const Options& options)
+{
+    IF_ASSERT_FAILED(notation) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    if (!supportsUnitType(UnitType::PER_PAGE)) {
+        NOT_SUPPORTED;
+        return Ret(Ret::Code::NotSupported);
+    }
+
+    Options pageOptions = options;
+    size_t pageCount = notation->elements()->pages().size();
+
+    for (size_t i = 0; i < pageCount; ++i) {
+        QByteArray pageData;
+        QBuffer pageDevice(&pageData);
+        pageDevice.open(QIODevice::WriteOnly);
+
+        pageOptions[OptionKey::PAGE_NUMBER] = Val(static_cast<int>(i));
+
+        Ret ret = write(notation, pageDevice, pageOptions);
+        if (!ret) {
+            return ret;
+        }
+
+        ret = handler(i, pageData);
+        if (!ret) {
+            return ret;
+        }
+    }
+
+    return make_ok();
+}
+
 INotationWriter::UnitType AbstractImageWriter::unitTypeFromOptions(const Options& options) const
 {
     std::vector<UnitType> supported = supportedUnitTypes();
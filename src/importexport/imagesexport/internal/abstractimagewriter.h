@@ -33,6 +33,7 @@ public:
 
     Ret write(notation::INotationPtr notation, QIODevice& destinationDevice, const Options& options = Options()) override;
     Ret writeList(const notation::INotationPtrList& notations, QIODevice& destinationDevice, const Options& options = Options()) override;
+    Ret writePages(notation::INotationPtr notation, const PageDataHandler& handler, const Options& options = Options()) override;
 
 protected:
     UnitType unitTypeFromOptions(const Options& options) const;
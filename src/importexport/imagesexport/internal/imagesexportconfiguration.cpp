@@ -21,6 +21,8 @@
  */
 #include "imagesexportconfiguration.h"
 
+#include <thread>
+
 #include "settings.h"
 
 #include "libmscore/mscore.h"
@@ -31,12 +33,15 @@ using namespace mu::iex::imagesexport;
 static const Settings::Key EXPORT_PDF_DPI_RESOLUTION_KEY("iex_imagesexport", "export/pdf/dpi");
 static const Settings::Key EXPORT_PNG_DPI_RESOLUTION_KEY("iex_imagesexport", "export/png/resolution");
 static const Settings::Key EXPORT_PNG_USE_TRANSPARENCY_KEY("iex_imagesexport", "export/png/useTransparency");
+static const Settings::Key EXPORT_IMAGE_THREAD_COUNT_KEY("iex_imagesexport", "export/image/threadCount");
 
 void ImagesExportConfiguration::init()
 {
     settings()->setDefaultValue(EXPORT_PNG_DPI_RESOLUTION_KEY, Val(mu::engraving::DPI));
     settings()->setDefaultValue(EXPORT_PNG_USE_TRANSPARENCY_KEY, Val(false));
     settings()->setDefaultValue(EXPORT_PDF_DPI_RESOLUTION_KEY, Val(mu::engraving::DPI));
+    settings()->setDefaultValue(EXPORT_IMAGE_THREAD_COUNT_KEY, Val(0));
+    settings()->setCanBeManuallyEdited(EXPORT_IMAGE_THREAD_COUNT_KEY, true);
 }
 
 int ImagesExportConfiguration::exportPdfDpiResolution() const
@@ -82,3 +87,20 @@ void ImagesExportConfiguration::setTrimMarginPixelSize(std::optional<int> pixelS
 {
     m_trimMarginPixelSize = pixelSize;
 }
+
+int ImagesExportConfiguration::exportImageThreadCount() const
+{
+    int count = m_customExportImageThreadCount ? m_customExportImageThreadCount.value()
+                : settings()->value(EXPORT_IMAGE_THREAD_COUNT_KEY).toInt();
+
+    if (count <= 0) {
+        count = static_cast<int>(std::thread::hardware_concurrency());
+    }
+
+    return std::max(count, 1);
+}
+
+void ImagesExportConfiguration::setExportImageThreadCount(std::optional<int> count)
+{
+    m_customExportImageThreadCount = count;
+}
@@ -42,9 +42,13 @@ public:
     int trimMarginPixelSize() const override;
     void setTrimMarginPixelSize(std::optional<int> pixelSize) override;
 
+    int exportImageThreadCount() const override;
+    void setExportImageThreadCount(std::optional<int> count) override;
+
 private:
     std::optional<int> m_trimMarginPixelSize;
     std::optional<float> m_customExportPngDpi;
+    std::optional<int> m_customExportImageThreadCount;
 };
 }
 
@@ -23,7 +23,10 @@
 #include "pngwriter.h"
 
 #include <cmath>
-#include <QImage>
+#include <deque>
+#include <future>
+
+#include <QBuffer>
 
 #include "libmscore/masterscore.h"
 #include "libmscore/page.h"
@@ -47,6 +50,69 @@ mu::Ret PngWriter::write(INotationPtr notation, QIODevice& destinationDevice, co
         return make_ret(Ret::Code::UnknownError);
     }
 
+    QImage image = paintPage(notation, options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt(), options);
+    image.save(&destinationDevice, "png");
+
+    return true;
+}
+
+mu::Ret PngWriter::writePages(INotationPtr notation, const PageDataHandler& handler, const Options& options)
+{
+    IF_ASSERT_FAILED(notation) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    const size_t threadCount = static_cast<size_t>(configuration()->exportImageThreadCount());
+    if (threadCount <= 1) {
+        return AbstractImageWriter::writePages(notation, handler, options);
+    }
+
+    //! NOTE Painting reads the laid out score through the shared painting state,
+    //! so the pages are painted one by one on this thread, and only the PNG encoding,
+    //! which is the most expensive part, runs on the worker threads.
+    //! At most threadCount pages are kept in flight, the pages are handed over in order
+    const size_t pageCount = notation->elements()->pages().size();
+
+    std::deque<std::future<QByteArray> > encodings;
+    size_t handledPageCount = 0;
+
+    auto handleNextPage = [&]() {
+        QByteArray pageData = encodings.front().get();
+        encodings.pop_front();
+        return handler(handledPageCount++, pageData);
+    };
+
+    Ret ret = make_ok();
+    for (size_t i = 0; i < pageCount && ret; ++i) {
+        QImage image = paintPage(notation, static_cast<int>(i), options);
+
+        encodings.push_back(std::async(std::launch::async, [image = std::move(image)]() {
+            QByteArray pageData;
+            QBuffer pageDevice(&pageData);
+            pageDevice.open(QIODevice::WriteOnly);
+            image.save(&pageDevice, "png");
+            return pageData;
+        }));
+
+        if (encodings.size() >= threadCount) {
+            ret = handleNextPage();
+        }
+    }
+
+    while (!encodings.empty()) {
+        if (ret) {
+            ret = handleNextPage();
+        } else {
+            encodings.front().wait();
+            encodings.pop_front();
+        }
+    }
+
+    return ret;
+}
+
+QImage PngWriter::paintPage(INotationPtr notation, int pageNumber, const Options& options) const
+{
     const float CANVAS_DPI = configuration()->exportPngDpiResolution();
     const SizeF pageSizeInch = notation->painting()->pageSizeInch();
 
@@ -60,18 +126,17 @@ mu::Ret PngWriter::write(INotationPtr notation, QIODevice& destinationDevice, co
     const bool TRANSPARENT_BACKGROUND = options.value(OptionKey::TRANSPARENT_BACKGROUND, Val(false)).toBool();
     image.fill(TRANSPARENT_BACKGROUND ? Qt::transparent : Qt::white);
 
-    mu::draw::Painter painter(&image, "pngwriter");
-
     INotationPainting::Options opt;
-    opt.fromPage = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
+    opt.fromPage = pageNumber;
     opt.toPage = opt.fromPage;
     opt.trimMarginPixelSize = configuration()->trimMarginPixelSize();
     opt.deviceDpi = CANVAS_DPI;
     opt.printPageBackground = false; //Already printed
 
-    notation->painting()->paintPng(&painter, opt);
-
-    image.save(&destinationDevice, "png");
+    {
+        mu::draw::Painter painter(&image, "pngwriter");
+        notation->painting()->paintPng(&painter, opt);
+    }
 
-    return true;
+    return image;
 }
@@ -25,6 +25,7 @@
 #include "svggenerator.h"
 
 #include "engraving/infrastructure/paint.h"
+#include "engraving/infrastructure/systemdisplaylist.h"
 
 #include "libmscore/measure.h"
 #include "libmscore/note.h"
@@ -199,29 +200,50 @@ mu::Ret SvgWriter::write(INotationPtr notation, QIODevice& destinationDevice, co
     }
 
     // 3rd pass: the rest of the elements
-    std::vector<mu::engraving::EngravingItem*> elements = page->elements();
-    std::sort(elements.begin(), elements.end(), mu::engraving::elementLessThan);
-
-    for (const mu::engraving::EngravingItem* element : elements) {
+    auto prepareElement = [&printer](const mu::engraving::EngravingItem* element) {
         // Always exclude invisible elements
         if (!element->visible()) {
-            continue;
+            return false;
         }
 
-        mu::engraving::ElementType type = element->type();
-        switch (type) { // In future sub-type code, this switch() grows, and eType gets used
-        case mu::engraving::ElementType::STAFF_LINES: // Handled in the 1st pass above
-            continue; // Exclude from 2nd pass
-            break;
-        default:
-            break;
+        // Staff lines are handled in the 1st pass above
+        if (element->isStaffLines()) {
+            return false;
         }
 
         // Set the EngravingItem pointer inside SvgGenerator/SvgPaintEngine
         printer.setElement(element);
+        return true;
+    };
+
+    if (!beatsColors.isEmpty()) {
+        // The recorded painting doesn't know about the colors set above, so the page is painted directly
+        std::vector<mu::engraving::EngravingItem*> elements = page->elements();
+        std::sort(elements.begin(), elements.end(), mu::engraving::elementLessThan);
+
+        for (const mu::engraving::EngravingItem* element : elements) {
+            if (prepareElement(element)) {
+                engraving::Paint::paintElement(painter, element);
+            }
+        }
 
-        // Paint it
-        engraving::Paint::paintElement(painter, element);
+        // and the recorded painting is dropped, so that it doesn't keep the old colors
+        for (mu::engraving::System* system : score->systems()) {
+            system->invalidateDisplayList();
+        }
+    } else {
+        if (prepareElement(page)) {
+            engraving::Paint::paintElement(painter, page);
+        }
+
+        // The systems are painted from their display lists, recorded once for all the export formats
+        score->applyDisplayListRefresh();
+
+        std::vector<std::shared_ptr<mu::engraving::SystemDisplayList> > lists;
+        for (const mu::engraving::System* system : page->systems()) {
+            lists.push_back(system->displayList());
+        }
+        mu::engraving::SystemDisplayList::paint(painter, lists, prepareElement);
     }
 
     painter.endDraw(); // Writes MuseScore SVG file to disk, finally
@@ -199,7 +199,8 @@ mu::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, con
             currentTimeSec = totalPlayTimeSec;
         }
 
-        midi::tick_t tick = playback->secToPlayedTick(currentTimeSec);
+        //! NOTE The pages and the cursor are found by the score tick, not the played one
+        midi::tick_t tick = playback->secToTick(currentTimeSec);
 
         const Page* page = pageByTick(pages, tick);
         if (!page) {
@@ -92,6 +92,10 @@ static const QMap<mu::engraving::ElementType, InspectorModelType> NOTATION_ELEME
     { mu::engraving::ElementType::INSTRUMENT_NAME, InspectorModelType::TYPE_INSTRUMENT_NAME }
 };
 
+//! NOTE The number of elements the property summaries are computed for at once,
+//! bigger selections are summarized step by step from the event loop
+static constexpr size_t PROPERTY_SUMMARY_STEP = 1000;
+
 static QMap<mu::engraving::HairpinType, InspectorModelType> HAIRPIN_ELEMENT_MODEL_TYPES = {
     { mu::engraving::HairpinType::CRESC_HAIRPIN, InspectorModelType::TYPE_HAIRPIN },
     { mu::engraving::HairpinType::DECRESC_HAIRPIN, InspectorModelType::TYPE_HAIRPIN },
@@ -107,6 +111,9 @@ AbstractInspectorModel::AbstractInspectorModel(QObject* parent, IElementReposito
                                                mu::engraving::ElementType elementType)
     : QObject(parent), m_elementType(elementType), m_updatePropertiesAllowed(true)
 {
+    m_propertySummaryTimer.setInterval(0);
+    connect(&m_propertySummaryTimer, &QTimer::timeout, this, &AbstractInspectorModel::continuePropertySummaries);
+
     m_repository = repository;
 
     if (!m_repository) {
@@ -129,8 +136,16 @@ void AbstractInspectorModel::setupCurrentNotationChangedConnection()
         }
 
         notation->notationChanged().onNotify(this, [this]() {
-            if (m_updatePropertiesAllowed && !isEmpty()) {
-                updatePropertiesOnNotationChanged();
+            //! NOTE The elements may have been changed or deleted, a pass that is not finished starts again
+            std::function<void()> onBuilt = cancelPropertySummaries();
+            if (!onBuilt && m_updatePropertiesAllowed) {
+                onBuilt = [this]() {
+                    updatePropertiesOnNotationChanged();
+                };
+            }
+
+            if (onBuilt && !isEmpty()) {
+                buildPropertySummaries(std::move(onBuilt));
             }
 
             m_updatePropertiesAllowed = true;
@@ -144,7 +159,8 @@ void AbstractInspectorModel::setupCurrentNotationChangedConnection()
 
     listenNotationChanged();
 
-    currentNotationChanged().onNotify(this, [listenNotationChanged]() {
+    currentNotationChanged().onNotify(this, [this, listenNotationChanged]() {
+        cancelPropertySummaries();
         listenNotationChanged();
     });
 }
@@ -303,9 +319,14 @@ void AbstractInspectorModel::updateProperties()
 
     emit isEmptyChanged();
 
-    if (!isEmpty()) {
-        loadProperties();
+    if (isEmpty()) {
+        cancelPropertySummaries();
+        return;
     }
+
+    buildPropertySummaries([this]() {
+        loadProperties();
+    });
 }
 
 void AbstractInspectorModel::requestElements()
@@ -330,6 +351,96 @@ mu::engraving::Sid AbstractInspectorModel::styleIdByPropertyId(const mu::engravi
     return result;
 }
 
+//---------------------------------------------------------
+//   buildPropertySummaries
+//    Computes the summaries of all property items of the
+//    model in one pass over the element list and calls
+//    onBuilt when they are ready. Big selections are passed
+//    in steps from the event loop; a new selection, an edit
+//    or another notation cancels the pass.
+//---------------------------------------------------------
+
+void AbstractInspectorModel::buildPropertySummaries(std::function<void()> onBuilt)
+{
+    cancelPropertySummaries();
+
+    std::vector<Pid> pids;
+    for (const PropertyItem* item : findChildren<PropertyItem*>(QString(), Qt::FindDirectChildrenOnly)) {
+        pids.push_back(item->propertyId());
+    }
+
+    //! NOTE Only point and millimetre values depend on the element (spatium) when converted,
+    //! for all other types equal raw values give equal converted values
+    auto valuesEqual = [this](Pid pid, const PropertyValue& value1, const EngravingItem* element1,
+                              const PropertyValue& value2, const EngravingItem* element2) {
+        bool isElementDependent = value1.type() == P_TYPE::POINT || value1.type() == P_TYPE::MILLIMETRE;
+        if (!isElementDependent && value1.type() == value2.type() && value1 == value2) {
+            return true;
+        }
+
+        return valueFromElementUnits(pid, value1, element1) == valueFromElementUnits(pid, value2, element2);
+    };
+
+    std::vector<EngravingItem*> elements(m_elementList.begin(), m_elementList.end());
+    m_propertySummaryBuilder = std::make_unique<PropertySummaryBuilder>(elements, pids, valuesEqual);
+    m_onPropertySummariesBuilt = std::move(onBuilt);
+
+    if (elements.size() <= PROPERTY_SUMMARY_STEP) {
+        continuePropertySummaries();
+    } else {
+        m_propertySummaryTimer.start();
+    }
+}
+
+void AbstractInspectorModel::continuePropertySummaries()
+{
+    TRACEFUNC;
+
+    if (!m_propertySummaryBuilder) {
+        m_propertySummaryTimer.stop();
+        return;
+    }
+
+    if (!m_propertySummaryBuilder->process(PROPERTY_SUMMARY_STEP)) {
+        return;
+    }
+
+    m_propertySummaryTimer.stop();
+
+    std::function<void()> onBuilt = std::move(m_onPropertySummariesBuilt);
+    m_onPropertySummariesBuilt = nullptr;
+
+    //! NOTE The summaries are only used by this load, onBuilt may start a new pass
+    const PropertySummaryBuilder* builder = m_propertySummaryBuilder.get();
+    if (onBuilt) {
+        onBuilt();
+    }
+
+    if (m_propertySummaryBuilder.get() == builder) {
+        m_propertySummaryBuilder.reset();
+    }
+}
+
+std::function<void()> AbstractInspectorModel::cancelPropertySummaries()
+{
+    m_propertySummaryTimer.stop();
+
+    if (m_propertySummaryBuilder) {
+        m_propertySummaryBuilder->cancel();
+        m_propertySummaryBuilder.reset();
+    }
+
+    std::function<void()> onBuilt = std::move(m_onPropertySummariesBuilt);
+    m_onPropertySummariesBuilt = nullptr;
+
+    return onBuilt;
+}
+
+const PropertySummary* AbstractInspectorModel::propertySummary(const mu::engraving::Pid pid) const
+{
+    return m_propertySummaryBuilder ? m_propertySummaryBuilder->summary(pid) : nullptr;
+}
+
 void AbstractInspectorModel::updateStyleValue(const mu::engraving::Sid& sid, const QVariant& newValue)
 {
     PropertyValue newVal = PropertyValue::fromQVariant(newValue, mu::engraving::MStyle::valueType(sid));
@@ -471,6 +582,29 @@ void AbstractInspectorModel::loadPropertyItem(PropertyItem* propertyItem,
 
     mu::engraving::Pid pid = propertyItem->propertyId();
 
+    //! NOTE A mixed summary can still become equal after conversion, so only an unconverted or an equal one is used
+    const PropertySummary* summary = propertySummary(pid);
+    if (summary && (!convertElementPropertyValueFunc || !summary->isMixed)) {
+        propertyItem->setStyleId(summary->styleId);
+
+        QVariant propertyValue;
+        QVariant defaultPropertyValue;
+
+        if (summary->element) {
+            propertyValue = valueFromElementUnits(pid, summary->value, summary->element);
+            defaultPropertyValue = valueFromElementUnits(pid, summary->defaultValue, summary->element);
+        }
+
+        if (convertElementPropertyValueFunc && propertyValue.isValid()) {
+            propertyValue = convertElementPropertyValueFunc(propertyValue);
+            defaultPropertyValue = convertElementPropertyValueFunc(defaultPropertyValue);
+        }
+
+        propertyItem->setIsEnabled(propertyValue.isValid());
+        propertyItem->fillValues(summary->isMixed ? QVariant() : propertyValue, defaultPropertyValue);
+        return;
+    }
+
     mu::engraving::Sid styleId = styleIdByPropertyId(pid);
     propertyItem->setStyleId(styleId);
 
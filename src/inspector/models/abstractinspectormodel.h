@@ -23,7 +23,9 @@
 #define MU_INSPECTOR_ABSTRACTINSPECTORMODEL_H
 
 #include <QList>
+#include <QTimer>
 #include <functional>
+#include <memory>
 
 #include "async/asyncable.h"
 
@@ -32,6 +34,7 @@
 #include "libmscore/engravingitem.h"
 #include "libmscore/masterscore.h"
 #include "libmscore/property.h"
+#include "libmscore/propertysummary.h"
 
 #include "internal/interfaces/ielementrepositoryservice.h"
 #include "notation/inotation.h"
@@ -207,12 +210,21 @@ private:
 
     mu::engraving::Sid styleIdByPropertyId(const mu::engraving::Pid pid) const;
 
+    void buildPropertySummaries(std::function<void()> onBuilt);
+    void continuePropertySummaries();
+    std::function<void()> cancelPropertySummaries();
+    const mu::engraving::PropertySummary* propertySummary(const mu::engraving::Pid pid) const;
+
     QString m_title;
     ui::IconCode::Code m_icon = ui::IconCode::Code::NONE;
     InspectorSectionType m_sectionType = InspectorSectionType::SECTION_UNDEFINED;
     InspectorModelType m_modelType = InspectorModelType::TYPE_UNDEFINED;
     mu::engraving::ElementType m_elementType = mu::engraving::ElementType::INVALID;
     bool m_updatePropertiesAllowed = false;
+
+    std::unique_ptr<mu::engraving::PropertySummaryBuilder> m_propertySummaryBuilder;
+    std::function<void()> m_onPropertySummariesBuilt;
+    QTimer m_propertySummaryTimer;
 };
 
 using InspectorModelType = AbstractInspectorModel::InspectorModelType;
@@ -25,6 +25,8 @@
 #include <memory>
 #include "notationtypes.h"
 
+#include "async/channel.h"
+
 #include "draw/painter.h"
 
 namespace mu::notation {
@@ -56,6 +58,9 @@ public:
     virtual SizeF pageSizeInch() const = 0;
 
     virtual void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting) = 0;
+    //! NOTE Sends the duration of every paintView call in microseconds, used for performance testing
+    virtual async::Channel<int64_t> viewPainted() const = 0;
+
     virtual void paintPdf(draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPrint(draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPng(draw::Painter* painter, const Options& opt) = 0;
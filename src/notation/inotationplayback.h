@@ -46,6 +46,7 @@ public:
 
     virtual const mpe::PlaybackData& trackPlaybackData(const engraving::InstrumentTrackId& trackId) const = 0;
     virtual void triggerEventsForItems(const std::vector<const EngravingItem*>& items) = 0;
+    virtual void triggerEventForPitch(const engraving::InstrumentTrackId& trackId, int pitch) = 0;
     virtual void triggerMetronome(int tick) = 0;
 
     virtual engraving::InstrumentTrackIdSet existingTrackIdSet() const = 0;
@@ -48,19 +48,13 @@ const InstrumentTemplateList& InstrumentsRepository::instrumentTemplates() const
 
 const InstrumentTemplate& InstrumentsRepository::instrumentTemplate(const std::string& instrumentId) const
 {
-    const InstrumentTemplateList& templates = m_instrumentTemplates;
-
-    auto it = std::find_if(templates.begin(), templates.end(), [instrumentId](const InstrumentTemplate* templ) {
-        return templ->id == instrumentId;
-    });
-
-    if (it == m_instrumentTemplates.cend()) {
+    auto it = m_instrumentTemplatesById.find(instrumentId);
+    if (it == m_instrumentTemplatesById.cend()) {
         static InstrumentTemplate dummy;
         return dummy;
     }
 
-    const InstrumentTemplate* templ = *it;
-    return *templ;
+    return *it->second;
 }
 
 const ScoreOrderList& InstrumentsRepository::orders() const
@@ -99,6 +93,7 @@ void InstrumentsRepository::load()
     TRACEFUNC;
 
     m_instrumentTemplates.clear();
+    m_instrumentTemplatesById.clear();
     m_genres.clear();
     m_groups.clear();
     mu::engraving::clearInstrumentTemplates();
@@ -123,6 +118,7 @@ void InstrumentsRepository::load()
 
             templ->groupId = group->id;
             m_instrumentTemplates << templ;
+            m_instrumentTemplatesById.emplace(templ->id.toStdString(), templ);
         }
     }
 }
@@ -74,6 +74,12 @@ MasterNotation::MasterNotation()
         updateExcerpts();
         notifyAboutNeedSaveChanged();
     });
+
+    engravingConfiguration()->undoHistoryMemoryLimitChanged().onNotify(this, [this]() {
+        if (masterScore()) {
+            masterScore()->undoStack()->setMemoryLimit(engravingConfiguration()->undoHistoryMemoryLimit());
+        }
+    });
 }
 
 MasterNotation::~MasterNotation()
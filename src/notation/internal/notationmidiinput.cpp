@@ -28,6 +28,9 @@
 #include "libmscore/tie.h"
 #include "libmscore/score.h"
 #include "libmscore/note.h"
+#include "libmscore/instrument.h"
+#include "libmscore/part.h"
+#include "libmscore/staff.h"
 
 #include "notationtypes.h"
 
@@ -36,11 +39,13 @@
 
 using namespace mu::notation;
 
-static constexpr int PROCESS_INTERVAL = 20;
+//! NOTE The notation changes are coalesced per UI frame, the notes are played without waiting for it
+static constexpr int PROCESS_INTERVAL = 16;
 
 NotationMidiInput::NotationMidiInput(IGetScore* getScore, INotationInteractionPtr notationInteraction, INotationUndoStackPtr undoStack)
     : m_getScore(getScore), m_notationInteraction(notationInteraction), m_undoStack(undoStack)
 {
+    m_processTimer.setTimerType(Qt::PreciseTimer);
     QObject::connect(&m_processTimer, &QTimer::timeout, [this]() { doProcessEvents(); });
 
     m_realtimeTimer.setTimerType(Qt::PreciseTimer);
@@ -63,7 +68,13 @@ void NotationMidiInput::onMidiEventReceived(const midi::Event& event)
     }
 
     if (event.opcode() == midi::Event::Opcode::NoteOn || event.opcode() == midi::Event::Opcode::NoteOff) {
-        m_eventsQueue.push_back(event);
+        midi::MidiInputLatency::Clock::time_point eventTime = midi::MidiInputLatency::instance()->eventTime();
+
+        if (event.opcode() == midi::Event::Opcode::NoteOn) {
+            playNote(event, eventTime);
+        }
+
+        m_eventsQueue.push_back({ event, eventTime });
 
         if (!m_processTimer.isActive()) {
             m_processTimer.start(PROCESS_INTERVAL);
@@ -107,6 +118,36 @@ mu::engraving::Score* NotationMidiInput::score() const
     return m_getScore->score();
 }
 
+void NotationMidiInput::playNote(const midi::Event& e, midi::MidiInputLatency::Clock::time_point eventTime)
+{
+    if (!isNoteInputMode()) {
+        return;
+    }
+
+    const mu::engraving::Score* sc = score();
+    if (!sc) {
+        return;
+    }
+
+    const mu::engraving::InputState& is = sc->inputState();
+    const mu::engraving::Staff* staff = sc->staff(mu::engraving::track2staff(is.track()));
+    if (!staff) {
+        return;
+    }
+
+    const mu::engraving::Part* part = staff->part();
+
+    //! NOTE Same as Score::addMidiPitch: if transposing, the MIDI pitch is the written pitch
+    int pitch = e.note();
+    if (!sc->styleB(mu::engraving::Sid::concertPitch)) {
+        pitch += part->instrument(is.tick())->transpose().chromatic;
+    }
+
+    playbackController()->playPitch({ part->id(), part->instrumentId(is.tick()).toStdString() }, pitch);
+
+    midi::MidiInputLatency::instance()->addSample(midi::MidiInputLatency::Stage::Previewed, eventTime);
+}
+
 void NotationMidiInput::doProcessEvents()
 {
     if (m_eventsQueue.empty()) {
@@ -114,13 +155,13 @@ void NotationMidiInput::doProcessEvents()
         return;
     }
 
-    std::vector<const EngravingItem*> notes;
-
+    //! NOTE The added notes are not played here: each of them already sounds since its NoteOn (see playNote),
+    //! playing them again would sound every note twice
     for (size_t i = 0; i < m_eventsQueue.size(); ++i) {
-        const midi::Event& event = m_eventsQueue.at(i);
+        const midi::Event& event = m_eventsQueue.at(i).event;
         Note* note = onAddNote(event);
         if (note) {
-            notes.push_back(note);
+            midi::MidiInputLatency::instance()->addSample(midi::MidiInputLatency::Stage::Inserted, m_eventsQueue.at(i).time);
         }
 
         bool chord = i != 0;
@@ -132,10 +173,6 @@ void NotationMidiInput::doProcessEvents()
         }
     }
 
-    if (!notes.empty()) {
-        playbackController()->playElements(notes);
-    }
-
     m_eventsQueue.clear();
     m_processTimer.stop();
 }
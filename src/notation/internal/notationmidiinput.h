@@ -28,6 +28,7 @@
 #include "playback/iplaybackcontroller.h"
 #include "inotationconfiguration.h"
 #include "actions/iactionsdispatcher.h"
+#include "midi/midiinputlatency.h"
 
 #include "../inotationmidiinput.h"
 #include "igetscore.h"
@@ -56,6 +57,8 @@ public:
 private:
     mu::engraving::Score* score() const;
 
+    void playNote(const midi::Event& e, midi::MidiInputLatency::Clock::time_point eventTime);
+
     void doProcessEvents();
     Note* onAddNote(const midi::Event& e);
 
@@ -80,8 +83,13 @@ private:
     INotationUndoStackPtr m_undoStack;
     async::Notification m_noteChanged;
 
+    struct QueuedEvent {
+        midi::Event event;
+        midi::MidiInputLatency::Clock::time_point time;
+    };
+
     QTimer m_processTimer;
-    std::vector<midi::Event> m_eventsQueue;
+    std::vector<QueuedEvent> m_eventsQueue;
 
     QTimer m_realtimeTimer;
     QTimer m_extendNoteTimer;
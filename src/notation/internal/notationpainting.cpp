@@ -21,6 +21,8 @@
  */
 #include "notationpainting.h"
 
+#include <chrono>
+
 #include <QScreen>
 
 #include "engraving/libmscore/score.h"
@@ -202,8 +204,7 @@ void NotationPainting::doPaint(draw::Painter* painter, const Options& opt)
             // Draw page elements
             painter->setClipping(true);
             painter->setClipRect(pageRect);
-            std::vector<EngravingItem*> elements = page->items(drawRect.translated(-pagePos));
-            engraving::Paint::paintElements(*painter, elements, opt.isPrinting);
+            engraving::Paint::paintPage(*painter, page, drawRect.translated(-pagePos), opt.isPrinting);
             painter->setClipping(false);
 
 #ifdef ENGRAVING_PAINT_DEBUGGER_ENABLED
@@ -286,7 +287,15 @@ void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool
     opt.frameRect = frameRect;
     opt.deviceDpi = uiConfiguration()->logicalDpi();
     opt.isPrinting = isPrinting;
+
+    auto start = std::chrono::steady_clock::now();
     doPaint(painter, opt);
+    m_viewPainted.send(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+async::Channel<int64_t> NotationPainting::viewPainted() const
+{
+    return m_viewPainted;
 }
 
 void NotationPainting::paintPdf(draw::Painter* painter, const Options& opt)
@@ -53,6 +53,8 @@ public:
     SizeF pageSizeInch() const override;
 
     void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting) override;
+    async::Channel<int64_t> viewPainted() const override;
+
     void paintPdf(draw::Painter* painter, const Options& opt) override;
     void paintPrint(draw::Painter* painter, const Options& opt) override;
     void paintPng(draw::Painter* painter, const Options& opt) override;
@@ -67,6 +69,7 @@ private:
                         bool printPageBackground) const;
 
     Notation* m_notation = nullptr;
+    async::Channel<int64_t> m_viewPainted;
 };
 }
 
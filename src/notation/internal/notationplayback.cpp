@@ -130,6 +130,11 @@ void NotationPlayback::triggerEventsForItems(const std::vector<const EngravingIt
     m_playbackModel.triggerEventsForItems(items);
 }
 
+void NotationPlayback::triggerEventForPitch(const engraving::InstrumentTrackId& trackId, int pitch)
+{
+    m_playbackModel.triggerEventForPitch(trackId, pitch);
+}
+
 void NotationPlayback::triggerMetronome(int tick)
 {
     m_playbackModel.triggerMetronome(tick);
@@ -170,8 +175,7 @@ void NotationPlayback::updateTotalPlayTime()
         return;
     }
 
-    int lastTick = score->repeatList().ticks();
-    qreal secs = score->utick2utime(lastTick);
+    qreal secs = score->playbackTimeline()->duration();
 
     audio::msecs_t newPlayTime = secs * 1000.f;
 
@@ -195,7 +199,7 @@ async::Channel<audio::msecs_t> NotationPlayback::totalPlayTimeChanged() const
 
 float NotationPlayback::playedTickToSec(tick_t tick) const
 {
-    return score() ? score()->utick2utime(tick) : 0.0;
+    return score() ? score()->playbackTimeline()->utick2utime(tick) : 0.0;
 }
 
 tick_t NotationPlayback::secToPlayedTick(float sec) const
@@ -204,7 +208,7 @@ tick_t NotationPlayback::secToPlayedTick(float sec) const
         return 0;
     }
 
-    return score()->utime2utick(sec);
+    return score()->playbackTimeline()->utime2utick(sec);
 }
 
 tick_t NotationPlayback::secToTick(float sec) const
@@ -213,9 +217,9 @@ tick_t NotationPlayback::secToTick(float sec) const
         return 0;
     }
 
-    tick_t utick = secToPlayedTick(sec);
+    PlaybackTimelinePtr timeline = score()->playbackTimeline();
 
-    return score()->repeatList().utick2tick(utick);
+    return timeline->utick2tick(timeline->utime2utick(sec));
 }
 
 RetVal<midi::tick_t> NotationPlayback::playPositionTickByRawTick(midi::tick_t tick) const
@@ -224,7 +228,7 @@ RetVal<midi::tick_t> NotationPlayback::playPositionTickByRawTick(midi::tick_t ti
         return make_ret(Err::Undefined);
     }
 
-    midi::tick_t playbackTick = score()->repeatList().tick2utick(tick);
+    midi::tick_t playbackTick = score()->playbackTimeline()->tick2utick(tick);
 
     return RetVal<midi::tick_t>::make_ok(std::move(playbackTick));
 }
@@ -53,6 +53,7 @@ public:
 
     const mpe::PlaybackData& trackPlaybackData(const engraving::InstrumentTrackId& trackId) const override;
     void triggerEventsForItems(const std::vector<const EngravingItem*>& items) override;
+    void triggerEventForPitch(const engraving::InstrumentTrackId& trackId, int pitch) override;
     void triggerMetronome(int tick) override;
 
     engraving::InstrumentTrackIdSet existingTrackIdSet() const override;
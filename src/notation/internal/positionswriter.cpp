@@ -65,13 +65,14 @@ static void writeEventPosition(mu::framework::XmlWriter& writer, const std::stri
     writer.writeEndElement();
 }
 
-static void writeMeasureEvents(mu::framework::XmlWriter& writer, Measure* m, int offset, const QHash<void*, int>& segments)
+static void writeMeasureEvents(mu::framework::XmlWriter& writer, Measure* m, int offset, const QHash<void*, int>& segments,
+                               const mu::engraving::PlaybackTimeline& timeline)
 {
     for (mu::engraving::Segment* s = m->first(mu::engraving::SegmentType::ChordRest); s;
          s = s->next(mu::engraving::SegmentType::ChordRest)) {
         int tick = s->tick().ticks() + offset;
         int id = segments[(void*)s];
-        int time = lrint(m->score()->repeatList().utick2utime(tick) * 1000);
+        int time = lrint(timeline.utick2utime(tick) * 1000);
 
         writeEventPosition(writer, std::to_string(id), time);
     }
@@ -226,17 +227,19 @@ void PositionsWriter::writeEventsPositions(mu::framework::XmlWriter& writer, con
 
     score->masterScore()->setExpandRepeats(true);
 
+    mu::engraving::PlaybackTimelinePtr timeline = score->playbackTimeline();
+
     for (const mu::engraving::RepeatSegment* repeatSegment : score->repeatList()) {
         int startTick = repeatSegment->tick;
         int endTick = startTick + repeatSegment->len();
         int tickOffset = repeatSegment->utick - repeatSegment->tick;
         for (Measure* measure = score->tick2measureMM(Fraction::fromTicks(startTick)); measure; measure = measure->nextMeasureMM()) {
             if (m_elementType == ElementType::SEGMENT) {
-                writeMeasureEvents(writer, measure, tickOffset, elementIds);
+                writeMeasureEvents(writer, measure, tickOffset, elementIds, *timeline);
             } else {
                 int tick = measure->tick().ticks() + tickOffset;
                 int id = elementIds[(void*)measure];
-                int time = std::lrint(measure->score()->repeatList().utick2utime(tick) * 1000);
+                int time = std::lrint(timeline->utick2utime(tick) * 1000);
 
                 writeEventPosition(writer, std::to_string(id), time);
             }
@@ -24,6 +24,8 @@
 #include "draw/types/pen.h"
 #include "infrastructure/symbolfont.h"
 
+#include "engraving/libmscore/score.h"
+
 using namespace mu::notation;
 using namespace mu;
 
@@ -55,79 +57,26 @@ RectF LoopMarker::resolveMarkerRectByTick(midi::tick_t _tick) const
 
     const mu::engraving::Score* score = m_notation->elements()->msScore();
 
-    Fraction tick = Fraction::fromTicks(_tick);
+    int tick = static_cast<int>(_tick);
 
     // set mark height for whole system
-    if (m_type == LoopBoundaryType::LoopOut && tick > Fraction(0, 1)) {
-        tick -= Fraction::fromTicks(1);
-    }
-
-    Measure* measure = score->tick2measureMM(tick);
-    if (measure == nullptr) {
-        return RectF();
-    }
-
-    qreal x = 0.0;
-    const Fraction offset = { 0, 1 };
-
-    mu::engraving::Segment* s = nullptr;
-    for (s = measure->first(mu::engraving::SegmentType::ChordRest); s;) {
-        Fraction t1 = s->tick();
-        int x1 = s->canvasPos().x();
-        qreal x2 = 0.0;
-        Fraction t2;
-        mu::engraving::Segment* ns = s->next(mu::engraving::SegmentType::ChordRest);
-
-        if (ns) {
-            t2 = ns->tick();
-            x2 = ns->canvasPos().x();
-        } else {
-            t2 = measure->endTick();
-            x2 = measure->canvasPos().x() + measure->width();
-        }
-
-        t1 += offset;
-        t2 += offset;
-
-        if (tick >= t1 && tick < t2) {
-            Fraction dt = t2 - t1;
-            qreal dx = x2 - x1;
-            x = x1 + dx * (tick - t1).ticks() / dt.ticks();
-            break;
-        }
-
-        s = ns;
+    if (m_type == LoopBoundaryType::LoopOut && tick > 0) {
+        tick -= 1;
     }
 
-    if (s == nullptr) {
+    mu::engraving::PlaybackTimeline::Position position = score->playbackTimeline()->position(tick);
+    if (!position.isValid()) {
         return RectF();
     }
 
-    const mu::engraving::System* system = measure->system();
-    if (system == nullptr || system->page() == nullptr || system->staves().empty()) {
-        return RectF();
-    }
-
-    double y = system->staffYpage(0) + system->page()->pos().y();
     double _spatium = score->spatium();
 
     qreal mag = _spatium / mu::engraving::SPATIUM20;
     double width = (_spatium * 2.0 + score->symbolFont()->width(mu::engraving::SymId::noteheadBlack, mag)) / 3;
-    double height = 6 * _spatium;
-
-    // set cursor height for whole system
-    double y2 = 0.0;
-
-    for (size_t i = 0; i < score->nstaves(); ++i) {
-        mu::engraving::SysStaff* ss = system->staff(i);
-        if (!ss->show() || !score->staff(i)->show()) {
-            continue;
-        }
-        y2 = ss->y() + ss->bbox().height();
-    }
+    double height = 6 * _spatium + position.systemHeight;
 
-    height += y2;
-    y -= 3 * _spatium;
+    double x = position.x;
+    double y = position.y - 3 * _spatium;
 
     if (m_type == LoopBoundaryType::LoopIn) {
         x = x - _spatium + width / 1.5;
@@ -21,7 +21,7 @@
  */
 #include "playbackcursor.h"
 
-#include "engraving/libmscore/system.h"
+#include "engraving/libmscore/score.h"
 
 using namespace mu::notation;
 
@@ -44,8 +44,7 @@ void PlaybackCursor::move(midi::tick_t tick)
     m_rect = resolveCursorRectByTick(tick);
 }
 
-//! NOTE Copied from ScoreView::moveCursor(const Fraction& tick)
-mu::RectF PlaybackCursor::resolveCursorRectByTick(midi::tick_t _tick) const
+mu::RectF PlaybackCursor::resolveCursorRectByTick(midi::tick_t tick) const
 {
     if (!m_notation) {
         return RectF();
@@ -53,81 +52,7 @@ mu::RectF PlaybackCursor::resolveCursorRectByTick(midi::tick_t _tick) const
 
     const mu::engraving::Score* score = m_notation->elements()->msScore();
 
-    Fraction tick = Fraction::fromTicks(_tick);
-
-    Measure* measure = score->tick2measureMM(tick);
-    if (!measure) {
-        return RectF();
-    }
-
-    mu::engraving::System* system = measure->system();
-    if (!system) {
-        return RectF();
-    }
-
-    qreal x = 0.0;
-    mu::engraving::Segment* s = nullptr;
-    for (s = measure->first(mu::engraving::SegmentType::ChordRest); s;) {
-        Fraction t1 = s->tick();
-        int x1 = s->canvasPos().x();
-        qreal x2 = 0.0;
-        Fraction t2;
-
-        mu::engraving::Segment* ns = s->next(mu::engraving::SegmentType::ChordRest);
-        while (ns && !ns->visible()) {
-            ns = ns->next(mu::engraving::SegmentType::ChordRest);
-        }
-
-        if (ns) {
-            t2 = ns->tick();
-            x2 = ns->canvasPos().x();
-        } else {
-            t2 = measure->endTick();
-            // measure->width is not good enough because of courtesy keysig, timesig
-            mu::engraving::Segment* seg = measure->findSegment(mu::engraving::SegmentType::EndBarLine, measure->tick() + measure->ticks());
-            if (seg) {
-                x2 = seg->canvasPos().x();
-            } else {
-                x2 = measure->canvasPos().x() + measure->width(); // safety, should not happen
-            }
-        }
-
-        if (tick >= t1 && tick < t2) {
-            Fraction dt = t2 - t1;
-            qreal dx = x2 - x1;
-            x = x1 + dx * (tick - t1).ticks() / dt.ticks();
-            break;
-        }
-        s = ns;
-    }
-
-    if (!s) {
-        return RectF();
-    }
-
-    double y = system->staffYpage(0) + system->page()->pos().y();
-    double _spatium = score->spatium();
-
-    double w  = 8;
-    double h  = 6 * _spatium;
-    //
-    // set cursor height for whole system
-    //
-    double y2 = 0.0;
-
-    for (size_t i = 0; i < score->nstaves(); ++i) {
-        mu::engraving::SysStaff* ss = system->staff(i);
-        if (!ss->show() || !score->staff(i)->show()) {
-            continue;
-        }
-        y2 = ss->bbox().bottom();
-    }
-
-    h += y2;
-    x -= _spatium;
-    y -= 3 * _spatium;
-
-    return RectF(x, y, w, h);
+    return score->playbackTimeline()->cursorRect(tick);
 }
 
 bool PlaybackCursor::visible() const
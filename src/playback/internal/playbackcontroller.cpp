@@ -240,6 +240,19 @@ void PlaybackController::playElements(const std::vector<const notation::Engravin
     notationPlayback()->triggerEventsForItems(elementsForPlaying);
 }
 
+void PlaybackController::playPitch(const engraving::InstrumentTrackId& trackId, int pitch)
+{
+    IF_ASSERT_FAILED(notationPlayback()) {
+        return;
+    }
+
+    if (!configuration()->playNotesWhenEditing()) {
+        return;
+    }
+
+    notationPlayback()->triggerEventForPitch(trackId, pitch);
+}
+
 void PlaybackController::playMetronome(int tick)
 {
     notationPlayback()->triggerMetronome(tick);
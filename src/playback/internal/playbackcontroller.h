@@ -79,6 +79,7 @@ public:
     async::Channel<audio::TrackId, engraving::InstrumentTrackId> trackRemoved() const override;
 
     void playElements(const std::vector<const notation::EngravingItem*>& elements) override;
+    void playPitch(const engraving::InstrumentTrackId& trackId, int pitch) override;
     void playMetronome(int tick) override;
     void seekElement(const notation::EngravingItem* element) override;
 
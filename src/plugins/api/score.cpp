@@ -24,10 +24,12 @@
 #include "cursor.h"
 #include "elements.h"
 
+#include "libmscore/chord.h"
 #include "libmscore/factory.h"
 #include "libmscore/instrtemplate.h"
 #include "libmscore/measure.h"
 #include "libmscore/masterscore.h"
+#include "libmscore/note.h"
 #include "libmscore/segment.h"
 #include "libmscore/text.h"
 
@@ -218,6 +220,72 @@ QQmlListProperty<Staff> Score::staves()
     return wrapContainerProperty<Staff>(this, score()->staves());
 }
 
+//---------------------------------------------------------
+//   Score::notesData
+//---------------------------------------------------------
+
+static QByteArray toArrayBuffer(const std::vector<int32_t>& values)
+{
+    return QByteArray(reinterpret_cast<const char*>(values.data()), static_cast<int>(values.size() * sizeof(int32_t)));
+}
+
+QVariantMap Score::notesData(int startTick, int endTick, int startStaff, int endStaff) const
+{
+    const int scoreEndTick = score()->endTick().ticks();
+    if (endTick < 0 || endTick > scoreEndTick) {
+        endTick = scoreEndTick;
+    }
+
+    const size_t nstaves = score()->nstaves();
+    const size_t firstStaff = static_cast<size_t>(std::max(startStaff, 0));
+    const size_t lastStaff = endStaff < 0 ? nstaves : std::min(static_cast<size_t>(endStaff), nstaves);
+
+    std::vector<int32_t> pitch;
+    std::vector<int32_t> tpc;
+    std::vector<int32_t> tick;
+    std::vector<int32_t> duration;
+    std::vector<int32_t> track;
+
+    mu::engraving::Measure* startMeasure = score()->tick2measure(mu::engraving::Fraction::fromTicks(startTick));
+    mu::engraving::Segment* seg = startMeasure ? startMeasure->first(mu::engraving::SegmentType::ChordRest) : nullptr;
+
+    for (; seg; seg = seg->next1(mu::engraving::SegmentType::ChordRest)) {
+        const int segTick = seg->tick().ticks();
+        if (segTick < startTick) {
+            continue;
+        }
+        if (segTick >= endTick) {
+            break;
+        }
+
+        for (track_idx_t t = firstStaff * VOICES; t < lastStaff * VOICES; ++t) {
+            const mu::engraving::EngravingItem* item = seg->element(t);
+            if (!item || !item->isChord()) {
+                continue;
+            }
+
+            const mu::engraving::Chord* chord = toChord(item);
+            const int chordTicks = chord->actualTicks().ticks();
+            for (const mu::engraving::Note* note : chord->notes()) {
+                pitch.push_back(note->pitch());
+                tpc.push_back(note->tpc());
+                tick.push_back(segTick);
+                duration.push_back(chordTicks);
+                track.push_back(static_cast<int32_t>(t));
+            }
+        }
+    }
+
+    QVariantMap data;
+    data["count"] = static_cast<int>(pitch.size());
+    data["pitch"] = toArrayBuffer(pitch);
+    data["tpc"] = toArrayBuffer(tpc);
+    data["tick"] = toArrayBuffer(tick);
+    data["duration"] = toArrayBuffer(duration);
+    data["track"] = toArrayBuffer(track);
+    return data;
+}
+
 //---------------------------------------------------------
 //   Score::startCmd
 //---------------------------------------------------------
@@ -21,6 +21,11 @@
  */
 
 #include "scoreelement.h"
+
+#include <QHash>
+
+#include <private/qqmldata_p.h>
+
 #include "elements.h"
 #include "score.h"
 #include "fraction.h"
@@ -38,11 +43,29 @@ namespace PluginAPI {
 
 ScoreElement::~ScoreElement()
 {
+    uncacheWrapper(this);
+
     if (_ownership == Ownership::PLUGIN) {
         delete e;
     }
 }
 
+//---------------------------------------------------------
+//   ScoreElement::setOwnership
+//---------------------------------------------------------
+
+void ScoreElement::setOwnership(Ownership o)
+{
+    _ownership = o;
+
+    //! NOTE An element added to a score is accessed through this wrapper from now on
+    if (_ownership == Ownership::SCORE) {
+        cacheWrapper(this);
+    } else {
+        uncacheWrapper(this);
+    }
+}
+
 QString ScoreElement::name() const
 {
     return QString(e->typeName());
@@ -142,6 +165,59 @@ void ScoreElement::set(mu::engraving::Pid pid, QVariant val)
     }
 }
 
+//---------------------------------------------------------
+//   Wrappers cache
+//    the type is kept to not return a wrapper of a deleted
+//    element for a new element allocated at the same address
+//---------------------------------------------------------
+
+struct CachedWrapper {
+    ScoreElement* wrapper = nullptr;
+    mu::engraving::ElementType type = mu::engraving::ElementType::INVALID;
+};
+
+static QHash<const mu::engraving::EngravingObject*, CachedWrapper> s_wrappers;
+
+//! NOTE The garbage collector of the engine only schedules the deletion of the wrappers it collects,
+//! the engine doesn't give such wrappers to JavaScript anymore
+static bool isCollected(const ScoreElement* w)
+{
+    const QQmlData* ddata = QQmlData::get(w);
+    return ddata && ddata->isQueuedForDeletion;
+}
+
+ScoreElement* cachedWrapper(mu::engraving::EngravingObject* e)
+{
+    auto it = s_wrappers.find(e);
+    if (it == s_wrappers.end()) {
+        return nullptr;
+    }
+
+    if (it->type != e->type() || isCollected(it->wrapper)) {
+        s_wrappers.erase(it);
+        return nullptr;
+    }
+
+    return it->wrapper;
+}
+
+void cacheWrapper(ScoreElement* w)
+{
+    if (!w->element()) {
+        return;
+    }
+
+    s_wrappers.insert(w->element(), CachedWrapper { w, w->element()->type() });
+}
+
+void uncacheWrapper(ScoreElement* w)
+{
+    auto it = s_wrappers.find(w->element());
+    if (it != s_wrappers.end() && it->wrapper == w) {
+        s_wrappers.erase(it);
+    }
+}
+
 //---------------------------------------------------------
 //   wrap
 ///   \cond PLUGIN_API \private \endcond
@@ -84,7 +84,7 @@ public:
     virtual ~ScoreElement();
 
     Ownership ownership() const { return _ownership; }
-    void setOwnership(Ownership o) { _ownership = o; }
+    void setOwnership(Ownership o);
 
     mu::engraving::EngravingObject* element() { return e; }
     const mu::engraving::EngravingObject* element() const { return e; }
@@ -101,6 +101,20 @@ public:
     Q_INVOKABLE bool is(mu::engraving::PluginAPI::ScoreElement* other) { return other && element() == other->element(); }
 };
 
+//---------------------------------------------------------
+//   cachedWrapper
+///   \cond PLUGIN_API \private \endcond
+///   \internal
+///   Wrappers of the elements owned by a score are kept
+///   (without owning them) while they are alive, so
+///   accessing the same element again returns the same
+///   object instead of allocating a new one.
+//---------------------------------------------------------
+
+extern ScoreElement* cachedWrapper(mu::engraving::EngravingObject* e);
+extern void cacheWrapper(ScoreElement* w);
+extern void uncacheWrapper(ScoreElement* w);
+
 //---------------------------------------------------------
 //   wrap
 ///   \cond PLUGIN_API \private \endcond
@@ -111,9 +125,23 @@ public:
 template<class Wrapper, class T>
 Wrapper* wrap(T* t, Ownership own = Ownership::SCORE)
 {
-    Wrapper* w = t ? new Wrapper(t, own) : nullptr;
+    if (!t) {
+        return nullptr;
+    }
+
+    if (own == Ownership::SCORE) {
+        if (Wrapper* cached = qobject_cast<Wrapper*>(cachedWrapper(t))) {
+            return cached;
+        }
+    }
+
+    Wrapper* w = new Wrapper(t, own);
     // All wrapper objects should belong to JavaScript code.
     QQmlEngine::setObjectOwnership(w, QQmlEngine::JavaScriptOwnership);
+
+    if (own == Ownership::SCORE) {
+        cacheWrapper(w);
+    }
     return w;
 }
 
@@ -0,0 +1,95 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+//! NOTE Not installed with the application, copy it to the plugins folder
+//! and run it on a large score. It reads all the notes of the score twice,
+//! walking the score with a cursor and with Score.notesData(), checks that
+//! both ways read the same notes and logs the times.
+
+import QtQuick 2.2
+import MuseScore 3.0
+
+MuseScore {
+      version: "4.0"
+      description: "Benchmark: reads all the notes of the score with a cursor and with Score.notesData()"
+      title: "Walk Score Benchmark"
+      requiresScore: true
+
+      function walkWithCursor() {
+            var result = { count: 0, checksum: 0 }
+            var cursor = curScore.newCursor()
+            for (var staff = 0; staff < curScore.nstaves; ++staff) {
+                  for (var voice = 0; voice < 4; ++voice) {
+                        cursor.staffIdx = staff
+                        cursor.voice = voice
+                        cursor.rewind(Cursor.SCORE_START)
+                        while (cursor.segment) {
+                              var el = cursor.element
+                              if (el && el.type === Element.CHORD) {
+                                    var notes = el.notes
+                                    for (var i = 0; i < notes.length; ++i) {
+                                          result.count += 1
+                                          result.checksum += notes[i].pitch + cursor.tick + el.actualDuration.ticks
+                                    }
+                              }
+                              cursor.next()
+                        }
+                  }
+            }
+            return result
+      }
+
+      function walkWithNotesData() {
+            var data = curScore.notesData()
+            var pitch = new Int32Array(data.pitch)
+            var tick = new Int32Array(data.tick)
+            var duration = new Int32Array(data.duration)
+
+            var result = { count: data.count, checksum: 0 }
+            for (var i = 0; i < data.count; ++i) {
+                  result.checksum += pitch[i] + tick[i] + duration[i]
+            }
+            return result
+      }
+
+      function measure(name, walk) {
+            var start = Date.now()
+            var result = walk()
+            var ms = Date.now() - start
+            console.log(name + ": " + result.count + " notes, " + ms + " ms")
+            return result
+      }
+
+      onRun: {
+            var cursorResult = measure("cursor", walkWithCursor)
+            //! NOTE The second walk with the cursor reuses the wrappers still alive from the first one
+            measure("cursor again", walkWithCursor)
+            var dataResult = measure("notesData", walkWithNotesData)
+
+            if (cursorResult.count !== dataResult.count || cursorResult.checksum !== dataResult.checksum) {
+                  console.log("different notes read: cursor " + cursorResult.count + "/" + cursorResult.checksum
+                              + ", notesData " + dataResult.count + "/" + dataResult.checksum)
+            }
+
+            quit()
+      }
+}
@@ -0,0 +1,131 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+#include <QJSEngine>
+
+#include "plugins/api/elements.h"
+
+#include "engraving/compat/dummyelement.h"
+#include "engraving/compat/scoreaccess.h"
+#include "engraving/libmscore/masterscore.h"
+
+using namespace mu::engraving;
+
+namespace api = mu::engraving::PluginAPI;
+
+class Plugins_ScoreElementTests : public ::testing::Test
+{
+};
+
+TEST_F(Plugins_ScoreElementTests, wrapperCacheHit)
+{
+    MasterScore* score = compat::ScoreAccess::createMasterScore();
+    Note* note = score->dummy()->note();
+
+    //! DO Wrap the same element owned by the score twice
+    api::Note* wrapper = api::wrap<api::Note>(note);
+    api::Note* again = api::wrap<api::Note>(note);
+
+    //! CHECK The wrapper is reused, also when the wrapper type is chosen at runtime
+    EXPECT_EQ(again, wrapper);
+    EXPECT_EQ(api::wrap(static_cast<EngravingItem*>(note)), wrapper);
+
+    //! CHECK Other elements get their own wrappers
+    api::Chord* chordWrapper = api::wrap<api::Chord>(score->dummy()->chord());
+    EXPECT_NE(static_cast<api::EngravingItem*>(chordWrapper), static_cast<api::EngravingItem*>(wrapper));
+
+    delete chordWrapper;
+    delete wrapper;
+    delete score;
+}
+
+TEST_F(Plugins_ScoreElementTests, wrapperTypeMismatch)
+{
+    MasterScore* score = compat::ScoreAccess::createMasterScore();
+    Note* note = score->dummy()->note();
+
+    //! GIVEN The element is cached with a wrapper of a base class
+    api::EngravingItem* itemWrapper = api::wrap<api::EngravingItem>(note);
+
+    //! DO Wrap it as a note
+    api::Note* noteWrapper = api::wrap<api::Note>(note);
+
+    //! CHECK The base class wrapper is not returned as a note wrapper, the new one replaces it
+    EXPECT_NE(static_cast<api::EngravingItem*>(noteWrapper), itemWrapper);
+    EXPECT_EQ(api::wrap<api::EngravingItem>(note), static_cast<api::EngravingItem*>(noteWrapper));
+
+    //! CHECK Deleting the replaced wrapper keeps the new one cached
+    delete itemWrapper;
+    EXPECT_EQ(api::wrap<api::Note>(note), noteWrapper);
+
+    delete noteWrapper;
+    delete score;
+}
+
+TEST_F(Plugins_ScoreElementTests, wrapperDeleted)
+{
+    MasterScore* score = compat::ScoreAccess::createMasterScore();
+    Note* note = score->dummy()->note();
+
+    //! DO Delete the wrapper
+    api::Note* wrapper = api::wrap<api::Note>(note);
+    EXPECT_EQ(api::cachedWrapper(note), wrapper);
+    delete wrapper;
+
+    //! CHECK The element is not cached anymore
+    EXPECT_EQ(api::cachedWrapper(note), nullptr);
+
+    delete score;
+}
+
+TEST_F(Plugins_ScoreElementTests, wrapperCollected)
+{
+    MasterScore* score = compat::ScoreAccess::createMasterScore();
+    Note* note = score->dummy()->note();
+
+    QJSEngine engine;
+    api::Note* wrapper = api::wrap<api::Note>(note);
+
+    //! GIVEN The wrapper was given to JavaScript and isn't referenced anymore
+    {
+        QJSValue value = engine.newQObject(wrapper);
+        EXPECT_FALSE(value.isNull());
+    }
+
+    //! DO Collect it, the engine only schedules its deletion
+    engine.collectGarbage();
+
+    //! CHECK The collected wrapper is not returned
+    EXPECT_EQ(api::cachedWrapper(note), nullptr);
+    api::Note* newWrapper = api::wrap<api::Note>(note);
+    EXPECT_NE(newWrapper, wrapper);
+
+    //! CHECK Deleting the collected wrapper keeps the new one cached
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    EXPECT_EQ(api::wrap<api::Note>(note), newWrapper);
+
+    delete newWrapper;
+    delete score;
+}
@@ -23,6 +23,8 @@
 #ifndef MU_PROJECT_INOTATIONWRITER_H
 #define MU_PROJECT_INOTATIONWRITER_H
 
+#include <functional>
+
 #include "types/ret.h"
 #include "types/val.h"
 
@@ -52,12 +54,20 @@ public:
 
     using Options = QMap<OptionKey, Val>;
 
+    //! NOTE Receives the data of every page in page order, on the thread that called writePages
+    using PageDataHandler = std::function<Ret (size_t pageIndex, const QByteArray& pageData)>;
+
     virtual std::vector<UnitType> supportedUnitTypes() const = 0;
     virtual bool supportsUnitType(UnitType unitType) const = 0;
 
     virtual Ret write(notation::INotationPtr notation, QIODevice& device, const Options& options = Options()) = 0;
     virtual Ret writeList(const notation::INotationPtrList& notations, QIODevice& device, const Options& options = Options()) = 0;
 
+    virtual Ret writePages(notation::INotationPtr /*notation*/, const PageDataHandler& /*handler*/, const Options& /*options*/ = Options())
+    {
+        return Ret(Ret::Code::NotSupported);
+    }
+
     virtual bool supportsProgressNotifications() const { return false; }
     virtual framework::Progress progress() const { return framework::Progress(); }
 